@@ -0,0 +1,181 @@
+#pragma once
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace NX::H5Support::Bench
+{
+/**
+ * @brief Settings shared by every benchmark suite.
+ */
+struct Config
+{
+  std::filesystem::path workDir;
+  uint64_t maxBytes = 64ull * 1024ull * 1024ull; // Largest dataset or file generated
+  size_t maxObjects = 100000;                    // Largest object count generated
+  size_t repetitions = 3;
+  std::string filter; // Only cases whose name contains the filter are run
+};
+
+/**
+ * @brief Timing of a single benchmark case.
+ */
+struct Measurement
+{
+  std::vector<double> seconds;
+  uint64_t bytes = 0;       // Bytes moved per repetition
+  uint64_t operations = 0;  // Operations per repetition
+  nlohmann::json extra = nlohmann::json::object();
+};
+
+/**
+ * @brief Collects benchmark results and prints a line per case.
+ */
+class Reporter
+{
+public:
+  explicit Reporter(const Config& config)
+  : m_Config(config)
+  {
+  }
+
+  bool shouldRun(const std::string& name) const
+  {
+    return m_Config.filter.empty() || name.find(m_Config.filter) != std::string::npos;
+  }
+
+  void add(const std::string& suite, const std::string& name, const nlohmann::json& parameters, const Measurement& measurement);
+
+  const nlohmann::json& getResults() const
+  {
+    return m_Results;
+  }
+
+private:
+  const Config& m_Config;
+  nlohmann::json m_Results = nlohmann::json::array();
+};
+
+using SuiteFunction = void (*)(const Config&, Reporter&);
+
+/**
+ * @brief Registers a benchmark suite. Returns a value so suites can register
+ * themselves from a namespace scope initializer.
+ */
+bool RegisterSuite(const std::string& name, SuiteFunction function);
+
+/**
+ * @brief Returns the seconds taken by each of the given number of calls to
+ * func. setup runs untimed before each call.
+ */
+inline std::vector<double> Measure(size_t repetitions, const std::function<void()>& setup, const std::function<void()>& func)
+{
+  std::vector<double> seconds;
+  for(size_t i = 0; i < repetitions; i++)
+  {
+    if(setup)
+    {
+      setup();
+    }
+    const auto start = std::chrono::steady_clock::now();
+    func();
+    const auto end = std::chrono::steady_clock::now();
+    seconds.push_back(std::chrono::duration<double>(end - start).count());
+  }
+  return seconds;
+}
+
+/**
+ * @brief Shapes of synthetic data. Random data is incompressible, smooth data
+ * resembles measured fields and label data resembles segmentations with long
+ * runs of a few values.
+ */
+enum class Pattern
+{
+  Random,
+  Smooth,
+  Labels
+};
+
+inline std::string PatternName(Pattern pattern)
+{
+  switch(pattern)
+  {
+  case Pattern::Random:
+    return "random";
+  case Pattern::Smooth:
+    return "smooth";
+  case Pattern::Labels:
+    return "labels";
+  }
+  return "";
+}
+
+/**
+ * @brief Generates count values laid out in rows of rowLength values. The
+ * same seed always produces the same data.
+ */
+template <typename T>
+std::vector<T> Generate(Pattern pattern, size_t count, size_t rowLength, uint64_t seed = 5489u)
+{
+  std::vector<T> values(count);
+  std::mt19937_64 generator(seed);
+  if(pattern == Pattern::Random)
+  {
+    if constexpr(std::is_floating_point_v<T>)
+    {
+      std::uniform_real_distribution<T> distribution(0, 1);
+      std::generate(values.begin(), values.end(), [&]() { return distribution(generator); });
+    }
+    else
+    {
+      std::generate(values.begin(), values.end(), [&]() { return static_cast<T>(generator()); });
+    }
+    return values;
+  }
+
+  const double maxValue = std::is_floating_point_v<T> ? 1.0 : static_cast<double>(std::numeric_limits<T>::max()) / 4.0;
+  for(size_t i = 0; i < count; i++)
+  {
+    const double x = static_cast<double>(i % rowLength);
+    const double y = static_cast<double>(i / rowLength);
+    if(pattern == Pattern::Smooth)
+    {
+      values[i] = static_cast<T>(maxValue * (2.0 + std::sin(x * 0.01) + std::cos(y * 0.013)) / 4.0);
+    }
+    else
+    {
+      // Blocks of 32x32 values share one of 16 labels
+      uint64_t hash = seed + (static_cast<uint64_t>(y) / 32) * 0x9E3779B97F4A7C15ull + static_cast<uint64_t>(x) / 32;
+      hash = (hash ^ (hash >> 30)) * 0xBF58476D1CE4E5B9ull;
+      hash = (hash ^ (hash >> 27)) * 0x94D049BB133111EBull;
+      values[i] = static_cast<T>((hash ^ (hash >> 31)) & 15u);
+    }
+  }
+  return values;
+}
+
+inline std::string FormatBytes(uint64_t bytes)
+{
+  const char* units[] = {"B", "KiB", "MiB", "GiB", "TiB"};
+  size_t unit = 0;
+  while(bytes >= 1024 && bytes % 1024 == 0 && unit < 4)
+  {
+    bytes /= 1024;
+    unit++;
+  }
+  return std::to_string(bytes) + units[unit];
+}
+} // namespace NX::H5Support::Bench
@@ -0,0 +1,280 @@
+#include "BenchUtilities.hpp"
+
+#include "NX/H5Support/IO/FileCatalog.hpp"
+#include "NX/H5Support/IO/FileIO.hpp"
+
+#include <fmt/format.h>
+
+#include <iostream>
+#include <optional>
+
+using namespace NX::H5Support;
+using namespace NX::H5Support::Bench;
+
+/**
+ * The metadata suite times operations whose cost is dominated by object
+ * lookups rather than raw data. Each generated file holds:
+ *  - "Flat": a single group of N children, alternating empty groups and small
+ *    datasets with one attribute each
+ *  - "Attributes": a group with min(N, 2000) attributes in dense storage.
+ *    getAttributeNames opens each attribute by index, which grows
+ *    quadratically, so larger counts would dominate the run time
+ *  - "Deep": min(N / 10, 1000) leaf groups eight levels below the root
+ * Each timed repetition reopens the file so the HDF5 metadata cache starts
+ * cold, while the operating system cache stays warm.
+ */
+namespace
+{
+inline const std::string k_SuiteName = "metadata";
+inline const std::string k_FlatName = "Flat";
+inline const std::string k_AttributesName = "Attributes";
+
+const std::vector<size_t> k_ObjectCounts{10000, 100000, 1000000};
+constexpr size_t k_MaxAttributes = 2000;
+constexpr size_t k_MaxDeepPaths = 1000;
+
+struct MetadataFile
+{
+  std::filesystem::path filePath;
+  size_t numObjects = 0;
+  size_t numAttributes = 0;
+  std::vector<std::string> deepPaths;
+};
+
+std::string deepPath(size_t index)
+{
+  return fmt::format("Deep/A{}/B{}/C{}/D{}/E/F/G/Leaf{}", index % 4, index % 16, index % 64, index % 256, index);
+}
+
+bool generateFile(MetadataFile& file)
+{
+  auto fileResult = FileIO::Open(file.filePath, FileIO::Mode::Truncate, FileOptions::ManySmallObjects());
+  if(!fileResult.valid())
+  {
+    return false;
+  }
+  FileIO& fileIO = fileResult.value();
+
+  auto flat = fileIO.createGroupForEntries(k_FlatName, file.numObjects);
+  const std::vector<int32_t> values{0, 1, 2, 3};
+  for(size_t i = 0; i < file.numObjects; i++)
+  {
+    const std::string name = fmt::format("Object{:07}", i);
+    if(i % 2 == 0)
+    {
+      if(!flat.createGroup(name).isValid())
+      {
+        return false;
+      }
+      continue;
+    }
+    auto dataset = flat.createDataset(name);
+    if(dataset.writeSpan<int32_t>({values.size()}, values) < 0 || dataset.createAttribute("Index").writeValue<int32_t>(static_cast<int32_t>(i)) < 0)
+    {
+      return false;
+    }
+  }
+
+  auto attributes = fileIO.createGroup(k_AttributesName);
+  for(size_t i = 0; i < file.numAttributes; i++)
+  {
+    if(attributes.createAttribute(fmt::format("Attribute{:07}", i)).writeValue<int32_t>(static_cast<int32_t>(i)) < 0)
+    {
+      return false;
+    }
+  }
+
+  for(const auto& path : file.deepPaths)
+  {
+    if(!fileIO.openOrCreatePath(path).isValid())
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief Times func with the file freshly opened before each repetition and
+ * reports the result. prepare runs untimed after each open. Both return false
+ * on failure.
+ */
+void measureOpen(const Config& config, Reporter& reporter, const MetadataFile& file, const std::string& name, uint64_t operations,
+                 const std::function<bool(FileIO&)>& func, const std::function<bool(FileIO&)>& prepare = nullptr)
+{
+  const std::string caseName = fmt::format("{}/{}", file.numObjects, name);
+  if(!reporter.shouldRun(caseName))
+  {
+    return;
+  }
+
+  std::optional<FileIO> fileIO;
+  bool success = true;
+  Measurement measurement;
+  measurement.operations = operations;
+  measurement.seconds = Measure(
+      config.repetitions,
+      [&]() {
+        fileIO.reset();
+        auto fileResult = FileIO::Open(file.filePath, FileIO::Mode::ReadOnly);
+        success = fileResult.valid() && success;
+        if(fileResult.valid())
+        {
+          fileIO.emplace(std::move(fileResult.value()));
+          success = (!prepare || prepare(*fileIO)) && success;
+        }
+      },
+      [&]() { success = fileIO.has_value() && func(*fileIO) && success; });
+  fileIO.reset();
+  if(!success)
+  {
+    std::cout << fmt::format("Error running {}", caseName) << std::endl;
+    return;
+  }
+  nlohmann::json parameters{{"numObjects", file.numObjects}, {"numAttributes", file.numAttributes}, {"numDeepPaths", file.deepPaths.size()}};
+  reporter.add(k_SuiteName, caseName, parameters, measurement);
+}
+
+void runFileOpens(const Config& config, Reporter& reporter, const MetadataFile& file)
+{
+  nlohmann::json parameters{{"numObjects", file.numObjects}};
+  for(const auto& [optionsName, options] : {std::make_pair("default", FileOptions{}), std::make_pair("manySmallObjects", FileOptions::ManySmallObjects())})
+  {
+    const std::string caseName = fmt::format("{}/open/{}", file.numObjects, optionsName);
+    if(!reporter.shouldRun(caseName))
+    {
+      continue;
+    }
+    bool success = true;
+    Measurement measurement;
+    measurement.operations = 1;
+    measurement.seconds = Measure(config.repetitions, nullptr, [&]() { success = FileIO::Open(file.filePath, FileIO::Mode::ReadOnly, options).valid() && success; });
+    if(success)
+    {
+      reporter.add(k_SuiteName, caseName, parameters, measurement);
+    }
+  }
+}
+
+void runTraversals(const Config& config, Reporter& reporter, const MetadataFile& file)
+{
+  const uint64_t numObjects = file.numObjects;
+  measureOpen(config, reporter, file, "getChildNames", numObjects, [numObjects](FileIO& fileIO) { return fileIO.openGroup(k_FlatName).getChildNames().size() == numObjects; });
+
+  measureOpen(config, reporter, file, "isGroupIsDataset", numObjects, [numObjects](FileIO& fileIO) {
+    auto flat = fileIO.openGroup(k_FlatName);
+    size_t numFound = 0;
+    for(size_t i = 0; i < numObjects; i++)
+    {
+      const std::string name = fmt::format("Object{:07}", i);
+      numFound += flat.isGroup(name) || flat.isDataset(name) ? 1 : 0;
+    }
+    return numFound == numObjects;
+  });
+
+  measureOpen(config, reporter, file, "listChildren", numObjects, [numObjects](FileIO& fileIO) { return fileIO.openGroup(k_FlatName).listChildren().size() == numObjects; });
+
+  measureOpen(config, reporter, file, "listChildrenDatasetInfo", numObjects, [numObjects](FileIO& fileIO) { return fileIO.openGroup(k_FlatName).listChildren(true).size() == numObjects; });
+
+  measureOpen(config, reporter, file, "forEachChild", numObjects, [numObjects](FileIO& fileIO) {
+    size_t numDatasets = 0;
+    const auto error = fileIO.openGroup(k_FlatName).forEachChild([&numDatasets](const GroupIO::ChildInfo& info) {
+      numDatasets += info.objectType == ObjectType::dataset ? 1 : 0;
+      return true;
+    });
+    return error >= 0 && numDatasets == numObjects / 2;
+  });
+
+  const uint64_t numAttributes = file.numAttributes;
+  measureOpen(config, reporter, file, "getAttributeNames", numAttributes,
+              [numAttributes](FileIO& fileIO) { return fileIO.openGroup(k_AttributesName).getAttributeNames().size() == numAttributes; });
+
+  measureOpen(config, reporter, file, "readAllAttributes", numAttributes,
+              [numAttributes](FileIO& fileIO) { return fileIO.openGroup(k_AttributesName).readAllAttributes().size() == numAttributes; });
+}
+
+void runDeepOpens(const Config& config, Reporter& reporter, const MetadataFile& file)
+{
+  const std::vector<std::string>& paths = file.deepPaths;
+  measureOpen(config, reporter, file, "deepOpen/chained", paths.size(), [&paths](FileIO& fileIO) {
+    for(const auto& path : paths)
+    {
+      // Every level stays open until the leaf is reached, as in a recursive walk
+      std::vector<std::shared_ptr<GroupIO>> groups;
+      size_t start = 0;
+      while(start < path.size())
+      {
+        const size_t end = std::min(path.find('/', start), path.size());
+        const std::string name = path.substr(start, end - start);
+        groups.push_back(groups.empty() ? fileIO.openGroupPtr(name) : groups.back()->openGroupPtr(name));
+        start = end + 1;
+      }
+      if(groups.empty() || groups.back() == nullptr || !groups.back()->isValid())
+      {
+        return false;
+      }
+    }
+    return true;
+  });
+
+  measureOpen(config, reporter, file, "deepOpen/path", paths.size(), [&paths](FileIO& fileIO) {
+    return std::all_of(paths.cbegin(), paths.cend(), [&fileIO](const std::string& path) { return fileIO.openGroup(path).isValid(); });
+  });
+
+  measureOpen(config, reporter, file, "catalogBuild", file.numObjects, [](FileIO& fileIO) { return FileCatalog::Build(fileIO, false).valid(); });
+
+  // Only the lookups are timed, the catalog is built untimed after each open
+  std::optional<FileCatalog> catalog;
+  measureOpen(
+      config, reporter, file, "deepOpen/catalog", paths.size(),
+      [&paths, &catalog](FileIO&) { return std::all_of(paths.cbegin(), paths.cend(), [&catalog](const std::string& path) { return catalog->openObject(path).isValid(); }); },
+      [&catalog](FileIO& fileIO) {
+        catalog.reset();
+        auto catalogResult = FileCatalog::Build(fileIO, false);
+        if(catalogResult.valid())
+        {
+          catalog.emplace(std::move(catalogResult.value()));
+        }
+        return catalog.has_value();
+      });
+}
+
+void runMetadata(const Config& config, Reporter& reporter)
+{
+  for(size_t numObjects : k_ObjectCounts)
+  {
+    if(numObjects > config.maxObjects)
+    {
+      break;
+    }
+
+    MetadataFile file;
+    file.filePath = config.workDir / fmt::format("metadata_{}.h5", numObjects);
+    file.numObjects = numObjects;
+    file.numAttributes = std::min(numObjects, k_MaxAttributes);
+    for(size_t i = 0; i < std::min(numObjects / 10, k_MaxDeepPaths); i++)
+    {
+      file.deepPaths.push_back(deepPath(i));
+    }
+
+    bool generated = false;
+    Measurement generation;
+    generation.operations = numObjects + file.numAttributes + file.deepPaths.size();
+    generation.seconds = Measure(1, nullptr, [&]() { generated = generateFile(file); });
+    if(!generated)
+    {
+      std::cout << fmt::format("Error generating the metadata file with {} objects", numObjects) << std::endl;
+      continue;
+    }
+    generation.extra["fileSize"] = std::filesystem::file_size(file.filePath);
+    reporter.add(k_SuiteName, fmt::format("{}/generate", numObjects), {{"numObjects", numObjects}}, generation);
+
+    runFileOpens(config, reporter, file);
+    runTraversals(config, reporter, file);
+    runDeepOpens(config, reporter, file);
+    std::filesystem::remove(file.filePath);
+  }
+}
+
+const bool k_Registered = RegisterSuite(k_SuiteName, runMetadata);
+} // namespace
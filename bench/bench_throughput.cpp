@@ -0,0 +1,343 @@
+#include "BenchUtilities.hpp"
+
+#include "NX/H5Support/IO/DatasetIO.hpp"
+#include "NX/H5Support/IO/FileIO.hpp"
+
+#include <fmt/format.h>
+
+#include <array>
+#include <iostream>
+
+using namespace NX::H5Support;
+using namespace NX::H5Support::Bench;
+
+/**
+ * The throughput suite times whole-dataset writes and reads of 2D datasets
+ * with rows of 1024 values. It runs three sweeps:
+ *  - types: every supported numeric type, contiguous and unfiltered
+ *  - layouts: float32 across layouts, chunk shapes, filters and data patterns
+ *  - cache: strip reads of tiled, compressed float32 data across chunk cache sizes
+ * Writes include closing the file. Reads are made right after writing, so
+ * they measure HDF5 and filter overhead on warm operating system caches
+ * rather than storage bandwidth.
+ */
+namespace
+{
+constexpr uint64_t k_KiB = 1024;
+constexpr uint64_t k_MiB = 1024 * k_KiB;
+constexpr uint64_t k_GiB = 1024 * k_MiB;
+constexpr size_t k_RowLength = 1024;
+constexpr hsize_t k_TileSize = 64;
+constexpr hsize_t k_StripRows = 16;
+inline const std::string k_SuiteName = "throughput";
+inline const std::string k_DatasetName = "Data";
+
+const std::vector<uint64_t> k_DatasetSizes{4 * k_KiB, 1 * k_MiB, 64 * k_MiB, 1 * k_GiB, 4 * k_GiB};
+const std::vector<size_t> k_ChunkCacheSizes{1 * k_MiB, 16 * k_MiB, 64 * k_MiB};
+
+enum class Layout
+{
+  Contiguous,
+  Rows64K, // Chunks of whole rows holding about 64 KiB
+  Rows1M,  // Chunks of whole rows holding about 1 MiB
+  Tiles    // Square chunks of k_TileSize values
+};
+
+struct Filter
+{
+  std::string name;
+  bool shuffle = false;
+  uint32_t deflateLevel = 0;
+};
+
+const std::vector<Filter> k_Filters{{"none", false, 0}, {"deflate", false, 4}, {"shuffle-deflate", true, 4}};
+
+/**
+ * @brief Returns the smallest prime that is not less than value.
+ */
+size_t nextPrime(size_t value)
+{
+  auto isPrime = [](size_t candidate) {
+    if(candidate < 2)
+    {
+      return false;
+    }
+    for(size_t divisor = 2; divisor * divisor <= candidate; divisor++)
+    {
+      if(candidate % divisor == 0)
+      {
+        return false;
+      }
+    }
+    return true;
+  };
+  while(!isPrime(value))
+  {
+    value++;
+  }
+  return value;
+}
+
+template <typename T>
+std::string typeName()
+{
+  if constexpr(std::is_floating_point_v<T>)
+  {
+    return fmt::format("float{}", sizeof(T) * 8);
+  }
+  else
+  {
+    return fmt::format("{}int{}", std::is_signed_v<T> ? "" : "u", sizeof(T) * 8);
+  }
+}
+
+std::string layoutName(Layout layout)
+{
+  switch(layout)
+  {
+  case Layout::Contiguous:
+    return "contiguous";
+  case Layout::Rows64K:
+    return "rows64K";
+  case Layout::Rows1M:
+    return "rows1M";
+  case Layout::Tiles:
+    return "tiles";
+  }
+  return "";
+}
+
+DatasetIO::DimsType datasetDims(uint64_t numBytes, size_t typeSize)
+{
+  const hsize_t count = std::max<hsize_t>(numBytes / typeSize, 1);
+  const hsize_t rowLength = std::min<hsize_t>(k_RowLength, count);
+  return {count / rowLength, rowLength};
+}
+
+DatasetIO::DimsType chunkDims(Layout layout, const DatasetIO::DimsType& dims, size_t typeSize)
+{
+  const uint64_t rowBytes = dims[1] * typeSize;
+  switch(layout)
+  {
+  case Layout::Contiguous:
+    return {};
+  case Layout::Rows64K:
+    return {std::clamp<hsize_t>(64 * k_KiB / rowBytes, 1, dims[0]), dims[1]};
+  case Layout::Rows1M:
+    return {std::clamp<hsize_t>(k_MiB / rowBytes, 1, dims[0]), dims[1]};
+  case Layout::Tiles:
+    return {std::min(k_TileSize, dims[0]), std::min(k_TileSize, dims[1])};
+  }
+  return {};
+}
+
+hid_t createProperties(const DatasetIO::DimsType& chunkShape, const Filter& filter)
+{
+  hid_t propertiesId = H5Pcreate(H5P_DATASET_CREATE);
+  if(!chunkShape.empty())
+  {
+    H5Pset_chunk(propertiesId, static_cast<int>(chunkShape.size()), chunkShape.data());
+    if(filter.shuffle)
+    {
+      H5Pset_shuffle(propertiesId);
+    }
+    if(filter.deflateLevel > 0)
+    {
+      H5Pset_deflate(propertiesId, filter.deflateLevel);
+    }
+  }
+  return propertiesId;
+}
+
+template <typename T>
+bool writeFile(const std::filesystem::path& filePath, const std::vector<T>& values, const DatasetIO::DimsType& dims, hid_t propertiesId)
+{
+  auto fileResult = FileIO::Open(filePath, FileIO::Mode::Truncate);
+  if(!fileResult.valid())
+  {
+    return false;
+  }
+  auto dataset = fileResult.value().createDataset(k_DatasetName);
+  dataset.createOrOpenDataset<T>(dims, propertiesId);
+  return dataset.writeSpan<T>(dims, values) >= 0;
+}
+
+template <typename T>
+bool readFile(const std::filesystem::path& filePath, std::vector<T>& values, const FileOptions& options = {})
+{
+  auto fileResult = FileIO::Open(filePath, FileIO::Mode::ReadOnly, options);
+  if(!fileResult.valid())
+  {
+    return false;
+  }
+  auto dataset = fileResult.value().openDataset(k_DatasetName);
+  nonstd::span<T> span(values);
+  return dataset.open() && dataset.readIntoSpan<T>(span);
+}
+
+/**
+ * @brief Reads the dataset in strips of k_StripRows full rows, the access
+ * pattern most sensitive to the chunk cache size when chunks are tiles.
+ */
+template <typename T>
+bool readStrips(const std::filesystem::path& filePath, std::vector<T>& values, const DatasetIO::DimsType& dims, const FileOptions& options)
+{
+  auto fileResult = FileIO::Open(filePath, FileIO::Mode::ReadOnly, options);
+  if(!fileResult.valid())
+  {
+    return false;
+  }
+  auto dataset = fileResult.value().openDataset(k_DatasetName);
+  if(!dataset.open())
+  {
+    return false;
+  }
+  hid_t fileSpaceId = H5Dget_space(dataset.getId());
+  bool success = true;
+  for(hsize_t row = 0; success && row < dims[0]; row += k_StripRows)
+  {
+    const std::array<hsize_t, 2> offset{row, 0};
+    const std::array<hsize_t, 2> count{std::min(k_StripRows, dims[0] - row), dims[1]};
+    hid_t memorySpaceId = H5Screate_simple(2, count.data(), nullptr);
+    success = H5Sselect_hyperslab(fileSpaceId, H5S_SELECT_SET, offset.data(), nullptr, count.data(), nullptr) >= 0 &&
+              H5Dread(dataset.getId(), Support::HdfTypeForPrimitive<T>(), memorySpaceId, fileSpaceId, H5P_DEFAULT, values.data() + row * dims[1]) >= 0;
+    H5Sclose(memorySpaceId);
+  }
+  H5Sclose(fileSpaceId);
+  return success;
+}
+
+/**
+ * @brief Times writing and reading one dataset configuration and reports
+ * both. The file size is reported with the write so compression ratios can
+ * be compared.
+ */
+template <typename T>
+void runCase(const Config& config, Reporter& reporter, const std::string& sweep, uint64_t numBytes, Layout layout, const Filter& filter, Pattern pattern)
+{
+  const std::string name = fmt::format("{}/{}/{}/{}/{}/{}", sweep, typeName<T>(), FormatBytes(numBytes), layoutName(layout), filter.name, PatternName(pattern));
+  if(!reporter.shouldRun(name + "/write") && !reporter.shouldRun(name + "/read"))
+  {
+    return;
+  }
+
+  const DatasetIO::DimsType dims = datasetDims(numBytes, sizeof(T));
+  const DatasetIO::DimsType chunkShape = chunkDims(layout, dims, sizeof(T));
+  std::vector<T> values = Generate<T>(pattern, dims[0] * dims[1], dims[1]);
+  const std::filesystem::path filePath = config.workDir / "throughput.h5";
+  nlohmann::json parameters{{"type", typeName<T>()}, {"dims", dims}, {"chunkDims", chunkShape}, {"layout", layoutName(layout)}, {"filter", filter.name}, {"pattern", PatternName(pattern)}};
+
+  hid_t propertiesId = createProperties(chunkShape, filter);
+  bool success = true;
+  Measurement writeMeasurement;
+  writeMeasurement.bytes = values.size() * sizeof(T);
+  writeMeasurement.seconds = Measure(config.repetitions, nullptr, [&]() { success = writeFile(filePath, values, dims, propertiesId) && success; });
+  H5Pclose(propertiesId);
+  if(!success)
+  {
+    std::cout << fmt::format("Error writing {}", name) << std::endl;
+    return;
+  }
+  writeMeasurement.extra["fileSize"] = std::filesystem::file_size(filePath);
+  reporter.add(k_SuiteName, name + "/write", parameters, writeMeasurement);
+
+  Measurement readMeasurement;
+  readMeasurement.bytes = writeMeasurement.bytes;
+  std::fill(values.begin(), values.end(), T{});
+  readMeasurement.seconds = Measure(config.repetitions, nullptr, [&]() { success = readFile(filePath, values) && success; });
+  if(!success)
+  {
+    std::cout << fmt::format("Error reading {}", name) << std::endl;
+    return;
+  }
+  reporter.add(k_SuiteName, name + "/read", parameters, readMeasurement);
+}
+
+template <typename... T>
+void runTypes(const Config& config, Reporter& reporter, uint64_t numBytes)
+{
+  (runCase<T>(config, reporter, "types", numBytes, Layout::Contiguous, k_Filters[0], Pattern::Random), ...);
+}
+
+void runCacheSweep(const Config& config, Reporter& reporter, uint64_t numBytes)
+{
+  const Filter& filter = k_Filters[2];
+  const DatasetIO::DimsType dims = datasetDims(numBytes, sizeof(float));
+  const DatasetIO::DimsType chunkShape = chunkDims(Layout::Tiles, dims, sizeof(float));
+  const std::filesystem::path filePath = config.workDir / "throughput_cache.h5";
+  std::vector<float> values = Generate<float>(Pattern::Smooth, dims[0] * dims[1], dims[1]);
+  hid_t propertiesId = createProperties(chunkShape, filter);
+  const bool written = writeFile(filePath, values, dims, propertiesId);
+  H5Pclose(propertiesId);
+  if(!written)
+  {
+    std::cout << "Error writing the chunk cache dataset" << std::endl;
+    return;
+  }
+
+  for(size_t cacheSize : k_ChunkCacheSizes)
+  {
+    const std::string name = fmt::format("cache/{}/{}", FormatBytes(numBytes), FormatBytes(cacheSize));
+    if(!reporter.shouldRun(name))
+    {
+      continue;
+    }
+    FileOptions options;
+    options.chunkCacheSize = cacheSize;
+    // A prime about 100 times the number of tiles that fit in the cache
+    options.chunkCacheSlots = nextPrime(cacheSize / (k_TileSize * k_TileSize * sizeof(float)) * 100);
+    bool success = true;
+    Measurement measurement;
+    measurement.bytes = values.size() * sizeof(float);
+    measurement.operations = (dims[0] + k_StripRows - 1) / k_StripRows;
+    measurement.seconds = Measure(config.repetitions, nullptr, [&]() { success = readStrips(filePath, values, dims, options) && success; });
+    if(!success)
+    {
+      std::cout << fmt::format("Error reading {}", name) << std::endl;
+      continue;
+    }
+    nlohmann::json parameters{{"type", "float32"}, {"dims", dims}, {"chunkDims", chunkShape}, {"filter", filter.name}, {"chunkCacheSize", cacheSize}, {"stripRows", k_StripRows}};
+    reporter.add(k_SuiteName, name, parameters, measurement);
+  }
+}
+
+void runThroughput(const Config& config, Reporter& reporter)
+{
+  uint64_t largestSize = 0;
+  for(uint64_t numBytes : k_DatasetSizes)
+  {
+    if(numBytes > config.maxBytes)
+    {
+      break;
+    }
+    largestSize = numBytes;
+    runTypes<int8_t, int16_t, int32_t, int64_t, uint8_t, uint16_t, uint32_t, uint64_t, float, double>(config, reporter, numBytes);
+  }
+
+  for(uint64_t numBytes : k_DatasetSizes)
+  {
+    if(numBytes > config.maxBytes)
+    {
+      break;
+    }
+    for(Pattern pattern : {Pattern::Random, Pattern::Smooth, Pattern::Labels})
+    {
+      runCase<float>(config, reporter, "layouts", numBytes, Layout::Contiguous, k_Filters[0], pattern);
+      for(Layout layout : {Layout::Rows64K, Layout::Rows1M, Layout::Tiles})
+      {
+        for(const auto& filter : k_Filters)
+        {
+          runCase<float>(config, reporter, "layouts", numBytes, layout, filter, pattern);
+        }
+      }
+    }
+  }
+
+  if(largestSize > 0)
+  {
+    runCacheSweep(config, reporter, largestSize);
+  }
+}
+
+const bool k_Registered = RegisterSuite(k_SuiteName, runThroughput);
+} // namespace
@@ -0,0 +1,236 @@
+#include "BenchUtilities.hpp"
+
+#include "NX/H5Support/H5.hpp"
+
+#include <fmt/format.h>
+
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <map>
+
+using namespace NX::H5Support::Bench;
+
+namespace
+{
+std::map<std::string, SuiteFunction>& suites()
+{
+  static std::map<std::string, SuiteFunction> registeredSuites;
+  return registeredSuites;
+}
+
+double median(std::vector<double> values)
+{
+  std::sort(values.begin(), values.end());
+  const size_t middle = values.size() / 2;
+  return values.size() % 2 == 1 ? values[middle] : (values[middle - 1] + values[middle]) / 2.0;
+}
+
+void printUsage()
+{
+  std::cout << "Usage: NXH5Support_bench [options]\n"
+               "  --output=PATH        Writes the results as JSON (default NXH5Support_bench.json)\n"
+               "  --work-dir=PATH      Parent of the scratch directory for generated files (default the system temp directory)\n"
+               "  --max-bytes=N        Largest dataset size in bytes (default 67108864)\n"
+               "  --max-objects=N      Largest number of objects in metadata files (default 100000)\n"
+               "  --repetitions=N      Timed repetitions per case (default 3)\n"
+               "  --suite=NAME         Only runs the named suite\n"
+               "  --filter=TEXT        Only runs cases whose name contains TEXT\n"
+               "  --list               Lists the suites\n";
+  for(const auto& [name, function] : suites())
+  {
+    std::cout << "Suite: " << name << "\n";
+  }
+}
+
+/**
+ * @brief Creates a uniquely named directory inside parentDir and returns its
+ * path. Returns an empty path on failure.
+ */
+std::filesystem::path createScratchDirectory(const std::filesystem::path& parentDir)
+{
+  std::random_device device;
+  for(size_t attempt = 0; attempt < 100; attempt++)
+  {
+    const std::filesystem::path directory = parentDir / fmt::format("NXH5Support_bench_{:08x}", device());
+    std::error_code errorCode;
+    // Returns false if the directory already exists
+    if(std::filesystem::create_directory(directory, errorCode))
+    {
+      return directory;
+    }
+    if(errorCode)
+    {
+      break;
+    }
+  }
+  return {};
+}
+
+bool parseNumber(const std::string& text, uint64_t& value)
+{
+  try
+  {
+    size_t numParsed = 0;
+    value = std::stoull(text, &numParsed);
+    return numParsed == text.size() && value > 0;
+  } catch(const std::exception&)
+  {
+    return false;
+  }
+}
+} // namespace
+
+namespace NX::H5Support::Bench
+{
+bool RegisterSuite(const std::string& name, SuiteFunction function)
+{
+  return suites().emplace(name, function).second;
+}
+
+void Reporter::add(const std::string& suite, const std::string& name, const nlohmann::json& parameters, const Measurement& measurement)
+{
+  if(measurement.seconds.empty())
+  {
+    return;
+  }
+
+  const double minSeconds = *std::min_element(measurement.seconds.cbegin(), measurement.seconds.cend());
+  const double medianSeconds = median(measurement.seconds);
+  nlohmann::json result;
+  result["suite"] = suite;
+  result["name"] = name;
+  result["parameters"] = parameters;
+  result["seconds"] = measurement.seconds;
+  result["minSeconds"] = minSeconds;
+  result["medianSeconds"] = medianSeconds;
+  result["bytes"] = measurement.bytes;
+  result["operations"] = measurement.operations;
+  std::string rate;
+  if(measurement.bytes > 0 && medianSeconds > 0.0)
+  {
+    const double megabytesPerSecond = static_cast<double>(measurement.bytes) / medianSeconds / (1024.0 * 1024.0);
+    result["megabytesPerSecond"] = megabytesPerSecond;
+    rate = fmt::format("{:10.1f} MiB/s", megabytesPerSecond);
+  }
+  if(measurement.operations > 0 && medianSeconds > 0.0)
+  {
+    const double microsecondsPerOperation = medianSeconds * 1.0e6 / static_cast<double>(measurement.operations);
+    result["microsecondsPerOperation"] = microsecondsPerOperation;
+    rate += fmt::format("{:10.2f} us/op", microsecondsPerOperation);
+  }
+  for(const auto& [key, value] : measurement.extra.items())
+  {
+    result[key] = value;
+  }
+  m_Results.push_back(std::move(result));
+
+  std::cout << fmt::format("{:<72} {:10.4f} s {}", suite + "/" + name, medianSeconds, rate) << std::endl;
+}
+} // namespace NX::H5Support::Bench
+
+int main(int argc, char* argv[])
+{
+  Config config;
+  config.workDir = std::filesystem::temp_directory_path();
+  std::filesystem::path outputPath = "NXH5Support_bench.json";
+  std::string suiteName;
+  for(int i = 1; i < argc; i++)
+  {
+    const std::string argument = argv[i];
+    const size_t separator = argument.find('=');
+    const std::string name = argument.substr(0, separator);
+    const std::string value = separator == std::string::npos ? "" : argument.substr(separator + 1);
+    uint64_t number = 0;
+    bool valid = true;
+    if(name == "--output")
+    {
+      outputPath = value;
+    }
+    else if(name == "--work-dir")
+    {
+      config.workDir = value;
+    }
+    else if(name == "--max-bytes")
+    {
+      valid = parseNumber(value, config.maxBytes);
+    }
+    else if(name == "--max-objects")
+    {
+      valid = parseNumber(value, number);
+      config.maxObjects = static_cast<size_t>(number);
+    }
+    else if(name == "--repetitions")
+    {
+      valid = parseNumber(value, number);
+      config.repetitions = static_cast<size_t>(number);
+    }
+    else if(name == "--suite")
+    {
+      suiteName = value;
+      valid = suites().count(value) > 0;
+    }
+    else if(name == "--filter")
+    {
+      config.filter = value;
+    }
+    else if(name == "--list" || name == "--help" || name == "-h")
+    {
+      printUsage();
+      return 0;
+    }
+    else
+    {
+      valid = false;
+    }
+
+    if(!valid)
+    {
+      std::cout << fmt::format("Invalid argument '{}'", argument) << std::endl;
+      printUsage();
+      return 1;
+    }
+  }
+
+  // Generated files go into a new scratch directory, so that removing it
+  // afterwards cannot delete anything the user keeps in the work directory
+  std::error_code errorCode;
+  std::filesystem::create_directories(config.workDir, errorCode);
+  const std::filesystem::path scratchDir = createScratchDirectory(config.workDir);
+  if(scratchDir.empty())
+  {
+    std::cout << fmt::format("Unable to create a scratch directory in '{}'", config.workDir.string()) << std::endl;
+    return 1;
+  }
+  config.workDir = scratchDir;
+
+  Reporter reporter(config);
+  for(const auto& [name, function] : suites())
+  {
+    if(suiteName.empty() || suiteName == name)
+    {
+      function(config, reporter);
+    }
+  }
+  std::filesystem::remove_all(config.workDir, errorCode);
+
+  unsigned majorVersion = 0;
+  unsigned minorVersion = 0;
+  unsigned releaseVersion = 0;
+  H5get_libversion(&majorVersion, &minorVersion, &releaseVersion);
+
+  nlohmann::json output;
+  output["hdf5Version"] = fmt::format("{}.{}.{}", majorVersion, minorVersion, releaseVersion);
+  output["timestamp"] = static_cast<int64_t>(std::time(nullptr));
+  output["config"] = {{"maxBytes", config.maxBytes}, {"maxObjects", config.maxObjects}, {"repetitions", config.repetitions}, {"filter", config.filter}};
+  output["results"] = reporter.getResults();
+
+  std::ofstream outputStream(outputPath);
+  if(!outputStream)
+  {
+    std::cout << fmt::format("Unable to write results to '{}'", outputPath.string()) << std::endl;
+    return 1;
+  }
+  outputStream << output.dump(2) << std::endl;
+  return 0;
+}
@@ -0,0 +1,809 @@
+#include "IoUringDriver.hpp"
+
+#include "NX/H5Support/H5Support.hpp"
+
+#include <H5FDsec2.h>
+#if H5_VERSION_GE(1, 14, 0)
+#include <H5FDdevelop.h>
+#endif
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef NXH5SUPPORT_ENABLE_IO_URING
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#endif
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace NX::H5Support
+{
+#ifdef _WIN32
+IdType IoUringDriverId()
+{
+  return -1;
+}
+
+bool IoUringAvailable()
+{
+  return false;
+}
+
+ErrorType SetIoUringDriver(IdType accessPropertiesId, const IoUringDriverConfig& /*config*/)
+{
+  return H5Pset_fapl_sec2(accessPropertiesId);
+}
+#else
+namespace
+{
+constexpr const char* k_DriverName = "nx_io_uring";
+#if H5_VERSION_GE(1, 14, 0)
+constexpr H5FD_class_value_t k_DriverValue = 0x4E58;
+#endif
+
+// Largest address representable by off_t
+constexpr haddr_t k_MaxAddress = (static_cast<haddr_t>(1) << (8 * sizeof(off_t) - 1)) - 1;
+
+// Linux transfers at most this many bytes in a single read or write
+constexpr size_t k_MaxTransferSize = 0x7ffff000;
+
+/**
+ * @brief A single read or write of a contiguous range of the file.
+ */
+struct IoRequest
+{
+  uint64_t offset = 0;
+  uint8_t* buffer = nullptr;
+  size_t size = 0;
+};
+
+/**
+ * @brief Advances the request past bytes that have been transferred.
+ */
+void advance(IoRequest& request, size_t count)
+{
+  request.offset += count;
+  request.buffer += count;
+  request.size -= count;
+}
+
+/**
+ * @brief Performs the request with blocking pread/pwrite calls. Reads that
+ * reach the end of the file zero fill the rest of the buffer.
+ */
+bool transferSync(int fileDescriptor, IoRequest request, bool write)
+{
+  while(request.size > 0)
+  {
+    const size_t size = std::min(request.size, k_MaxTransferSize);
+    const ssize_t count = write ? pwrite(fileDescriptor, request.buffer, size, static_cast<off_t>(request.offset)) : pread(fileDescriptor, request.buffer, size, static_cast<off_t>(request.offset));
+    if(count < 0)
+    {
+      if(errno == EINTR)
+      {
+        continue;
+      }
+      return false;
+    }
+    if(count == 0)
+    {
+      if(write)
+      {
+        return false;
+      }
+      std::memset(request.buffer, 0, request.size);
+      return true;
+    }
+    advance(request, static_cast<size_t>(count));
+  }
+  return true;
+}
+
+#ifdef NXH5SUPPORT_ENABLE_IO_URING
+/**
+ * @brief Minimal io_uring instance used to keep many reads or writes in
+ * flight at once. The rings are mapped directly so the driver does not depend
+ * on liburing.
+ */
+class IoUringQueue
+{
+public:
+  /**
+   * @brief Creates a queue with room for queueDepth requests. Returns nullptr
+   * if the kernel does not support io_uring or denies access to it.
+   */
+  static std::unique_ptr<IoUringQueue> Create(uint32_t queueDepth)
+  {
+    io_uring_params params{};
+    const int ringFd = static_cast<int>(syscall(__NR_io_uring_setup, std::max(queueDepth, 1u), &params));
+    if(ringFd < 0)
+    {
+      return nullptr;
+    }
+
+    std::unique_ptr<IoUringQueue> queue(new IoUringQueue());
+    queue->m_RingFd = ringFd;
+
+    // IORING_OP_READ and IORING_OP_WRITE were added in the same kernel
+    // release as IORING_FEAT_RW_CUR_POS.
+    if((params.features & IORING_FEAT_RW_CUR_POS) == 0)
+    {
+      return nullptr;
+    }
+
+    queue->m_Entries = params.sq_entries;
+    queue->m_SqRingSize = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+    queue->m_CqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    const bool singleMap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if(singleMap)
+    {
+      queue->m_SqRingSize = std::max(queue->m_SqRingSize, queue->m_CqRingSize);
+      queue->m_CqRingSize = queue->m_SqRingSize;
+    }
+
+    queue->m_SqRing = mmap(nullptr, queue->m_SqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_SQ_RING);
+    if(queue->m_SqRing == MAP_FAILED)
+    {
+      return nullptr;
+    }
+    queue->m_CqRing = singleMap ? queue->m_SqRing : mmap(nullptr, queue->m_CqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_CQ_RING);
+    if(queue->m_CqRing == MAP_FAILED)
+    {
+      return nullptr;
+    }
+    queue->m_SqesSize = params.sq_entries * sizeof(io_uring_sqe);
+    queue->m_SqesMap = mmap(nullptr, queue->m_SqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_SQES);
+    if(queue->m_SqesMap == MAP_FAILED)
+    {
+      return nullptr;
+    }
+
+    auto* sqRing = static_cast<uint8_t*>(queue->m_SqRing);
+    queue->m_SqTail = reinterpret_cast<unsigned*>(sqRing + params.sq_off.tail);
+    queue->m_SqMask = reinterpret_cast<unsigned*>(sqRing + params.sq_off.ring_mask);
+    queue->m_SqArray = reinterpret_cast<unsigned*>(sqRing + params.sq_off.array);
+    queue->m_Sqes = static_cast<io_uring_sqe*>(queue->m_SqesMap);
+
+    auto* cqRing = static_cast<uint8_t*>(queue->m_CqRing);
+    queue->m_CqHead = reinterpret_cast<unsigned*>(cqRing + params.cq_off.head);
+    queue->m_CqTail = reinterpret_cast<unsigned*>(cqRing + params.cq_off.tail);
+    queue->m_CqMask = reinterpret_cast<unsigned*>(cqRing + params.cq_off.ring_mask);
+    queue->m_Cqes = reinterpret_cast<io_uring_cqe*>(cqRing + params.cq_off.cqes);
+    return queue;
+  }
+
+  ~IoUringQueue()
+  {
+    if(m_SqesMap != MAP_FAILED)
+    {
+      munmap(m_SqesMap, m_SqesSize);
+    }
+    if(m_CqRing != MAP_FAILED && m_CqRing != m_SqRing)
+    {
+      munmap(m_CqRing, m_CqRingSize);
+    }
+    if(m_SqRing != MAP_FAILED)
+    {
+      munmap(m_SqRing, m_SqRingSize);
+    }
+    if(m_RingFd >= 0)
+    {
+      ::close(m_RingFd);
+    }
+  }
+
+  IoUringQueue(const IoUringQueue&) = delete;
+  IoUringQueue& operator=(const IoUringQueue&) = delete;
+
+  /**
+   * @brief Performs all requests, keeping up to the queue depth in flight.
+   * Short transfers are resubmitted for the remaining bytes and reads that
+   * reach the end of the file zero fill the rest of their buffer.
+   */
+  bool transfer(int fileDescriptor, std::vector<IoRequest>& requests, bool write)
+  {
+    std::deque<size_t> pending;
+    for(size_t i = 0; i < requests.size(); i++)
+    {
+      pending.push_back(i);
+    }
+
+    uint32_t queued = 0;
+    uint32_t inFlight = 0;
+    bool success = true;
+    while(inFlight > 0 || queued > 0 || (success && !pending.empty()))
+    {
+      while(success && !pending.empty() && queued + inFlight < m_Entries)
+      {
+        prepare(fileDescriptor, requests[pending.front()], pending.front(), write);
+        pending.pop_front();
+        queued++;
+      }
+
+      const long submitted = syscall(__NR_io_uring_enter, m_RingFd, queued, 1, IORING_ENTER_GETEVENTS, nullptr, 0);
+      if(submitted < 0)
+      {
+        if(errno == EINTR || errno == EAGAIN)
+        {
+          continue;
+        }
+        return false;
+      }
+      queued -= static_cast<uint32_t>(submitted);
+      inFlight += static_cast<uint32_t>(submitted);
+
+      unsigned head = *m_CqHead;
+      const unsigned tail = __atomic_load_n(m_CqTail, __ATOMIC_ACQUIRE);
+      for(; head != tail; head++)
+      {
+        const io_uring_cqe& completion = m_Cqes[head & *m_CqMask];
+        IoRequest& request = requests[completion.user_data];
+        inFlight--;
+        if(completion.res < 0)
+        {
+          if(completion.res == -EINTR || completion.res == -EAGAIN)
+          {
+            pending.push_back(completion.user_data);
+          }
+          else
+          {
+            success = false;
+          }
+        }
+        else if(completion.res == 0)
+        {
+          if(write)
+          {
+            success = false;
+          }
+          else
+          {
+            std::memset(request.buffer, 0, request.size);
+          }
+        }
+        else
+        {
+          advance(request, static_cast<size_t>(completion.res));
+          if(request.size > 0)
+          {
+            pending.push_back(completion.user_data);
+          }
+        }
+      }
+      __atomic_store_n(m_CqHead, head, __ATOMIC_RELEASE);
+    }
+    return success;
+  }
+
+private:
+  IoUringQueue() = default;
+
+  void prepare(int fileDescriptor, const IoRequest& request, uint64_t userData, bool write)
+  {
+    const unsigned tail = *m_SqTail;
+    const unsigned index = tail & *m_SqMask;
+    io_uring_sqe& submission = m_Sqes[index];
+    std::memset(&submission, 0, sizeof(submission));
+    submission.opcode = write ? IORING_OP_WRITE : IORING_OP_READ;
+    submission.fd = fileDescriptor;
+    submission.off = request.offset;
+    submission.addr = reinterpret_cast<uint64_t>(request.buffer);
+    submission.len = static_cast<uint32_t>(std::min(request.size, k_MaxTransferSize));
+    submission.user_data = userData;
+    m_SqArray[index] = index;
+    __atomic_store_n(m_SqTail, tail + 1, __ATOMIC_RELEASE);
+  }
+
+  int m_RingFd = -1;
+  uint32_t m_Entries = 0;
+  void* m_SqRing = MAP_FAILED;
+  size_t m_SqRingSize = 0;
+  void* m_CqRing = MAP_FAILED;
+  size_t m_CqRingSize = 0;
+  void* m_SqesMap = MAP_FAILED;
+  size_t m_SqesSize = 0;
+  unsigned* m_SqTail = nullptr;
+  unsigned* m_SqMask = nullptr;
+  unsigned* m_SqArray = nullptr;
+  io_uring_sqe* m_Sqes = nullptr;
+  unsigned* m_CqHead = nullptr;
+  unsigned* m_CqTail = nullptr;
+  unsigned* m_CqMask = nullptr;
+  io_uring_cqe* m_Cqes = nullptr;
+};
+#else
+class IoUringQueue;
+#endif
+
+/**
+ * @brief Per-file state of the driver. HDF5 only sees the public H5FD_t
+ * member, which must come first.
+ */
+struct IoUringFile
+{
+  H5FD_t pub;
+  int fileDescriptor = -1;
+  haddr_t eoa = 0;
+  haddr_t eof = 0;
+  dev_t device = 0;
+  ino_t inode = 0;
+  IoUringDriverConfig config;
+  IoUringQueue* queue = nullptr;
+  uint8_t* readahead = nullptr;
+  haddr_t readaheadAddress = 0;
+  size_t readaheadBytes = 0;
+  haddr_t lastReadEnd = HADDR_UNDEF;
+};
+
+hid_t g_DriverId = H5I_INVALID_HID;
+std::mutex g_DriverMutex;
+
+void pushError(const char* function, int line, hid_t minor, const char* message)
+{
+  H5Epush2(H5E_DEFAULT, __FILE__, function, static_cast<unsigned>(line), H5E_ERR_CLS, H5E_VFL, minor, "%s", message);
+}
+
+/**
+ * @brief Splits a transfer into segments that are submitted together. The
+ * part of a read that lies past the end of the file is zero filled instead of
+ * being read.
+ */
+void appendRequests(const IoUringFile* file, haddr_t address, size_t size, uint8_t* buffer, bool write, std::vector<IoRequest>& requests)
+{
+  if(!write && address + size > file->eof)
+  {
+    const size_t available = address < file->eof ? static_cast<size_t>(file->eof - address) : 0;
+    std::memset(buffer + available, 0, size - available);
+    size = available;
+  }
+
+  const size_t segmentSize = file->config.segmentSize > 0 ? static_cast<size_t>(file->config.segmentSize) : size;
+  for(size_t offset = 0; offset < size; offset += segmentSize)
+  {
+    requests.push_back({address + offset, buffer + offset, std::min(segmentSize, size - offset)});
+  }
+}
+
+bool transfer(IoUringFile* file, std::vector<IoRequest>& requests, bool write)
+{
+#ifdef NXH5SUPPORT_ENABLE_IO_URING
+  if(file->queue != nullptr)
+  {
+    return file->queue->transfer(file->fileDescriptor, requests, write);
+  }
+#endif
+  return std::all_of(requests.cbegin(), requests.cend(), [file, write](const IoRequest& request) { return transferSync(file->fileDescriptor, request, write); });
+}
+
+bool readFromReadahead(const IoUringFile* file, haddr_t address, size_t size, uint8_t* destination)
+{
+  if(file->readaheadBytes == 0 || address < file->readaheadAddress || address + size > file->readaheadAddress + file->readaheadBytes)
+  {
+    return false;
+  }
+  std::memcpy(destination, file->readahead + (address - file->readaheadAddress), size);
+  return true;
+}
+
+/**
+ * @brief Fills the readahead buffer with the file contents starting at the
+ * target address.
+ */
+bool fillReadahead(IoUringFile* file, haddr_t address)
+{
+  const size_t readaheadSize = static_cast<size_t>(file->config.readaheadSize);
+  if(file->readahead == nullptr)
+  {
+    file->readahead = new(std::nothrow) uint8_t[readaheadSize];
+    if(file->readahead == nullptr)
+    {
+      return false;
+    }
+  }
+
+  const size_t count = static_cast<size_t>(std::min<haddr_t>(readaheadSize, file->eof - address));
+  std::vector<IoRequest> requests;
+  appendRequests(file, address, count, file->readahead, false, requests);
+  file->readaheadBytes = 0;
+  if(!transfer(file, requests, false))
+  {
+    return false;
+  }
+  file->readaheadAddress = address;
+  file->readaheadBytes = count;
+  return true;
+}
+
+void* ioUringFaplGet(H5FD_t* h5File)
+{
+  const auto* file = reinterpret_cast<const IoUringFile*>(h5File);
+  return new(std::nothrow) IoUringDriverConfig(file->config);
+}
+
+void* ioUringFaplCopy(const void* config)
+{
+  return new(std::nothrow) IoUringDriverConfig(*static_cast<const IoUringDriverConfig*>(config));
+}
+
+herr_t ioUringFaplFree(void* config)
+{
+  delete static_cast<IoUringDriverConfig*>(config);
+  return 0;
+}
+
+H5FD_t* ioUringOpen(const char* name, unsigned flags, hid_t accessPropertiesId, haddr_t maxAddress)
+{
+  if(name == nullptr || *name == '\0')
+  {
+    pushError(__func__, __LINE__, H5E_BADVALUE, "Invalid file name");
+    return nullptr;
+  }
+  if(maxAddress == 0 || maxAddress == HADDR_UNDEF || maxAddress > k_MaxAddress)
+  {
+    pushError(__func__, __LINE__, H5E_BADRANGE, "Invalid maximum address");
+    return nullptr;
+  }
+
+  int openFlags = (flags & H5F_ACC_RDWR) ? O_RDWR : O_RDONLY;
+  if(flags & H5F_ACC_TRUNC)
+  {
+    openFlags |= O_TRUNC;
+  }
+  if(flags & H5F_ACC_CREAT)
+  {
+    openFlags |= O_CREAT;
+  }
+  if(flags & H5F_ACC_EXCL)
+  {
+    openFlags |= O_EXCL;
+  }
+
+  const int fileDescriptor = ::open(name, openFlags | O_CLOEXEC, 0666);
+  if(fileDescriptor < 0)
+  {
+    pushError(__func__, __LINE__, H5E_CANTOPENFILE, std::strerror(errno));
+    return nullptr;
+  }
+  struct stat fileStat
+  {
+  };
+  if(fstat(fileDescriptor, &fileStat) < 0)
+  {
+    pushError(__func__, __LINE__, H5E_BADFILE, std::strerror(errno));
+    ::close(fileDescriptor);
+    return nullptr;
+  }
+
+  auto* file = new(std::nothrow) IoUringFile();
+  if(file == nullptr)
+  {
+    pushError(__func__, __LINE__, H5E_CANTALLOC, "Unable to allocate file struct");
+    ::close(fileDescriptor);
+    return nullptr;
+  }
+  file->fileDescriptor = fileDescriptor;
+  file->eof = static_cast<haddr_t>(fileStat.st_size);
+  file->device = fileStat.st_dev;
+  file->inode = fileStat.st_ino;
+
+  const auto* config = static_cast<const IoUringDriverConfig*>(H5Pget_driver_info(accessPropertiesId));
+  if(config != nullptr)
+  {
+    file->config = *config;
+  }
+#ifdef NXH5SUPPORT_ENABLE_IO_URING
+  if(file->config.useIoUring)
+  {
+    file->queue = IoUringQueue::Create(file->config.queueDepth).release();
+  }
+#endif
+  return &file->pub;
+}
+
+herr_t ioUringClose(H5FD_t* h5File)
+{
+  auto* file = reinterpret_cast<IoUringFile*>(h5File);
+#ifdef NXH5SUPPORT_ENABLE_IO_URING
+  delete file->queue;
+#endif
+  delete[] file->readahead;
+  const int result = ::close(file->fileDescriptor);
+  delete file;
+  if(result < 0)
+  {
+    pushError(__func__, __LINE__, H5E_CANTCLOSEFILE, std::strerror(errno));
+    return -1;
+  }
+  return 0;
+}
+
+int ioUringCompare(const H5FD_t* h5File1, const H5FD_t* h5File2)
+{
+  const auto* file1 = reinterpret_cast<const IoUringFile*>(h5File1);
+  const auto* file2 = reinterpret_cast<const IoUringFile*>(h5File2);
+  if(file1->device != file2->device)
+  {
+    return file1->device < file2->device ? -1 : 1;
+  }
+  if(file1->inode != file2->inode)
+  {
+    return file1->inode < file2->inode ? -1 : 1;
+  }
+  return 0;
+}
+
+herr_t ioUringQuery(const H5FD_t* /*h5File*/, unsigned long* flags)
+{
+  if(flags != nullptr)
+  {
+    *flags = H5FD_FEAT_AGGREGATE_METADATA | H5FD_FEAT_ACCUMULATE_METADATA | H5FD_FEAT_DATA_SIEVE | H5FD_FEAT_AGGREGATE_SMALLDATA;
+#ifdef H5FD_FEAT_POSIX_COMPAT_HANDLE
+    *flags |= H5FD_FEAT_POSIX_COMPAT_HANDLE;
+#endif
+#ifdef H5FD_FEAT_DEFAULT_VFD_COMPATIBLE
+    *flags |= H5FD_FEAT_DEFAULT_VFD_COMPATIBLE;
+#endif
+  }
+  return 0;
+}
+
+haddr_t ioUringGetEoa(const H5FD_t* h5File, H5FD_mem_t /*type*/)
+{
+  return reinterpret_cast<const IoUringFile*>(h5File)->eoa;
+}
+
+herr_t ioUringSetEoa(H5FD_t* h5File, H5FD_mem_t /*type*/, haddr_t address)
+{
+  reinterpret_cast<IoUringFile*>(h5File)->eoa = address;
+  return 0;
+}
+
+haddr_t ioUringGetEof(const H5FD_t* h5File, H5FD_mem_t /*type*/)
+{
+  return reinterpret_cast<const IoUringFile*>(h5File)->eof;
+}
+
+herr_t ioUringGetHandle(H5FD_t* h5File, hid_t /*accessPropertiesId*/, void** fileHandle)
+{
+  if(fileHandle == nullptr)
+  {
+    pushError(__func__, __LINE__, H5E_BADVALUE, "File handle not valid");
+    return -1;
+  }
+  *fileHandle = &reinterpret_cast<IoUringFile*>(h5File)->fileDescriptor;
+  return 0;
+}
+
+herr_t ioUringRead(H5FD_t* h5File, H5FD_mem_t /*type*/, hid_t /*transferPropertiesId*/, haddr_t address, size_t size, void* buffer)
+{
+  auto* file = reinterpret_cast<IoUringFile*>(h5File);
+  if(address == HADDR_UNDEF || address + size < address || address + size > k_MaxAddress)
+  {
+    pushError(__func__, __LINE__, H5E_OVERFLOW, "Address overflow");
+    return -1;
+  }
+
+  auto* destination = static_cast<uint8_t*>(buffer);
+  const bool sequential = address == file->lastReadEnd;
+  file->lastReadEnd = address + size;
+  if(readFromReadahead(file, address, size, destination))
+  {
+    return 0;
+  }
+  if(sequential && size < file->config.readaheadSize && address < file->eof)
+  {
+    if(fillReadahead(file, address) && readFromReadahead(file, address, size, destination))
+    {
+      return 0;
+    }
+  }
+
+  std::vector<IoRequest> requests;
+  appendRequests(file, address, size, destination, false, requests);
+  if(!transfer(file, requests, false))
+  {
+    pushError(__func__, __LINE__, H5E_READERROR, "File read failed");
+    return -1;
+  }
+  return 0;
+}
+
+herr_t ioUringWrite(H5FD_t* h5File, H5FD_mem_t /*type*/, hid_t /*transferPropertiesId*/, haddr_t address, size_t size, const void* buffer)
+{
+  auto* file = reinterpret_cast<IoUringFile*>(h5File);
+  if(address == HADDR_UNDEF || address + size < address || address + size > k_MaxAddress)
+  {
+    pushError(__func__, __LINE__, H5E_OVERFLOW, "Address overflow");
+    return -1;
+  }
+
+  file->readaheadBytes = 0;
+  file->lastReadEnd = HADDR_UNDEF;
+  std::vector<IoRequest> requests;
+  appendRequests(file, address, size, const_cast<uint8_t*>(static_cast<const uint8_t*>(buffer)), true, requests);
+  if(!transfer(file, requests, true))
+  {
+    pushError(__func__, __LINE__, H5E_WRITEERROR, "File write failed");
+    return -1;
+  }
+  file->eof = std::max(file->eof, address + size);
+  return 0;
+}
+
+#if H5_VERSION_GE(1, 14, 0)
+herr_t ioUringReadVector(H5FD_t* h5File, hid_t /*transferPropertiesId*/, uint32_t count, H5FD_mem_t /*types*/[], haddr_t addresses[], size_t sizes[], void* buffers[])
+{
+  auto* file = reinterpret_cast<IoUringFile*>(h5File);
+  std::vector<IoRequest> requests;
+  size_t size = 0;
+  bool fixedSize = false;
+  for(uint32_t i = 0; i < count; i++)
+  {
+    // A zero size repeats the previous size for the remaining entries
+    if(!fixedSize)
+    {
+      fixedSize = sizes[i] == 0;
+      size = fixedSize ? size : sizes[i];
+    }
+    if(addresses[i] == HADDR_UNDEF || addresses[i] + size < addresses[i] || addresses[i] + size > k_MaxAddress)
+    {
+      pushError(__func__, __LINE__, H5E_OVERFLOW, "Address overflow");
+      return -1;
+    }
+    appendRequests(file, addresses[i], size, static_cast<uint8_t*>(buffers[i]), false, requests);
+  }
+
+  file->lastReadEnd = HADDR_UNDEF;
+  if(!transfer(file, requests, false))
+  {
+    pushError(__func__, __LINE__, H5E_READERROR, "File read failed");
+    return -1;
+  }
+  return 0;
+}
+
+herr_t ioUringDelete(const char* name, hid_t /*accessPropertiesId*/)
+{
+  if(unlink(name) < 0)
+  {
+    pushError(__func__, __LINE__, H5E_CANTDELETEFILE, std::strerror(errno));
+    return -1;
+  }
+  return 0;
+}
+#endif
+
+herr_t ioUringTruncate(H5FD_t* h5File, hid_t /*transferPropertiesId*/, hbool_t /*closing*/)
+{
+  auto* file = reinterpret_cast<IoUringFile*>(h5File);
+  if(file->eoa == file->eof)
+  {
+    return 0;
+  }
+  if(ftruncate(file->fileDescriptor, static_cast<off_t>(file->eoa)) < 0)
+  {
+    pushError(__func__, __LINE__, H5E_SEEKERROR, std::strerror(errno));
+    return -1;
+  }
+  file->eof = file->eoa;
+  file->readaheadBytes = 0;
+  return 0;
+}
+
+herr_t ioUringLock(H5FD_t* h5File, hbool_t readWrite)
+{
+  const auto* file = reinterpret_cast<const IoUringFile*>(h5File);
+  if(flock(file->fileDescriptor, (readWrite ? LOCK_EX : LOCK_SH) | LOCK_NB) < 0)
+  {
+    // File systems without lock support are treated as unlocked
+    if(errno == ENOSYS)
+    {
+      return 0;
+    }
+    pushError(__func__, __LINE__, H5E_CANTLOCKFILE, std::strerror(errno));
+    return -1;
+  }
+  return 0;
+}
+
+herr_t ioUringUnlock(H5FD_t* h5File)
+{
+  const auto* file = reinterpret_cast<const IoUringFile*>(h5File);
+  if(flock(file->fileDescriptor, LOCK_UN) < 0 && errno != ENOSYS)
+  {
+    pushError(__func__, __LINE__, H5E_CANTUNLOCKFILE, std::strerror(errno));
+    return -1;
+  }
+  return 0;
+}
+
+herr_t ioUringTerminate()
+{
+  g_DriverId = H5I_INVALID_HID;
+  return 0;
+}
+
+H5FD_class_t createDriverClass()
+{
+  H5FD_class_t driverClass{};
+#if H5_VERSION_GE(1, 14, 0)
+  driverClass.version = H5FD_CLASS_VERSION;
+  driverClass.value = k_DriverValue;
+  driverClass.read_vector = ioUringReadVector;
+  driverClass.del = ioUringDelete;
+#endif
+  driverClass.name = k_DriverName;
+  driverClass.maxaddr = k_MaxAddress;
+  driverClass.fc_degree = H5F_CLOSE_WEAK;
+  driverClass.terminate = ioUringTerminate;
+  driverClass.fapl_size = sizeof(IoUringDriverConfig);
+  driverClass.fapl_get = ioUringFaplGet;
+  driverClass.fapl_copy = ioUringFaplCopy;
+  driverClass.fapl_free = ioUringFaplFree;
+  driverClass.open = ioUringOpen;
+  driverClass.close = ioUringClose;
+  driverClass.cmp = ioUringCompare;
+  driverClass.query = ioUringQuery;
+  driverClass.get_eoa = ioUringGetEoa;
+  driverClass.set_eoa = ioUringSetEoa;
+  driverClass.get_eof = ioUringGetEof;
+  driverClass.get_handle = ioUringGetHandle;
+  driverClass.read = ioUringRead;
+  driverClass.write = ioUringWrite;
+  driverClass.truncate = ioUringTruncate;
+  driverClass.lock = ioUringLock;
+  driverClass.unlock = ioUringUnlock;
+
+  const H5FD_mem_t freeListMap[H5FD_MEM_NTYPES] = H5FD_FLMAP_DICHOTOMY;
+  std::copy(std::begin(freeListMap), std::end(freeListMap), std::begin(driverClass.fl_map));
+  return driverClass;
+}
+} // namespace
+
+IdType IoUringDriverId()
+{
+  std::lock_guard<std::mutex> lock(g_DriverMutex);
+  if(g_DriverId >= 0 && H5Iis_valid(g_DriverId) > 0)
+  {
+    return g_DriverId;
+  }
+
+  static const H5FD_class_t driverClass = createDriverClass();
+  g_DriverId = H5FDregister(&driverClass);
+  return g_DriverId;
+}
+
+bool IoUringAvailable()
+{
+#ifdef NXH5SUPPORT_ENABLE_IO_URING
+  static const bool available = IoUringQueue::Create(1) != nullptr;
+  return available;
+#else
+  return false;
+#endif
+}
+
+ErrorType SetIoUringDriver(IdType accessPropertiesId, const IoUringDriverConfig& config)
+{
+  hid_t driverId = IoUringDriverId();
+  if(driverId < 0)
+  {
+    return -1;
+  }
+  return H5Pset_driver(accessPropertiesId, driverId, &config);
+}
+#endif
+} // namespace NX::H5Support
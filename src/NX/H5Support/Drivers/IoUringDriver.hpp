@@ -0,0 +1,64 @@
+#pragma once
+
+#include "NX/H5Support/H5.hpp"
+#include "NX/H5Support/NXH5SUPPORT_EXPORT.hpp"
+
+#include <cstdint>
+
+namespace NX::H5Support
+{
+/**
+ * @brief Settings for the io_uring virtual file driver.
+ */
+struct NXH5SUPPORT_EXPORT IoUringDriverConfig
+{
+  /**
+   * @brief Maximum number of requests kept in flight on the submission queue.
+   */
+  uint32_t queueDepth = 64;
+
+  /**
+   * @brief Large transfers are split into segments of this many bytes that
+   * are submitted together so the device sees a deep queue.
+   */
+  SizeType segmentSize = 1024 * 1024;
+
+  /**
+   * @brief Number of bytes read ahead of a sequential read smaller than the
+   * readahead size. Zero disables readahead.
+   */
+  SizeType readaheadSize = 1024 * 1024;
+
+  /**
+   * @brief Submits I/O through io_uring when the kernel supports it. When
+   * false, or when io_uring is unavailable, the driver performs synchronous
+   * pread/pwrite calls.
+   */
+  bool useIoUring = true;
+};
+
+/**
+ * @brief Returns the HDF5 ID of the io_uring virtual file driver, registering
+ * the driver with HDF5 if required. Returns a negative value if the driver is
+ * not supported on this platform.
+ * @return IdType
+ */
+IdType NXH5SUPPORT_EXPORT IoUringDriverId();
+
+/**
+ * @brief Returns true if the library was built with io_uring support and the
+ * running kernel allows io_uring instances to be created.
+ * @return bool
+ */
+bool NXH5SUPPORT_EXPORT IoUringAvailable();
+
+/**
+ * @brief Sets the io_uring virtual file driver on the file access property
+ * list. Platforms without the driver fall back to the sec2 driver.
+ * Returns a negative value if the driver could not be set.
+ * @param accessPropertiesId
+ * @param config
+ * @return ErrorType
+ */
+ErrorType NXH5SUPPORT_EXPORT SetIoUringDriver(IdType accessPropertiesId, const IoUringDriverConfig& config = {});
+} // namespace NX::H5Support
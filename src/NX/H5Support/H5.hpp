@@ -29,6 +29,14 @@ enum class Type
   unknown = 255
 };
 
+enum class ObjectType
+{
+  group,
+  dataset,
+  namedDatatype,
+  unknown = 255
+};
+
 /**
  * @brief converts an H5Support enum Type to NX::Common enum type.
  * @param typeEnum
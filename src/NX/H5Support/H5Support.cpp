@@ -1,7 +1,81 @@
 #include "H5Support.hpp"
 
+#include <algorithm>
 #include <cstring>
 #include <iostream>
+#include <mutex>
+
+namespace
+{
+std::recursive_mutex& hdf5Mutex()
+{
+  static std::recursive_mutex mutex;
+  return mutex;
+}
+
+// Number of times the calling thread has acquired the HDF5 lock
+thread_local int32_t t_LockDepth = 0;
+
+// Number of HDF5 callbacks the calling thread is currently inside of
+thread_local int32_t t_CallbackDepth = 0;
+} // namespace
+
+bool NX::H5Support::Support::IsLibraryThreadSafe()
+{
+  static const bool threadSafe = []() {
+    hbool_t isThreadSafe = false;
+    return H5is_library_threadsafe(&isThreadSafe) >= 0 && isThreadSafe;
+  }();
+  return threadSafe;
+}
+
+NX::H5Support::Support::Hdf5Lock::Hdf5Lock()
+: m_Locked(!IsLibraryThreadSafe())
+{
+  if(m_Locked)
+  {
+    hdf5Mutex().lock();
+    t_LockDepth++;
+  }
+}
+
+NX::H5Support::Support::Hdf5Lock::~Hdf5Lock()
+{
+  if(m_Locked)
+  {
+    t_LockDepth--;
+    hdf5Mutex().unlock();
+  }
+}
+
+NX::H5Support::Support::Hdf5Unlock::Hdf5Unlock()
+: m_Unlocked(t_CallbackDepth == 0 && t_LockDepth == 1)
+{
+  if(m_Unlocked)
+  {
+    t_LockDepth--;
+    hdf5Mutex().unlock();
+  }
+}
+
+NX::H5Support::Support::Hdf5Unlock::~Hdf5Unlock()
+{
+  if(m_Unlocked)
+  {
+    hdf5Mutex().lock();
+    t_LockDepth++;
+  }
+}
+
+NX::H5Support::Support::Hdf5CallbackScope::Hdf5CallbackScope()
+{
+  t_CallbackDepth++;
+}
+
+NX::H5Support::Support::Hdf5CallbackScope::~Hdf5CallbackScope()
+{
+  t_CallbackDepth--;
+}
 
 herr_t NX::H5Support::Support::FindAttr(hid_t /*locationID*/, const char* name, const H5A_info_t* /*info*/, void* opData)
 {
@@ -26,13 +100,119 @@ herr_t NX::H5Support::Support::FindAttr(hid_t /*locationID*/, const char* name,
 
 herr_t NX::H5Support::Support::FindAttribute(hid_t locationId, const std::string& attributeName)
 {
-  hsize_t attributeNum;
-  herr_t returnError = 0;
+  H5SUPPORT_MUTEX_LOCK()
 
-  attributeNum = 0;
-  returnError = H5Aiterate(locationId, H5_INDEX_NAME, H5_ITER_INC, &attributeNum, FindAttr, const_cast<char*>(attributeName.c_str()));
+  return H5Aexists(locationId, attributeName.c_str());
+}
 
-  return returnError;
+bool NX::H5Support::Support::PathExists(hid_t locationId, const std::string& path)
+{
+  H5SUPPORT_MUTEX_LOCK()
+
+  // H5Lexists fails, instead of returning false, if an intermediate level is missing
+  size_t end = path.find_first_not_of('/');
+  bool checkedLevel = false;
+  while(end < path.size())
+  {
+    end = path.find('/', end);
+    const std::string level = path.substr(0, end);
+    if(H5Lexists(locationId, level.c_str(), H5P_DEFAULT) <= 0)
+    {
+      return false;
+    }
+    checkedLevel = true;
+    end = path.find_first_not_of('/', end);
+  }
+  return checkedLevel;
+}
+
+hid_t NX::H5Support::Support::OpenOrCreateGroup(hid_t locationId, const std::string& path, hid_t creationPropertiesId)
+{
+  H5SUPPORT_MUTEX_LOCK()
+
+  if(PathExists(locationId, path))
+  {
+    return H5Gopen(locationId, path.c_str(), H5P_DEFAULT);
+  }
+
+  hid_t linkPropertiesId = H5Pcreate(H5P_LINK_CREATE);
+  if(linkPropertiesId < 0)
+  {
+    return linkPropertiesId;
+  }
+  H5Pset_create_intermediate_group(linkPropertiesId, 1);
+
+  // Another thread may create the group or one of its intermediate groups
+  // between the check and the create. The group is then opened, or the create
+  // repeated for the levels still missing. Every failed create means another
+  // thread added a level, so one attempt per level is enough.
+  const size_t numLevels = std::count(path.cbegin(), path.cend(), '/') + 1;
+  hid_t groupId = H5Gcreate(locationId, path.c_str(), linkPropertiesId, creationPropertiesId, H5P_DEFAULT);
+  for(size_t attempt = 0; groupId < 0 && attempt < numLevels; attempt++)
+  {
+    if(PathExists(locationId, path))
+    {
+      groupId = H5Gopen(locationId, path.c_str(), H5P_DEFAULT);
+      break;
+    }
+    groupId = H5Gcreate(locationId, path.c_str(), linkPropertiesId, creationPropertiesId, H5P_DEFAULT);
+  }
+  H5Pclose(linkPropertiesId);
+  return groupId;
+}
+
+NX::H5Support::ObjectType NX::H5Support::Support::GetObjectType(H5O_type_t objectType)
+{
+  switch(objectType)
+  {
+  case H5O_TYPE_GROUP:
+    return ObjectType::group;
+  case H5O_TYPE_DATASET:
+    return ObjectType::dataset;
+  case H5O_TYPE_NAMED_DATATYPE:
+    return ObjectType::namedDatatype;
+  default:
+    break;
+  }
+  return ObjectType::unknown;
+}
+
+hid_t NX::H5Support::Support::OpenOrCreateAttribute(hid_t locationId, const std::string& attributeName, hid_t typeId, hid_t dataspaceId)
+{
+  H5SUPPORT_MUTEX_LOCK()
+
+  htri_t exists = H5Aexists(locationId, attributeName.c_str());
+  if(exists < 0)
+  {
+    return exists;
+  }
+
+  if(exists > 0)
+  {
+    hid_t attributeId = H5Aopen(locationId, attributeName.c_str(), H5P_DEFAULT);
+    if(attributeId >= 0)
+    {
+      hid_t existingTypeId = H5Aget_type(attributeId);
+      hid_t existingSpaceId = H5Aget_space(attributeId);
+      bool matches = H5Tequal(existingTypeId, typeId) > 0 && H5Sextent_equal(existingSpaceId, dataspaceId) > 0;
+      H5Sclose(existingSpaceId);
+      H5Tclose(existingTypeId);
+      if(matches)
+      {
+        return attributeId;
+      }
+      H5Aclose(attributeId);
+    }
+
+    herr_t error = H5Adelete(locationId, attributeName.c_str());
+    if(error < 0)
+    {
+      std::cout << "Error Deleting Attribute '" << attributeName << "'" << std::endl;
+      return error;
+    }
+  }
+
+  return H5Acreate(locationId, attributeName.c_str(), typeId, dataspaceId, H5P_DEFAULT, H5P_DEFAULT);
 }
 
 std::string NX::H5Support::Support::HdfClassTypeAsStr(hid_t classType)
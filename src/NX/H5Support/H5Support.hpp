@@ -7,19 +7,82 @@
 #include <H5Ppublic.h>
 #include <hdf5.h>
 
+namespace NX::H5Support::Support
+{
+/**
+ * @brief Holds the library-wide recursive HDF5 lock for its lifetime. The
+ * lock is skipped when the HDF5 library was built thread-safe and already
+ * serializes its API calls.
+ */
+class NXH5SUPPORT_EXPORT Hdf5Lock
+{
+public:
+  Hdf5Lock();
+  ~Hdf5Lock();
+
+  Hdf5Lock(const Hdf5Lock&) = delete;
+  Hdf5Lock& operator=(const Hdf5Lock&) = delete;
+
+private:
+  bool m_Locked = false;
+};
+
+/**
+ * @brief Releases the HDF5 lock for its lifetime so that work which does not
+ * touch HDF5, such as file I/O behind HDF5's back, can overlap with other
+ * threads' HDF5 calls. The lock is reacquired on destruction. Only a lock
+ * taken once by the calling thread is released, since outer callers holding
+ * it rely on their calls staying atomic. Does nothing while the calling thread
+ * is inside an Hdf5CallbackScope.
+ */
+class NXH5SUPPORT_EXPORT Hdf5Unlock
+{
+public:
+  Hdf5Unlock();
+  ~Hdf5Unlock();
+
+  Hdf5Unlock(const Hdf5Unlock&) = delete;
+  Hdf5Unlock& operator=(const Hdf5Unlock&) = delete;
+
+private:
+  bool m_Unlocked = false;
+};
+
+/**
+ * @brief Marks user code running inside an HDF5 callback, such as an iteration
+ * operator, for its lifetime. HDF5 is still mid-call, so Hdf5Unlock keeps the
+ * lock held until the scope ends.
+ */
+class NXH5SUPPORT_EXPORT Hdf5CallbackScope
+{
+public:
+  Hdf5CallbackScope();
+  ~Hdf5CallbackScope();
+
+  Hdf5CallbackScope(const Hdf5CallbackScope&) = delete;
+  Hdf5CallbackScope& operator=(const Hdf5CallbackScope&) = delete;
+};
+
+/**
+ * @brief Returns true if the HDF5 library serializes its own API calls.
+ * @return bool
+ */
+bool NXH5SUPPORT_EXPORT IsLibraryThreadSafe();
+} // namespace NX::H5Support::Support
+
 #ifdef H5Support_USE_MUTEX
-#include <mutex>
-#define H5SUPPORT_MUTEX_LOCK()                                                                                                                                                                         \
-  std::mutex mutex;                                                                                                                                                                                    \
-  std::lock_guard<std::mutex> lock(mutex);
+#define H5SUPPORT_MUTEX_LOCK() NX::H5Support::Support::Hdf5Lock _h5SupportLock;
+#define H5SUPPORT_MUTEX_UNLOCK() NX::H5Support::Support::Hdf5Unlock _h5SupportUnlock;
 #else
 #define H5SUPPORT_MUTEX_LOCK()
+#define H5SUPPORT_MUTEX_UNLOCK()
 #endif
 
 #include <iostream>
 #include <numeric>
 #include <stdexcept>
 #include <string>
+#include <type_traits>
 #include <vector>
 
 // Defined in CMake
@@ -120,6 +183,58 @@ herr_t NXH5SUPPORT_EXPORT FindAttr(hid_t /*locationId*/, const char* name, const
  */
 herr_t NXH5SUPPORT_EXPORT FindAttribute(hid_t locationId, const std::string& attributeName);
 
+/**
+ * @brief Opens the attribute named attributeName attached to locationId so
+ * that it can be written. An existing attribute whose datatype and extent match
+ * typeId and dataspaceId is reused and overwritten in place. Any other existing
+ * attribute is deleted and recreated. The caller is responsible for closing
+ * the returned ID with H5Aclose.
+ * @param locationId The object the attribute is attached to
+ * @param attributeName The attribute to open or create
+ * @param typeId The datatype of the values to write
+ * @param dataspaceId The dataspace of the values to write
+ * @return The attribute ID or a negative value on error
+ */
+hid_t NXH5SUPPORT_EXPORT OpenOrCreateAttribute(hid_t locationId, const std::string& attributeName, hid_t typeId, hid_t dataspaceId);
+
+/**
+ * @brief Returns true if every link along the path exists relative to
+ * locationId. Checks each level with H5Lexists, so missing levels do not
+ * raise HDF5 errors.
+ * @param locationId The location the path is relative to
+ * @param path A relative or absolute path such as "a/b/c"
+ * @return bool
+ */
+bool NXH5SUPPORT_EXPORT PathExists(hid_t locationId, const std::string& path);
+
+/**
+ * @brief Opens the group at the path relative to locationId, creating it and
+ * any missing intermediate groups in a single call if it does not exist. If
+ * another thread creates the group or one of its parents first, the existing
+ * groups are used.
+ * @param locationId The location the path is relative to
+ * @param path A relative or absolute path such as "a/b/c"
+ * @param creationPropertiesId Group creation properties used for the final group
+ * @return The group ID or a negative value on error
+ */
+hid_t NXH5SUPPORT_EXPORT OpenOrCreateGroup(hid_t locationId, const std::string& path, hid_t creationPropertiesId = H5P_DEFAULT);
+
+/**
+ * @brief Returns the ObjectType matching an HDF5 object type.
+ * @param objectType
+ * @return ObjectType
+ */
+ObjectType NXH5SUPPORT_EXPORT GetObjectType(H5O_type_t objectType);
+
+/**
+ * @brief True for the primitive types HdfTypeForPrimitive() maps to a native
+ * HDF5 type, so that unsupported types can be rejected at compile time.
+ */
+template <typename T>
+inline constexpr bool k_IsHdfPrimitive = std::is_same_v<T, float> || std::is_same_v<T, double> || std::is_same_v<T, int8_t> || std::is_same_v<T, uint8_t> || std::is_same_v<T, char> ||
+                                         std::is_same_v<T, int16_t> || std::is_same_v<T, uint16_t> || std::is_same_v<T, int32_t> || std::is_same_v<T, uint32_t> ||
+                                         std::is_same_v<T, int64_t> || std::is_same_v<T, uint64_t> || std::is_same_v<T, bool> || std::is_same_v<T, size_t>;
+
 /**
  * @brief Returns the HDF Type for a given primitive value.
  * @return The H5 native type for the value
@@ -127,6 +242,8 @@ herr_t NXH5SUPPORT_EXPORT FindAttribute(hid_t locationId, const std::string& att
 template <typename T>
 inline hid_t HdfTypeForPrimitive()
 {
+  static_assert(k_IsHdfPrimitive<T>, "HdfTypeForPrimitive does not support this type");
+
   if constexpr(std::is_same_v<T, float>)
   {
     return H5T_NATIVE_FLOAT;
@@ -182,14 +299,11 @@ inline hid_t HdfTypeForPrimitive()
   {
     return H5T_NATIVE_UINT8;
   }
-  else if constexpr(std::is_same_v<T, size_t>)
-  {
-    return H5T_NATIVE_UINT64;
-  }
   else
   {
-    throw std::runtime_error("HdfTypeForPrimitive does not support this type");
-    return -1;
+    // size_t where it is distinct from uint64_t, the only type the
+    // static_assert leaves
+    return H5T_NATIVE_UINT64;
   }
 }
 
@@ -207,6 +321,8 @@ std::string NXH5SUPPORT_EXPORT HdfClassTypeAsStr(hid_t classType);
 template <typename T>
 inline std::string HdfTypeForPrimitiveAsStr()
 {
+  static_assert(k_IsHdfPrimitive<T>, "HdfTypeForPrimitiveAsStr does not support this type");
+
   if constexpr(std::is_same_v<T, float>)
   {
     return "H5T_NATIVE_FLOAT";
@@ -262,14 +378,11 @@ inline std::string HdfTypeForPrimitiveAsStr()
   {
     return "H5T_NATIVE_UINT8";
   }
-  else if constexpr(std::is_same_v<T, usize>)
-  {
-    return "H5T_NATIVE_UINT64";
-  }
   else
   {
-    throw std::runtime_error("HdfTypeForPrimitive does not support this type");
-    return "";
+    // size_t where it is distinct from uint64_t, the only type the
+    // static_assert leaves
+    return "H5T_NATIVE_UINT64";
   }
 }
 
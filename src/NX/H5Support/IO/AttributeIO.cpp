@@ -1,6 +1,7 @@
 #include "AttributeIO.hpp"
 
 #include "NX/H5Support/H5Support.hpp"
+#include "NX/H5Support/Instrumentation.hpp"
 
 #include <H5Apublic.h>
 
@@ -15,13 +16,21 @@ AttributeIO::AttributeIO() = default;
 AttributeIO::AttributeIO(IdType objectId, size_t attrIdx)
 : m_ObjectId(objectId)
 {
+  H5SUPPORT_MUTEX_LOCK()
+
   m_AttributeId = H5Aopen_idx(objectId, attrIdx);
 }
 
 AttributeIO::AttributeIO(IdType objectId, const std::string& attrName)
 : m_ObjectId(objectId)
+, m_AttributeName(attrName)
 {
-  m_AttributeId = H5Aopen(objectId, attrName.c_str(), H5P_DEFAULT);
+  H5SUPPORT_MUTEX_LOCK()
+
+  if(H5Aexists(objectId, attrName.c_str()) > 0)
+  {
+    m_AttributeId = H5Aopen(objectId, attrName.c_str(), H5P_DEFAULT);
+  }
 }
 
 AttributeIO::~AttributeIO()
@@ -31,6 +40,8 @@ AttributeIO::~AttributeIO()
 
 void AttributeIO::closeHdf5()
 {
+  H5SUPPORT_MUTEX_LOCK()
+
   if(isValid())
   {
     H5Aclose(m_AttributeId);
@@ -40,11 +51,12 @@ void AttributeIO::closeHdf5()
 
 ErrorType AttributeIO::findAndDeleteAttribute()
 {
-  hsize_t attributeNum = 0;
-  int32_t hasAttribute = H5Aiterate(getObjectId(), H5_INDEX_NAME, H5_ITER_INC, &attributeNum, Support::FindAttr, const_cast<char*>(getName().c_str()));
+  H5SUPPORT_MUTEX_LOCK()
+
+  htri_t hasAttribute = H5Aexists(getObjectId(), getName().c_str());
 
   /* The attribute already exists, delete it */
-  if(hasAttribute == 1)
+  if(hasAttribute > 0)
   {
     herr_t error = H5Adelete(getObjectId(), getName().c_str());
     if(error < 0)
@@ -56,6 +68,21 @@ ErrorType AttributeIO::findAndDeleteAttribute()
   return 0;
 }
 
+IdType AttributeIO::openForWriting(IdType typeId, IdType dataspaceId)
+{
+  H5SUPPORT_MUTEX_LOCK()
+
+  const std::string name = getName();
+  closeHdf5();
+  m_AttributeId = Support::OpenOrCreateAttribute(getObjectId(), name, typeId, dataspaceId);
+  return m_AttributeId;
+}
+
+bool AttributeIO::canWrite() const
+{
+  return getObjectId() > 0 && !getName().empty();
+}
+
 bool AttributeIO::isValid() const
 {
   return getAttributeId() > 0;
@@ -73,14 +100,18 @@ IdType AttributeIO::getAttributeId() const
 
 IdType AttributeIO::getDataspaceId() const
 {
+  H5SUPPORT_MUTEX_LOCK()
+
   return H5Aget_space(getAttributeId());
 }
 
 std::string AttributeIO::getName() const
 {
+  H5SUPPORT_MUTEX_LOCK()
+
   if(!isValid())
   {
-    return "";
+    return m_AttributeName;
   }
 
   const size_t size = 1024;
@@ -114,17 +145,23 @@ Type AttributeIO::getType() const
 
 IdType AttributeIO::getClassType() const
 {
+  H5SUPPORT_MUTEX_LOCK()
+
   auto typeId = getTypeId();
   return H5Tget_class(typeId);
 }
 
 IdType AttributeIO::getTypeId() const
 {
+  H5SUPPORT_MUTEX_LOCK()
+
   return H5Aget_type(getAttributeId());
 }
 
 size_t AttributeIO::getNumElements() const
 {
+  H5SUPPORT_MUTEX_LOCK()
+
   size_t typeSize = H5Tget_size(getTypeId());
   std::vector<hsize_t> dims;
   hid_t dataspaceId = getDataspaceId();
@@ -183,6 +220,8 @@ T AttributeIO::readAsValue() const
 
 std::string AttributeIO::readAsString() const
 {
+  H5SUPPORT_MUTEX_LOCK()
+
   if(!isValid())
   {
     return "";
@@ -201,6 +240,7 @@ std::string AttributeIO::readAsString() const
   }
   if(getAttributeId() >= 0)
   {
+    H5SUPPORT_INSTRUMENT(ReadAttribute, m_ObjectId)
     hsize_t size = H5Aget_storage_size(getAttributeId());
     attributeOutput.resize(static_cast<size_t>(size)); // Resize the vector to the proper length
     hid_t attributeType = getTypeId();
@@ -219,6 +259,7 @@ std::string AttributeIO::readAsString() const
         }
         data.append(attributeOutput.data(),
                     size); // Append the data to the passed in string
+        H5SUPPORT_INSTRUMENT_BYTES(size)
       }
       // H5Tclose(attributeType);
     }
@@ -229,7 +270,9 @@ std::string AttributeIO::readAsString() const
 
 herr_t AttributeIO::writeString(const std::string& text)
 {
-  if(!isValid())
+  H5SUPPORT_MUTEX_LOCK()
+
+  if(!canWrite())
   {
     return -1;
   }
@@ -267,22 +310,22 @@ herr_t AttributeIO::writeString(const std::string& text)
           hid_t attributeSpaceID = H5Screate(H5S_SCALAR);
           if(attributeSpaceID >= 0)
           {
-            /* Verify if the attribute already exists */
-            returnError = findAndDeleteAttribute();
-            if(error >= 0)
+            /* Open and write the attribute. An existing string of the same length is overwritten in place. */
+            H5SUPPORT_INSTRUMENT(WriteAttribute, m_ObjectId)
+            hid_t attributeId = openForWriting(attributeType, attributeSpaceID);
+            if(attributeId >= 0)
             {
-              /* Create and write the attribute */
-              hid_t attributeId = H5Acreate(getObjectId(), getName().c_str(), attributeType, attributeSpaceID, H5P_DEFAULT, H5P_DEFAULT);
-              if(attributeId >= 0)
+              error = H5Awrite(attributeId, attributeType, text.c_str());
+              if(error < 0)
               {
-                error = H5Awrite(attributeId, attributeType, text.c_str());
-                if(error < 0)
-                {
-                  std::cout << "Error Writing String attribute." << std::endl;
-                  returnError = error;
-                }
+                std::cout << "Error Writing String attribute." << std::endl;
+                returnError = error;
               }
-              H5S_CLOSE_H5_ATTRIBUTE(attributeId, error, returnError)
+              H5SUPPORT_INSTRUMENT_BYTES(error < 0 ? 0 : size)
+            }
+            else
+            {
+              returnError = static_cast<herr_t>(attributeId);
             }
             H5S_CLOSE_H5_DATASPACE(attributeSpaceID, error, returnError)
           }
@@ -298,7 +341,9 @@ herr_t AttributeIO::writeString(const std::string& text)
 template <typename T>
 herr_t AttributeIO::writeValue(T value)
 {
-  if(!isValid())
+  H5SUPPORT_MUTEX_LOCK()
+
+  if(!canWrite())
   {
     return -1;
   }
@@ -307,10 +352,6 @@ herr_t AttributeIO::writeValue(T value)
   herr_t returnError = 0;
 
   hid_t dataType = Support::HdfTypeForPrimitive<T>();
-  if(dataType == -1)
-  {
-    return -1;
-  }
   /* Get the type of object */
   // H5O_info_t objectInfo;
   // error = H5Oget_info_by_name(getObjectId(), getObjectName().c_str(),
@@ -327,29 +368,23 @@ herr_t AttributeIO::writeValue(T value)
   hid_t dataspaceId = H5Screate_simple(rank, &dims, nullptr);
   if(dataspaceId >= 0)
   {
-    // Delete existing attribute
-    error = findAndDeleteAttribute();
-    if(error >= 0)
+    /* Open the attribute. An existing attribute of the same shape is overwritten in place. */
+    H5SUPPORT_INSTRUMENT(WriteAttribute, m_ObjectId)
+    hid_t attributeId = openForWriting(dataType, dataspaceId);
+    if(attributeId >= 0)
     {
-      /* Create the attribute. */
-      hid_t attributeId = H5Acreate(getObjectId(), getName().c_str(), dataType, dataspaceId, H5P_DEFAULT, H5P_DEFAULT);
-      if(attributeId >= 0)
-      {
-        /* Write the attribute data. */
-        error = H5Awrite(attributeId, dataType, &value);
-        if(error < 0)
-        {
-          std::cout << "Error Writing Attribute" << std::endl;
-          returnError = error;
-        }
-      }
-      /* Close the attribute. */
-      error = H5Aclose(attributeId);
+      /* Write the attribute data. */
+      error = H5Awrite(attributeId, dataType, &value);
       if(error < 0)
       {
-        std::cout << "Error Closing Attribute" << std::endl;
+        std::cout << "Error Writing Attribute" << std::endl;
         returnError = error;
       }
+      H5SUPPORT_INSTRUMENT_BYTES(error < 0 ? 0 : sizeof(T))
+    }
+    else
+    {
+      returnError = static_cast<herr_t>(attributeId);
     }
     /* Close the dataspace. */
     error = H5Sclose(dataspaceId);
@@ -370,11 +405,14 @@ herr_t AttributeIO::writeValue(T value)
 template <typename T>
 std::vector<T> AttributeIO::readAsVector() const
 {
+  H5SUPPORT_MUTEX_LOCK()
+
   if(!isValid())
   {
     return {};
   }
 
+  H5SUPPORT_INSTRUMENT(ReadAttribute, m_ObjectId)
   const size_t count = getNumElements();
   T* values = new T[getNumElements()];
   IdType typeId = getTypeId();
@@ -385,6 +423,7 @@ std::vector<T> AttributeIO::readAsVector() const
     std::cout << "Error Reading Attribute." << error << std::endl;
     return {};
   }
+  H5SUPPORT_INSTRUMENT_BYTES(count * sizeof(T))
 
   std::vector<T> vector(count);
   for(size_t i = 0; i < count; i++)
@@ -398,7 +437,9 @@ std::vector<T> AttributeIO::readAsVector() const
 template <typename T>
 ErrorType AttributeIO::writeVector(const DimsVector& dims, const std::vector<T>& vector)
 {
-  if(!isValid())
+  H5SUPPORT_MUTEX_LOCK()
+
+  if(!canWrite())
   {
     return -1;
   }
@@ -407,39 +448,29 @@ ErrorType AttributeIO::writeVector(const DimsVector& dims, const std::vector<T>&
   int32_t rank = static_cast<int32_t>(dims.size());
 
   hid_t dataType = Support::HdfTypeForPrimitive<T>();
-  if(dataType == -1)
-  {
-    std::cout << "dataType was unknown" << std::endl;
-    return -1;
-  }
 
   hid_t dataspaceId = H5Screate_simple(rank, dims.data(), nullptr);
   if(dataspaceId >= 0)
   {
-    // Delete any existing attribute
-    herr_t error = findAndDeleteAttribute();
+    herr_t error = 0;
 
-    if(error >= 0)
+    /* Open the attribute. An existing attribute of the same shape is overwritten in place. */
+    H5SUPPORT_INSTRUMENT(WriteAttribute, m_ObjectId)
+    hid_t attributeId = openForWriting(dataType, dataspaceId);
+    if(attributeId >= 0)
     {
-      /* Create the attribute. */
-      hid_t attributeId = H5Acreate(getObjectId(), getName().c_str(), dataType, dataspaceId, H5P_DEFAULT, H5P_DEFAULT);
-      if(attributeId >= 0)
-      {
-        /* Write the attribute data. */
-        error = H5Awrite(attributeId, dataType, static_cast<const void*>(vector.data()));
-        if(error < 0)
-        {
-          std::cout << "Error Writing Attribute" << std::endl;
-          returnError = error;
-        }
-      }
-      /* Close the attribute. */
-      error = H5Aclose(attributeId);
+      /* Write the attribute data. */
+      error = H5Awrite(attributeId, dataType, static_cast<const void*>(vector.data()));
       if(error < 0)
       {
-        std::cout << "Error Closing Attribute" << std::endl;
+        std::cout << "Error Writing Attribute" << std::endl;
         returnError = error;
       }
+      H5SUPPORT_INSTRUMENT_BYTES(error < 0 ? 0 : vector.size() * sizeof(T))
+    }
+    else
+    {
+      returnError = static_cast<herr_t>(attributeId);
     }
     /* Close the dataspace. */
     error = H5Sclose(dataspaceId);
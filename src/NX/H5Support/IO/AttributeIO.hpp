@@ -30,7 +30,8 @@ public:
 
   /**
    * @brief Constructs an AttributeIO wrapping a target HDF5 attribute
-   * belonging to the specified object with the target name.
+   * belonging to the specified object with the target name. If no such
+   * attribute exists yet, the AttributeIO is invalid until it is written to.
    * @param objectId
    * @param attrName
    */
@@ -69,8 +70,8 @@ public:
   IdType getDataspaceId() const;
 
   /**
-   * @brief Returns the HDF5 attribute name. Returns an empty string if the
-   * attribute is invalid.
+   * @brief Returns the HDF5 attribute name. Returns the name the AttributeIO
+   * was constructed with if the attribute has not been created yet.
    * @return std::string
    */
   std::string getName() const;
@@ -175,6 +176,25 @@ protected:
    */
   ErrorType findAndDeleteAttribute();
 
+  /**
+   * @brief Returns true if the AttributeIO has an object and a name to write
+   * to, whether or not the attribute already exists.
+   * @return bool
+   */
+  bool canWrite() const;
+
+  /**
+   * @brief Opens the attribute for writing values of the specified type and
+   * dataspace and keeps it open as the wrapped attribute. An existing
+   * attribute of the same type and extent is reused so that it is overwritten
+   * in place. Otherwise it is replaced. Returns the attribute ID or a negative
+   * value on error.
+   * @param typeId
+   * @param dataspaceId
+   * @return IdType
+   */
+  IdType openForWriting(IdType typeId, IdType dataspaceId);
+
 private:
   IdType m_ObjectId = 0;
   IdType m_AttributeId = 0;
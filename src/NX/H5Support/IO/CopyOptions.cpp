@@ -0,0 +1,57 @@
+#include "CopyOptions.hpp"
+
+#include "NX/H5Support/H5Support.hpp"
+
+#include <H5Ppublic.h>
+
+#include <iostream>
+
+namespace NX::H5Support
+{
+IdType CopyOptions::createCopyProperties() const
+{
+  H5SUPPORT_MUTEX_LOCK()
+
+  hid_t copyPropertiesId = H5Pcreate(H5P_OBJECT_COPY);
+  if(copyPropertiesId < 0)
+  {
+    return copyPropertiesId;
+  }
+
+  unsigned flags = 0;
+  flags |= shallowHierarchy ? H5O_COPY_SHALLOW_HIERARCHY_FLAG : 0u;
+  flags |= expandSoftLinks ? H5O_COPY_EXPAND_SOFT_LINK_FLAG : 0u;
+  flags |= expandExternalLinks ? H5O_COPY_EXPAND_EXT_LINK_FLAG : 0u;
+  flags |= expandReferences ? H5O_COPY_EXPAND_REFERENCE_FLAG : 0u;
+  flags |= copyAttributes ? 0u : H5O_COPY_WITHOUT_ATTR_FLAG;
+  flags |= mergeCommittedDatatypes ? H5O_COPY_MERGE_COMMITTED_DTYPE_FLAG : 0u;
+  herr_t error = H5Pset_copy_object(copyPropertiesId, flags);
+  if(error < 0)
+  {
+    std::cout << "Error Setting Object Copy Flags" << std::endl;
+    H5Pclose(copyPropertiesId);
+    return error;
+  }
+  return copyPropertiesId;
+}
+
+IdType CopyOptions::createLinkProperties() const
+{
+  H5SUPPORT_MUTEX_LOCK()
+
+  hid_t linkPropertiesId = H5Pcreate(H5P_LINK_CREATE);
+  if(linkPropertiesId < 0)
+  {
+    return linkPropertiesId;
+  }
+
+  herr_t error = H5Pset_create_intermediate_group(linkPropertiesId, createIntermediateGroups ? 1 : 0);
+  if(error < 0)
+  {
+    std::cout << "Error Setting Intermediate Group Creation" << std::endl;
+    H5Pclose(linkPropertiesId);
+    return error;
+  }
+  return linkPropertiesId;
+}
+} // namespace NX::H5Support
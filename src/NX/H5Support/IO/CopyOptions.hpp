@@ -0,0 +1,72 @@
+#pragma once
+
+#include "NX/H5Support/H5.hpp"
+#include "NX/H5Support/NXH5SUPPORT_EXPORT.hpp"
+
+namespace NX::H5Support
+{
+/**
+ * @brief CopyOptions describes how GroupIO::copyFrom copies objects with
+ * H5Ocopy. Default constructed options copy the complete subtree with its
+ * attributes, keep soft and external links as links and create any missing
+ * intermediate groups in the destination path. H5Ocopy moves chunked and
+ * contiguous raw data without decoding it whenever no datatype conversion is
+ * needed.
+ */
+struct NXH5SUPPORT_EXPORT CopyOptions
+{
+  /**
+   * @brief Copies only the immediate members of a group instead of the
+   * complete subtree.
+   */
+  bool shallowHierarchy = false;
+
+  /**
+   * @brief Copies the objects soft links point to instead of the links.
+   */
+  bool expandSoftLinks = false;
+
+  /**
+   * @brief Copies the objects external links point to instead of the links.
+   */
+  bool expandExternalLinks = false;
+
+  /**
+   * @brief Copies the objects referenced by object references and updates the
+   * references to point at the copies.
+   */
+  bool expandReferences = false;
+
+  /**
+   * @brief Copies the attributes of every copied object.
+   */
+  bool copyAttributes = true;
+
+  /**
+   * @brief Reuses matching committed datatypes in the destination file instead
+   * of copying them again.
+   */
+  bool mergeCommittedDatatypes = false;
+
+  /**
+   * @brief Creates missing groups in the destination path.
+   */
+  bool createIntermediateGroups = true;
+
+  /**
+   * @brief Creates an HDF5 object copy property list matching the options.
+   * The caller is responsible for closing the returned ID with H5Pclose.
+   * Returns a negative value if the property list could not be created.
+   * @return IdType
+   */
+  IdType createCopyProperties() const;
+
+  /**
+   * @brief Creates an HDF5 link creation property list matching the options.
+   * The caller is responsible for closing the returned ID with H5Pclose.
+   * Returns a negative value if the property list could not be created.
+   * @return IdType
+   */
+  IdType createLinkProperties() const;
+};
+} // namespace NX::H5Support
@@ -0,0 +1,90 @@
+#include "DatasetCache.hpp"
+
+namespace NX::H5Support
+{
+DatasetCache::DatasetCache(size_t capacity)
+: m_Capacity(capacity)
+{
+}
+
+DatasetCache::~DatasetCache() noexcept
+{
+  clear();
+}
+
+size_t DatasetCache::getCapacity() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_Capacity;
+}
+
+void DatasetCache::setCapacity(size_t capacity)
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  m_Capacity = capacity;
+  evict(capacity);
+}
+
+size_t DatasetCache::size() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_Entries.size();
+}
+
+std::shared_ptr<DatasetIO> DatasetCache::open(IdType locationId, const std::string& path)
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+
+  auto iter = m_Index.find(path);
+  if(iter != m_Index.end())
+  {
+    m_Entries.splice(m_Entries.begin(), m_Entries, iter->second);
+    return iter->second->second;
+  }
+
+  auto dataset = std::make_shared<DatasetIO>(locationId, path);
+  if(!dataset->open())
+  {
+    return nullptr;
+  }
+  if(m_Capacity == 0)
+  {
+    return dataset;
+  }
+
+  evict(m_Capacity - 1);
+  m_Entries.emplace_front(path, dataset);
+  m_Index[path] = m_Entries.begin();
+  return dataset;
+}
+
+bool DatasetCache::erase(const std::string& path)
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+
+  auto iter = m_Index.find(path);
+  if(iter == m_Index.end())
+  {
+    return false;
+  }
+  m_Entries.erase(iter->second);
+  m_Index.erase(iter);
+  return true;
+}
+
+void DatasetCache::clear()
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  m_Index.clear();
+  m_Entries.clear();
+}
+
+void DatasetCache::evict(size_t capacity)
+{
+  while(m_Entries.size() > capacity)
+  {
+    m_Index.erase(m_Entries.back().first);
+    m_Entries.pop_back();
+  }
+}
+} // namespace NX::H5Support
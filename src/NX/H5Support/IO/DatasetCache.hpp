@@ -0,0 +1,96 @@
+#pragma once
+
+#include "NX/H5Support/IO/DatasetIO.hpp"
+#include "NX/H5Support/NXH5SUPPORT_EXPORT.hpp"
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace NX::H5Support
+{
+/**
+ * @brief Keeps up to a fixed number of datasets open, keyed by their path
+ * from the owning location. When the cache is full the least recently used
+ * dataset is released. Cached datasets keep their metadata between uses so
+ * repeated reads skip both H5Dopen and the dimension and type queries.
+ * All methods may be called concurrently.
+ */
+class NXH5SUPPORT_EXPORT DatasetCache
+{
+public:
+  /**
+   * @brief Constructs a cache holding at most capacity datasets. A capacity
+   * of 0 disables caching.
+   * @param capacity
+   */
+  explicit DatasetCache(size_t capacity = 0);
+
+  DatasetCache(const DatasetCache& other) = delete;
+  DatasetCache& operator=(const DatasetCache& rhs) = delete;
+
+  /**
+   * @brief Releases every cached dataset.
+   */
+  ~DatasetCache() noexcept;
+
+  /**
+   * @brief Returns the maximum number of cached datasets.
+   * @return size_t
+   */
+  size_t getCapacity() const;
+
+  /**
+   * @brief Changes the maximum number of cached datasets, evicting the least
+   * recently used datasets if the cache holds more than the new capacity.
+   * @param capacity
+   */
+  void setCapacity(size_t capacity);
+
+  /**
+   * @brief Returns the number of datasets currently cached.
+   * @return size_t
+   */
+  size_t size() const;
+
+  /**
+   * @brief Returns the open dataset at the path relative to locationId,
+   * opening and caching it on a miss. When caching is disabled a new dataset
+   * is opened on every call. Returns nullptr if the dataset cannot be opened.
+   * @param locationId
+   * @param path
+   * @return std::shared_ptr<DatasetIO>
+   */
+  std::shared_ptr<DatasetIO> open(IdType locationId, const std::string& path);
+
+  /**
+   * @brief Removes the dataset at the path from the cache. Returns true if it
+   * was cached.
+   * @param path
+   * @return bool
+   */
+  bool erase(const std::string& path);
+
+  /**
+   * @brief Releases every cached dataset. Datasets still referenced elsewhere
+   * stay open until their last reference is released.
+   */
+  void clear();
+
+private:
+  using Entry = std::pair<std::string, std::shared_ptr<DatasetIO>>;
+
+  /**
+   * @brief Drops least recently used entries until at most capacity remain.
+   * The mutex must be held.
+   */
+  void evict(size_t capacity);
+
+  mutable std::mutex m_Mutex;
+  size_t m_Capacity = 0;
+  std::list<Entry> m_Entries; // most recently used first
+  std::unordered_map<std::string, std::list<Entry>::iterator> m_Index;
+};
+} // namespace NX::H5Support
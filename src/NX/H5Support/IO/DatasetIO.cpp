@@ -1,17 +1,297 @@
 #include "DatasetIO.hpp"
 
+#include "NX/H5Support/Drivers/IoUringDriver.hpp"
 #include "NX/H5Support/H5.hpp"
 #include "NX/H5Support/H5Support.hpp"
+#include "NX/H5Support/Instrumentation.hpp"
 
 #include <H5Apublic.h>
 
+#ifdef __linux__
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
+#include <memory>
 #include <numeric>
 
 using namespace NX::Common;
 
 namespace NX::H5Support
 {
+namespace
+{
+/**
+ * @brief Location of a contiguous block of raw data in the file. Chunked
+ * datasets have one block per chunk.
+ */
+struct StorageBlock
+{
+  std::vector<hsize_t> offset;
+  haddr_t address = HADDR_UNDEF;
+  hsize_t size = 0;
+};
+
+/**
+ * @brief Collects the file address of the dataset's contiguous storage or of
+ * each of its chunks. Returns false if the raw data cannot be read directly
+ * from the file, e.g. because it is filtered, compact or not fully allocated.
+ */
+bool getStorageBlocks(hid_t datasetId, std::vector<hsize_t>& chunkDims, std::vector<StorageBlock>& blocks)
+{
+  H5SUPPORT_MUTEX_LOCK()
+
+  hid_t plistId = H5Dget_create_plist(datasetId);
+  if(plistId < 0)
+  {
+    return false;
+  }
+
+  const H5D_layout_t layout = H5Pget_layout(plistId);
+  bool success = H5Pget_nfilters(plistId) == 0;
+  if(success && layout == H5D_CONTIGUOUS)
+  {
+    StorageBlock block;
+    block.address = H5Dget_offset(datasetId);
+    block.size = H5Dget_storage_size(datasetId);
+    success = block.address != HADDR_UNDEF;
+    blocks.push_back(std::move(block));
+  }
+  else if(success && layout == H5D_CHUNKED)
+  {
+    hid_t spaceId = H5Dget_space(datasetId);
+    const int32_t rank = H5Sget_simple_extent_ndims(spaceId);
+    std::vector<hsize_t> dims(rank, 0);
+    H5Sget_simple_extent_dims(spaceId, dims.data(), nullptr);
+    chunkDims.resize(rank);
+    H5Pget_chunk(plistId, rank, chunkDims.data());
+
+    hsize_t expectedChunks = 1;
+    for(int32_t i = 0; i < rank; i++)
+    {
+      expectedChunks *= (dims[i] + chunkDims[i] - 1) / chunkDims[i];
+    }
+    hsize_t numChunks = 0;
+    success = H5Dget_num_chunks(datasetId, spaceId, &numChunks) >= 0 && numChunks == expectedChunks;
+    for(hsize_t i = 0; success && i < numChunks; i++)
+    {
+      StorageBlock block;
+      block.offset.resize(rank);
+      unsigned filterMask = 0;
+      success = H5Dget_chunk_info(datasetId, spaceId, i, block.offset.data(), &filterMask, &block.address, &block.size) >= 0;
+      blocks.push_back(std::move(block));
+    }
+    H5Sclose(spaceId);
+  }
+  else
+  {
+    success = false;
+  }
+  H5Pclose(plistId);
+  return success;
+}
+
+/**
+ * @brief Returns the size of the user block at the start of the object's
+ * file. HDF5 file addresses are relative to its end.
+ */
+hsize_t getUserBlockSize(hid_t objectId)
+{
+  H5SUPPORT_MUTEX_LOCK()
+
+  hid_t fileId = H5Iget_file_id(objectId);
+  hid_t creationPropertiesId = H5Fget_create_plist(fileId);
+  hsize_t userBlockSize = 0;
+  H5Pget_userblock(creationPropertiesId, &userBlockSize);
+  H5Pclose(creationPropertiesId);
+  H5Fclose(fileId);
+  return userBlockSize;
+}
+
+/**
+ * @brief Returns the filter at index along with its flags and client data
+ * values, or a negative value if it cannot be read.
+ */
+H5Z_filter_t getFilter(hid_t plistId, uint32_t index, unsigned& flags, std::vector<unsigned>& values)
+{
+  size_t numValues = 0;
+  unsigned filterConfig = 0;
+  if(H5Pget_filter2(plistId, index, &flags, &numValues, nullptr, 0, nullptr, &filterConfig) < 0)
+  {
+    return -1;
+  }
+  values.assign(numValues, 0);
+  return H5Pget_filter2(plistId, index, &flags, &numValues, values.data(), 0, nullptr, &filterConfig);
+}
+
+/**
+ * @brief Returns true if both dataset creation property lists apply the same
+ * filters with the same settings in the same order, so raw chunks from one
+ * can be stored in the other.
+ */
+bool haveSameFilters(hid_t plistId, hid_t otherPlistId)
+{
+  const int32_t numFilters = H5Pget_nfilters(plistId);
+  if(numFilters < 0 || numFilters != H5Pget_nfilters(otherPlistId))
+  {
+    return false;
+  }
+  std::vector<unsigned> values;
+  std::vector<unsigned> otherValues;
+  for(int32_t i = 0; i < numFilters; i++)
+  {
+    unsigned flags = 0;
+    unsigned otherFlags = 0;
+    const H5Z_filter_t filter = getFilter(plistId, i, flags, values);
+    const H5Z_filter_t otherFilter = getFilter(otherPlistId, i, otherFlags, otherValues);
+    if(filter < 0 || filter != otherFilter || flags != otherFlags || values != otherValues)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief Copies the count elements at sourceOffset in the source dataset to
+ * destOffset in the destination through hyperslab selections. Both datasets
+ * must share a datatype. Returns the HDF5 error, should one occur.
+ */
+herr_t copyEdgeChunk(hid_t sourceId, hid_t destId, const std::vector<hsize_t>& sourceOffset, const std::vector<hsize_t>& destOffset, const std::vector<hsize_t>& count, std::vector<uint8_t>& buffer)
+{
+  H5SUPPORT_INSTRUMENT(Write, destId)
+  hid_t typeId = H5Dget_type(sourceId);
+  hid_t memorySpaceId = H5Screate_simple(static_cast<int>(count.size()), count.data(), nullptr);
+  hid_t sourceSpaceId = H5Dget_space(sourceId);
+  hid_t destSpaceId = H5Dget_space(destId);
+  const hsize_t numBytes = H5Sget_simple_extent_npoints(memorySpaceId) * H5Tget_size(typeId);
+  buffer.resize(numBytes);
+
+  herr_t error = H5Sselect_hyperslab(sourceSpaceId, H5S_SELECT_SET, sourceOffset.data(), nullptr, count.data(), nullptr);
+  if(error >= 0)
+  {
+    error = H5Sselect_hyperslab(destSpaceId, H5S_SELECT_SET, destOffset.data(), nullptr, count.data(), nullptr);
+  }
+  if(error >= 0)
+  {
+    error = H5Dread(sourceId, typeId, memorySpaceId, sourceSpaceId, H5P_DEFAULT, buffer.data());
+  }
+  if(error >= 0)
+  {
+    error = H5Dwrite(destId, typeId, memorySpaceId, destSpaceId, H5P_DEFAULT, buffer.data());
+    H5SUPPORT_INSTRUMENT_BYTES(error >= 0 ? numBytes : 0)
+  }
+  H5Sclose(destSpaceId);
+  H5Sclose(sourceSpaceId);
+  H5Sclose(memorySpaceId);
+  H5Tclose(typeId);
+  return error;
+}
+
+#ifdef __linux__
+struct AlignedDeleter
+{
+  void operator()(uint8_t* buffer) const
+  {
+    std::free(buffer);
+  }
+};
+using AlignedBuffer = std::unique_ptr<uint8_t, AlignedDeleter>;
+
+/**
+ * @brief Reads numBytes at fileOffset with O_DIRECT. The read goes straight
+ * into the destination when it is suitably aligned and through the scratch
+ * buffer otherwise.
+ */
+bool preadAligned(int fileDescriptor, uint64_t fileOffset, size_t numBytes, uint8_t* destination, size_t alignment, AlignedBuffer& scratch, size_t& scratchSize)
+{
+  const size_t paddedBytes = (numBytes + alignment - 1) / alignment * alignment;
+  const bool readInPlace = (reinterpret_cast<uintptr_t>(destination) % alignment == 0) && (paddedBytes == numBytes);
+  uint8_t* target = destination;
+  if(!readInPlace)
+  {
+    if(scratchSize < paddedBytes)
+    {
+      scratch.reset(static_cast<uint8_t*>(std::aligned_alloc(alignment, paddedBytes)));
+      scratchSize = scratch ? paddedBytes : 0;
+      if(!scratch)
+      {
+        return false;
+      }
+    }
+    target = scratch.get();
+  }
+
+  size_t bytesRead = 0;
+  while(bytesRead < numBytes)
+  {
+    ssize_t count = pread(fileDescriptor, target + bytesRead, paddedBytes - bytesRead, static_cast<off_t>(fileOffset + bytesRead));
+    if(count <= 0)
+    {
+      return false;
+    }
+    bytesRead += static_cast<size_t>(count);
+  }
+
+  if(!readInPlace)
+  {
+    std::memcpy(destination, target, numBytes);
+  }
+  return true;
+}
+
+/**
+ * @brief Copies a chunk read from the file into its position within the
+ * row-major destination buffer, clipping chunks on the dataset's edges.
+ */
+void copyChunk(const uint8_t* chunk, const StorageBlock& block, const std::vector<hsize_t>& chunkDims, const std::vector<hsize_t>& dims, size_t typeSize, uint8_t* destination)
+{
+  const size_t rank = dims.size();
+  std::vector<hsize_t> extent(rank);
+  for(size_t i = 0; i < rank; i++)
+  {
+    extent[i] = std::min(chunkDims[i], dims[i] - block.offset[i]);
+  }
+  const size_t rowBytes = extent[rank - 1] * typeSize;
+
+  std::vector<hsize_t> position(rank, 0);
+  while(true)
+  {
+    size_t chunkIndex = 0;
+    size_t datasetIndex = 0;
+    for(size_t i = 0; i < rank; i++)
+    {
+      chunkIndex = chunkIndex * chunkDims[i] + position[i];
+      datasetIndex = datasetIndex * dims[i] + block.offset[i] + position[i];
+    }
+    std::memcpy(destination + datasetIndex * typeSize, chunk + chunkIndex * typeSize, rowBytes);
+
+    // Advance to the next row of the chunk
+    size_t dim = rank - 1;
+    bool finished = true;
+    while(dim > 0)
+    {
+      dim--;
+      if(++position[dim] < extent[dim])
+      {
+        finished = false;
+        break;
+      }
+      position[dim] = 0;
+    }
+    if(finished)
+    {
+      break;
+    }
+  }
+}
+#endif
+} // namespace
+
 DatasetIO::DatasetIO()
 {
 }
@@ -23,9 +303,18 @@ DatasetIO::DatasetIO(IdType parentId, const std::string& datasetName)
   // open();
 }
 
+DatasetIO::DatasetIO(IdType parentId, const std::string& datasetName, const DatasetOptions& options)
+: ObjectIO(parentId)
+, m_DatasetName(datasetName)
+, m_Options(options)
+{
+}
+
 DatasetIO::DatasetIO(DatasetIO&& other) noexcept
 : ObjectIO(other)
 , m_DatasetName(std::move(other.m_DatasetName))
+, m_Options(other.m_Options)
+, m_Metadata(std::move(other.m_Metadata))
 {
 }
 
@@ -36,8 +325,12 @@ DatasetIO::~DatasetIO()
 
 void DatasetIO::closeHdf5()
 {
-  if(isValid())
+  H5SUPPORT_MUTEX_LOCK()
+
+  invalidateMetadata();
+  if(getId() > 0)
   {
+    H5SUPPORT_INSTRUMENT(Close, getId())
     H5Dclose(getId());
     setId(0);
   }
@@ -48,6 +341,8 @@ DatasetIO& DatasetIO::operator=(DatasetIO&& rhs) noexcept
   setParentId(rhs.getParentId());
   setId(rhs.getId());
   m_DatasetName = std::move(rhs.m_DatasetName);
+  m_Options = rhs.m_Options;
+  m_Metadata = std::move(rhs.m_Metadata);
 
   rhs.clear();
 
@@ -71,6 +366,8 @@ std::string DatasetIO::getName() const
 
 bool DatasetIO::open()
 {
+  H5SUPPORT_MUTEX_LOCK()
+
   if(!isValid())
   {
     return false;
@@ -85,17 +382,21 @@ bool DatasetIO::open()
   }
 #endif
 
-  setId(H5Dopen(getParentId(), getName().c_str(), H5P_DEFAULT));
+  H5SUPPORT_INSTRUMENT(Open, 0)
+  invalidateMetadata();
+  setId(std::max<IdType>(H5Dopen(getParentId(), getName().c_str(), H5P_DEFAULT), 0));
+  H5SUPPORT_INSTRUMENT_OBJECT(getId())
   return getId() > 0;
 }
 
 ErrorType DatasetIO::findAndDeleteAttribute()
 {
-  hsize_t attributeNum = 0;
-  int32_t hasAttribute = H5Aiterate(getParentId(), H5_INDEX_NAME, H5_ITER_INC, &attributeNum, Support::FindAttr, const_cast<char*>(getName().c_str()));
+  H5SUPPORT_MUTEX_LOCK()
+
+  htri_t hasAttribute = H5Aexists(getParentId(), getName().c_str());
 
   /* The attribute already exists, delete it */
-  if(hasAttribute == 1)
+  if(hasAttribute > 0)
   {
     herr_t error = H5Adelete(getParentId(), getName().c_str());
     if(error < 0)
@@ -109,17 +410,26 @@ ErrorType DatasetIO::findAndDeleteAttribute()
 
 void DatasetIO::createOrOpenDataset(IdType typeId, IdType dataspaceId, IdType propertiesId)
 {
+  H5SUPPORT_MUTEX_LOCK()
+
   if(getId() > 0)
   {
     return;
   }
 
+  invalidateMetadata();
   HDF_ERROR_HANDLER_OFF
   setId(H5Dopen(getParentId(), getName().c_str(), H5P_DEFAULT));
   HDF_ERROR_HANDLER_ON
   if(getId() < 0) // dataset does not exist so create it
   {
-    setId(H5Dcreate(getParentId(), getName().c_str(), typeId, dataspaceId, H5P_DEFAULT, propertiesId, H5P_DEFAULT));
+    hid_t creationPropertiesId = m_Options.createCreationProperties(propertiesId);
+    if(creationPropertiesId < 0)
+    {
+      return;
+    }
+    setId(H5Dcreate(getParentId(), getName().c_str(), typeId, dataspaceId, H5P_DEFAULT, creationPropertiesId, H5P_DEFAULT));
+    H5Pclose(creationPropertiesId);
   }
 }
 
@@ -129,26 +439,68 @@ void DatasetIO::createOrOpenDatasetChunk(IdType typeId, IdType dataspaceId, cons
   createOrOpenDataset(typeId, dataspaceId, propertiesId);
 }
 
+ErrorType DatasetIO::setExtent(const DimsType& dims)
+{
+  H5SUPPORT_MUTEX_LOCK()
+
+  if(getId() <= 0)
+  {
+    return -1;
+  }
+
+  invalidateMetadata();
+  return H5Dset_extent(getId(), dims.data());
+}
+
+ErrorType DatasetIO::refresh()
+{
+  H5SUPPORT_MUTEX_LOCK()
+
+  if(getId() <= 0)
+  {
+    return -1;
+  }
+
+  invalidateMetadata();
+  return H5Drefresh(getId());
+}
+
+ErrorType DatasetIO::flush()
+{
+  H5SUPPORT_MUTEX_LOCK()
+
+  if(getId() <= 0)
+  {
+    return -1;
+  }
+
+  return H5Dflush(getId());
+}
+
 IdType DatasetIO::getDataspaceId() const
 {
+  H5SUPPORT_MUTEX_LOCK()
+
   return H5Dget_space(getId());
 }
 
 IdType DatasetIO::getPListId() const
 {
+  H5SUPPORT_MUTEX_LOCK()
+
   return H5Dget_create_plist(getId());
 }
 
 Type DatasetIO::getType() const
 {
-  auto typeId = getTypeId();
-  return getTypeFromId(typeId);
+  auto metadata = getMetadata();
+  return metadata != nullptr ? metadata->type : Type::unknown;
 }
 
 IdType DatasetIO::getClassType() const
 {
-  auto typeId = getTypeId();
-  return H5Tget_class(typeId);
+  auto metadata = getMetadata();
+  return metadata != nullptr ? metadata->classType : H5T_NO_CLASS;
 }
 
 Result<Type> DatasetIO::getDataType() const
@@ -184,13 +536,16 @@ Result<Type> DatasetIO::getDataType() const
 
 IdType DatasetIO::getTypeId() const
 {
+  H5SUPPORT_MUTEX_LOCK()
+
   auto identifier = getId();
   return H5Dget_type(identifier);
 }
 
 size_t DatasetIO::getTypeSize() const
 {
-  return H5Tget_size(getTypeId());
+  auto metadata = getMetadata();
+  return metadata != nullptr ? metadata->typeSize : 0;
 }
 
 size_t DatasetIO::getNumElements() const
@@ -209,6 +564,8 @@ size_t DatasetIO::getNumChunkElements() const
 
 std::string DatasetIO::readAsString() const
 {
+  H5SUPPORT_MUTEX_LOCK()
+
   if(!isValid())
   {
     return "";
@@ -238,6 +595,7 @@ std::string DatasetIO::readAsString() const
   }
   else
   {
+    H5SUPPORT_INSTRUMENT(Read, getId())
     hsize_t size = H5Dget_storage_size(getId());
     std::vector<char> buffer(static_cast<size_t>(size + 1),
                              0x00); // Allocate and Zero and array
@@ -250,6 +608,7 @@ std::string DatasetIO::readAsString() const
     else
     {
       data.append(buffer.data()); // Append the string to the given string
+      H5SUPPORT_INSTRUMENT_BYTES(size)
     }
   }
 
@@ -258,6 +617,8 @@ std::string DatasetIO::readAsString() const
 
 std::vector<std::string> DatasetIO::readAsVectorOfStrings() const
 {
+  H5SUPPORT_MUTEX_LOCK()
+
   if(!isValid())
   {
     return {};
@@ -265,6 +626,7 @@ std::vector<std::string> DatasetIO::readAsVectorOfStrings() const
 
   std::vector<std::string> strings;
 
+  H5SUPPORT_INSTRUMENT(Read, getId())
   hid_t typeID = getTypeId();
   if(typeID >= 0)
   {
@@ -314,6 +676,7 @@ std::vector<std::string> DatasetIO::readAsVectorOfStrings() const
     {
       // printf("%s[%d]: %s\n", "VlenStrings", i, rData[i].p);
       strings[i] = std::string(rData[i]);
+      H5SUPPORT_INSTRUMENT_BYTES(strings[i].size())
     }
     /*
      * Close and release resources.  Note that H5Dvlen_reclaim works
@@ -349,34 +712,43 @@ std::vector<T> DatasetIO::readAsVector() const
 template <class T>
 bool DatasetIO::readIntoSpan(nonstd::span<T>& data) const
 {
+  H5SUPPORT_MUTEX_LOCK()
+
   if(!isValid())
   {
     return false;
   }
 
   hid_t dataType = Support::HdfTypeForPrimitive<T>();
-  if(dataType == -1)
-  {
-    return false;
-  }
 
-  auto spaceId = getDataspaceId();
-  if(spaceId > 0)
+  auto metadata = getMetadata();
+  if(metadata != nullptr)
   {
-    int32_t rank = H5Sget_simple_extent_ndims(spaceId);
-    if(rank > 0)
+    if(metadata->rank > 0)
     {
-      hsize_t numElements = getNumElements();
+      hsize_t numElements = std::accumulate(metadata->dims.cbegin(), metadata->dims.cend(), static_cast<hsize_t>(1), std::multiplies<>());
       if(numElements != data.size())
       {
         return false;
       }
-      herr_t error = H5Dread(getId(), dataType, H5S_ALL, H5S_ALL, H5P_DEFAULT, data.data());
+      // The memory dataspace comes from the checked dimensions, so HDF5 fails
+      // instead of overflowing data if another handle changed the extent
+      hid_t memorySpaceId = H5Screate_simple(metadata->rank, metadata->dims.data(), nullptr);
+      if(memorySpaceId < 0)
+      {
+        return false;
+      }
+      H5SUPPORT_INSTRUMENT(Read, getId())
+      H5SUPPORT_INSTRUMENT_CONVERSION(metadata->type, dataType)
+      herr_t error = H5Dread(getId(), dataType, memorySpaceId, H5S_ALL, H5P_DEFAULT, data.data());
+      H5Sclose(memorySpaceId);
       if(error < 0)
       {
         std::cout << "Error Reading Data.'" << getName() << "'" << std::endl;
         return false;
       }
+      H5SUPPORT_INSTRUMENT_BYTES(data.size() * sizeof(T))
+      H5SUPPORT_INSTRUMENT_CHUNK_CACHE(*this)
     }
   }
   else
@@ -391,22 +763,19 @@ bool DatasetIO::readIntoSpan(nonstd::span<T>& data) const
 template <class T>
 bool DatasetIO::readChunkIntoSpan(nonstd::span<T> data, nonstd::span<const hsize_t> chunkOffset) const
 {
+  H5SUPPORT_MUTEX_LOCK()
+
   if(!isValid())
   {
     return false;
   }
 
   hid_t dataType = Support::HdfTypeForPrimitive<T>();
-  if(dataType == -1)
-  {
-    return false;
-  }
 
-  auto spaceId = getDataspaceId();
-  if(spaceId > 0)
+  auto metadata = getMetadata();
+  if(metadata != nullptr)
   {
-    int32_t rank = H5Sget_simple_extent_ndims(spaceId);
-    if(rank > 0)
+    if(metadata->rank > 0)
     {
       hsize_t numElements = getNumChunkElements();
       if(numElements != data.size())
@@ -416,12 +785,14 @@ bool DatasetIO::readChunkIntoSpan(nonstd::span<T> data, nonstd::span<const hsize
       void* buffer = reinterpret_cast<void*>(data.data());
       const hsize_t* offset = chunkOffset.data();
       uint32_t filterMask;
+      H5SUPPORT_INSTRUMENT(ReadChunk, getId())
       herr_t error = H5Dread_chunk(getId(), H5P_DEFAULT, offset, &filterMask, buffer);
       if(error < 0)
       {
         std::cout << "Error Reading Data.'" << getName() << "'" << std::endl;
         return false;
       }
+      H5SUPPORT_INSTRUMENT_BYTES(data.size() * sizeof(T))
     }
   }
   else
@@ -433,40 +804,220 @@ bool DatasetIO::readChunkIntoSpan(nonstd::span<T> data, nonstd::span<const hsize
   return true;
 }
 
-std::vector<hsize_t> DatasetIO::getDimensions() const
+bool DatasetIO::isAligned(SizeType alignment) const
 {
-  std::vector<hsize_t> dims;
-  auto dataspaceId = getDataspaceId();
-  if(dataspaceId >= 0)
+  if(getId() <= 0 || alignment == 0)
+  {
+    return false;
+  }
+
+  std::vector<hsize_t> chunkDims;
+  std::vector<StorageBlock> blocks;
+  if(!getStorageBlocks(getId(), chunkDims, blocks))
+  {
+    return false;
+  }
+  const hsize_t userBlockSize = getUserBlockSize(getId());
+  return std::all_of(blocks.cbegin(), blocks.cend(), [alignment, userBlockSize](const StorageBlock& block) { return (block.address + userBlockSize) % alignment == 0; });
+}
+
+template <class T>
+bool DatasetIO::readIntoSpanDirect(nonstd::span<T>& data, SizeType alignment) const
+{
+  if(!isValid())
+  {
+    return false;
+  }
+
+  // The lock is released before readDirect so that it can drop it during the
+  // read
+  bool sameType = false;
+  {
+    H5SUPPORT_MUTEX_LOCK()
+
+    hid_t dataType = Support::HdfTypeForPrimitive<T>();
+    hid_t fileTypeId = getTypeId();
+    sameType = H5Tequal(fileTypeId, dataType) > 0;
+    H5Tclose(fileTypeId);
+  }
+
+  if(sameType && getNumElements() == data.size() && readDirect(data.data(), data.size() * sizeof(T), sizeof(T), alignment))
+  {
+    return true;
+  }
+  return readIntoSpan<T>(data);
+}
+
+bool DatasetIO::readDirect(void* buffer, size_t numBytes, size_t typeSize, SizeType alignment) const
+{
+  H5SUPPORT_MUTEX_LOCK()
+
+#ifdef __linux__
+  if(getId() <= 0 || alignment == 0 || numBytes == 0)
   {
-    if(getClassType() == H5T_STRING)
+    return false;
+  }
+
+  // Data still held in the chunk cache or the sieve buffer of a writable
+  // file has to reach the disk before it is read behind HDF5's back
+  hid_t fileId = H5Iget_file_id(getId());
+  unsigned intent = 0;
+  if(H5Fget_intent(fileId, &intent) < 0 || ((intent & H5F_ACC_RDWR) != 0 && H5Dflush(getId()) < 0))
+  {
+    H5Fclose(fileId);
+    return false;
+  }
+
+  std::vector<hsize_t> chunkDims;
+  std::vector<StorageBlock> blocks;
+  if(!getStorageBlocks(getId(), chunkDims, blocks))
+  {
+    H5Fclose(fileId);
+    return false;
+  }
+
+  // File addresses are relative to the end of the user block and only map
+  // directly onto the file on disk for the sec2 and io_uring drivers.
+  hid_t accessPropertiesId = H5Fget_access_plist(fileId);
+  const hid_t driverId = H5Pget_driver(accessPropertiesId);
+  const bool isSec2 = driverId == H5FD_SEC2 || driverId == IoUringDriverId();
+  H5Pclose(accessPropertiesId);
+  const hsize_t userBlockSize = getUserBlockSize(getId());
+  std::string filePath;
+  ssize_t nameLength = H5Fget_name(fileId, nullptr, 0);
+  if(nameLength > 0)
+  {
+    filePath.resize(static_cast<size_t>(nameLength));
+    H5Fget_name(fileId, filePath.data(), filePath.size() + 1);
+  }
+  H5Fclose(fileId);
+
+  if(!isSec2 || filePath.empty())
+  {
+    return false;
+  }
+  for(const auto& block : blocks)
+  {
+    if((block.address + userBlockSize) % alignment != 0)
     {
-      auto typeId = getTypeId();
-      size_t typeSize = H5Tget_size(typeId);
-      dims = {typeSize};
+      return false;
     }
-    else
+  }
+
+  const std::vector<hsize_t> dims = getDimensions();
+
+  // The raw data is read and scattered without touching HDF5
+  H5SUPPORT_INSTRUMENT(Read, getId())
+  H5SUPPORT_MUTEX_UNLOCK()
+  int fileDescriptor = ::open(filePath.c_str(), O_RDONLY | O_DIRECT);
+  if(fileDescriptor < 0)
+  {
+    return false;
+  }
+
+  auto* destination = static_cast<uint8_t*>(buffer);
+  AlignedBuffer scratch;
+  size_t scratchSize = 0;
+  bool success = true;
+  if(chunkDims.empty())
+  {
+    success = blocks[0].size == numBytes && preadAligned(fileDescriptor, blocks[0].address + userBlockSize, numBytes, destination, alignment, scratch, scratchSize);
+  }
+  else
+  {
+    const size_t chunkBytes = std::accumulate(chunkDims.cbegin(), chunkDims.cend(), typeSize, std::multiplies<>());
+    AlignedBuffer chunkBuffer(static_cast<uint8_t*>(std::aligned_alloc(alignment, (chunkBytes + alignment - 1) / alignment * alignment)));
+    success = chunkBuffer != nullptr;
+    for(size_t i = 0; success && i < blocks.size(); i++)
     {
-      size_t rank = H5Sget_simple_extent_ndims(dataspaceId);
-      std::vector<hsize_t> hdims(rank, 0);
-      /* Get dimensions */
-      auto error = H5Sget_simple_extent_dims(dataspaceId, hdims.data(), nullptr);
-      if(error < 0)
+      success = blocks[i].size == chunkBytes && preadAligned(fileDescriptor, blocks[i].address + userBlockSize, chunkBytes, chunkBuffer.get(), alignment, scratch, scratchSize);
+      if(success)
       {
-        std::cout << "Error Getting Attribute dims" << std::endl;
-        return dims;
+        copyChunk(chunkBuffer.get(), blocks[i], chunkDims, dims, typeSize, destination);
       }
-      // Copy the dimensions into the dims vector
-      dims.clear(); // Erase everything in the Vector
-      dims.resize(rank);
-      std::copy(hdims.cbegin(), hdims.cend(), dims.begin());
     }
   }
-  return dims;
+  ::close(fileDescriptor);
+  H5SUPPORT_INSTRUMENT_BYTES(success ? numBytes : 0)
+  return success;
+#else
+  return false;
+#endif
+}
+
+std::vector<hsize_t> DatasetIO::getDimensions() const
+{
+  auto metadata = getMetadata();
+  return metadata != nullptr ? metadata->dims : std::vector<hsize_t>{};
+}
+
+std::shared_ptr<const DatasetIO::Metadata> DatasetIO::getMetadata() const
+{
+  auto metadata = std::atomic_load(&m_Metadata);
+  if(metadata != nullptr || getId() <= 0)
+  {
+    return metadata;
+  }
+
+  H5SUPPORT_MUTEX_LOCK()
+
+  auto loaded = std::make_shared<Metadata>();
+  hid_t typeId = H5Dget_type(getId());
+  hid_t dataspaceId = H5Dget_space(getId());
+  hid_t plistId = H5Dget_create_plist(getId());
+  if(typeId < 0 || dataspaceId < 0 || plistId < 0)
+  {
+    std::cout << "Error Getting Dataset Metadata '" << getName() << "'" << std::endl;
+    loaded = nullptr;
+  }
+  else
+  {
+    loaded->type = getTypeFromId(typeId);
+    loaded->classType = H5Tget_class(typeId);
+    loaded->typeSize = H5Tget_size(typeId);
+    loaded->rank = H5Sget_simple_extent_ndims(dataspaceId);
+    if(loaded->classType == H5T_STRING)
+    {
+      loaded->dims = {loaded->typeSize};
+    }
+    else if(loaded->rank > 0)
+    {
+      loaded->dims.resize(loaded->rank);
+      H5Sget_simple_extent_dims(dataspaceId, loaded->dims.data(), nullptr);
+    }
+    if(H5Pget_layout(plistId) == H5D_CHUNKED)
+    {
+      loaded->chunkDims.resize(std::max(loaded->rank, 1));
+      int32_t chunkRank = H5Pget_chunk(plistId, static_cast<int>(loaded->chunkDims.size()), loaded->chunkDims.data());
+      loaded->chunkDims.resize(std::max(chunkRank, 0));
+    }
+  }
+  if(plistId >= 0)
+  {
+    H5Pclose(plistId);
+  }
+  if(dataspaceId >= 0)
+  {
+    H5Sclose(dataspaceId);
+  }
+  if(typeId >= 0)
+  {
+    H5Tclose(typeId);
+  }
+
+  std::atomic_store(&m_Metadata, std::shared_ptr<const Metadata>(loaded));
+  return loaded;
+}
+
+void DatasetIO::invalidateMetadata()
+{
+  std::atomic_store(&m_Metadata, std::shared_ptr<const Metadata>());
 }
 
 IdType DatasetIO::CreateDatasetChunkProperties(nonstd::span<const hsize_t> dims)
 {
+  H5SUPPORT_MUTEX_LOCK()
+
   auto cparms = H5Pcreate(H5P_DATASET_CREATE);
   auto status = H5Pset_chunk(cparms, dims.size(), dims.data());
   if(status < 0)
@@ -478,32 +1029,26 @@ IdType DatasetIO::CreateDatasetChunkProperties(nonstd::span<const hsize_t> dims)
 
 IdType DatasetIO::CreateTransferChunkProperties(const DimsType& chunkDims)
 {
+  H5SUPPORT_MUTEX_LOCK()
+
   auto cparms = H5Pcreate(H5P_DATASET_XFER);
   return cparms;
 }
 
 std::vector<hsize_t> DatasetIO::getChunkDimensions() const
 {
-  auto plist = getPListId();
-  int32_t ndims = 10;
-  std::vector<hsize_t> dims(ndims);
-  int32_t newSize = H5Pget_chunk(plist, ndims, dims.data());
-
-  dims.resize(newSize);
-  return dims;
+  auto metadata = getMetadata();
+  return metadata != nullptr ? metadata->chunkDims : std::vector<hsize_t>{};
 }
 
 template <typename T>
 ErrorType DatasetIO::writeSpan(const DimsType& dims, nonstd::span<const T> values)
 {
+  H5SUPPORT_MUTEX_LOCK()
+
   herr_t returnError = 0;
   int32_t rank = static_cast<int32_t>(dims.size());
   hid_t dataType = Support::HdfTypeForPrimitive<T>();
-  if(dataType == -1)
-  {
-    std::cout << "dataType was unknown" << std::endl;
-    return -1;
-  }
 
   hid_t dataspaceId = H5Screate_simple(rank, dims.data(), nullptr);
   if(dataspaceId >= 0)
@@ -521,6 +1066,7 @@ ErrorType DatasetIO::writeSpan(const DimsType& dims, nonstd::span<const T> value
       if(getId() >= 0)
       {
         /* Write the attribute data. */
+        H5SUPPORT_INSTRUMENT(Write, getId())
         const void* data = static_cast<const void*>(values.data());
         error = H5Dwrite(getId(), dataType, H5S_ALL, H5S_ALL, H5P_DEFAULT, data);
         if(error < 0)
@@ -528,6 +1074,8 @@ ErrorType DatasetIO::writeSpan(const DimsType& dims, nonstd::span<const T> value
           std::cout << "Error Writing data" << std::endl;
           returnError = error;
         }
+        H5SUPPORT_INSTRUMENT_BYTES(error < 0 ? 0 : values.size() * sizeof(T))
+        H5SUPPORT_INSTRUMENT_CHUNK_CACHE(*this)
       }
       else
       {
@@ -553,14 +1101,11 @@ ErrorType DatasetIO::writeSpan(const DimsType& dims, nonstd::span<const T> value
 template <typename T>
 ErrorType DatasetIO::writeChunk(const DimsType& dims, nonstd::span<const T> values, const DimsType& chunkShape, nonstd::span<const hsize_t> offset)
 {
+  H5SUPPORT_MUTEX_LOCK()
+
   herr_t returnError = 0;
   int32_t rank = static_cast<int32_t>(dims.size());
   hid_t dataType = Support::HdfTypeForPrimitive<T>();
-  if(dataType == -1)
-  {
-    std::cout << "dataType was unknown" << std::endl;
-    return -1;
-  }
 
   hid_t dataspaceId = H5Screate_simple(rank, dims.data(), nullptr);
   if(dataspaceId >= 0)
@@ -586,12 +1131,14 @@ ErrorType DatasetIO::writeChunk(const DimsType& dims, nonstd::span<const T> valu
         const void* data = static_cast<const void*>(values.data());
         size_t size = values.size() * sizeof(T);
         // auto properties = CreateTransferChunkProperties(chunkShape);
+        H5SUPPORT_INSTRUMENT(WriteChunk, getId())
         error = H5Dwrite_chunk(getId(), H5P_DEFAULT, H5P_DEFAULT, offset.data(), size, data);
         if(error < 0)
         {
           std::cout << "Error Writing Attribute" << std::endl;
           returnError = error;
         }
+        H5SUPPORT_INSTRUMENT_BYTES(error < 0 ? 0 : size)
       }
       else
       {
@@ -616,6 +1163,8 @@ ErrorType DatasetIO::writeChunk(const DimsType& dims, nonstd::span<const T> valu
 
 ErrorType DatasetIO::writeString(const std::string& text)
 {
+  H5SUPPORT_MUTEX_LOCK()
+
   if(!isValid())
   {
     return -1;
@@ -645,12 +1194,14 @@ ErrorType DatasetIO::writeString(const std::string& text)
           {
             if(!text.empty())
             {
+              H5SUPPORT_INSTRUMENT(Write, getId())
               error = H5Dwrite(getId(), typeId, H5S_ALL, H5S_ALL, H5P_DEFAULT, text.c_str());
               if(error < 0)
               {
                 std::cout << "Error Writing String Data" << std::endl;
                 returnError = error;
               }
+              H5SUPPORT_INSTRUMENT_BYTES(error < 0 ? 0 : size)
             }
           }
           else
@@ -666,8 +1217,149 @@ ErrorType DatasetIO::writeString(const std::string& text)
   return returnError;
 }
 
+ErrorType DatasetIO::copyChunksFrom(const DatasetIO& source, nonstd::span<const hsize_t> offset)
+{
+  H5SUPPORT_MUTEX_LOCK()
+
+  if(getId() <= 0 || source.getId() <= 0)
+  {
+    return -1;
+  }
+
+  const std::vector<hsize_t> chunkDims = getChunkDimensions();
+  const std::vector<hsize_t> sourceDims = source.getDimensions();
+  const size_t rank = sourceDims.size();
+  if(chunkDims.empty() || chunkDims != source.getChunkDimensions() || getDimensions().size() != rank)
+  {
+    std::cout << "Error Copying Chunks: '" << source.getName() << "' and '" << getName() << "' do not share a chunk layout" << std::endl;
+    return -1;
+  }
+  std::vector<hsize_t> destOffset(rank, 0);
+  if(!offset.empty())
+  {
+    if(offset.size() != rank)
+    {
+      return -1;
+    }
+    std::copy(offset.begin(), offset.end(), destOffset.begin());
+  }
+  for(size_t i = 0; i < rank; i++)
+  {
+    if(destOffset[i] % chunkDims[i] != 0)
+    {
+      std::cout << "Error Copying Chunks: The offset is not on a chunk boundary" << std::endl;
+      return -1;
+    }
+  }
+
+  hid_t typeId = H5Dget_type(getId());
+  hid_t sourceTypeId = H5Dget_type(source.getId());
+  hid_t plistId = H5Dget_create_plist(getId());
+  hid_t sourcePlistId = H5Dget_create_plist(source.getId());
+  const bool compatible = H5Tequal(typeId, sourceTypeId) > 0 && haveSameFilters(plistId, sourcePlistId);
+  H5Pclose(sourcePlistId);
+  H5Pclose(plistId);
+  H5Tclose(sourceTypeId);
+  H5Tclose(typeId);
+  if(!compatible)
+  {
+    std::cout << "Error Copying Chunks: '" << source.getName() << "' and '" << getName() << "' differ in datatype or filters" << std::endl;
+    return -1;
+  }
+
+  const std::vector<hsize_t> dims = getDimensions();
+  DimsType requiredDims(dims.cbegin(), dims.cend());
+  bool extend = false;
+  for(size_t i = 0; i < rank; i++)
+  {
+    if(destOffset[i] + sourceDims[i] > requiredDims[i])
+    {
+      requiredDims[i] = destOffset[i] + sourceDims[i];
+      extend = true;
+    }
+  }
+  if(extend)
+  {
+    herr_t error = setExtent(requiredDims);
+    if(error < 0)
+    {
+      std::cout << "Error Copying Chunks: '" << getName() << "' cannot be extended" << std::endl;
+      return error;
+    }
+  }
+
+  // Visit the source's chunk grid and look each chunk up by coordinate. Chunks
+  // that were never written are skipped so they stay unallocated.
+  std::vector<hsize_t> numChunks(rank, 0);
+  hsize_t totalChunks = 1;
+  for(size_t i = 0; i < rank; i++)
+  {
+    numChunks[i] = (sourceDims[i] + chunkDims[i] - 1) / chunkDims[i];
+    totalChunks *= numChunks[i];
+  }
+  std::vector<hsize_t> chunkOffset(rank, 0);
+  std::vector<hsize_t> chunkDestOffset(rank, 0);
+  std::vector<hsize_t> edgeCount(rank, 0);
+  std::vector<uint8_t> buffer;
+  herr_t returnError = 0;
+  for(hsize_t index = 0; index < totalChunks && returnError >= 0; index++)
+  {
+    hsize_t remainder = index;
+    for(size_t i = rank; i-- > 0;)
+    {
+      chunkOffset[i] = (remainder % numChunks[i]) * chunkDims[i];
+      chunkDestOffset[i] = chunkOffset[i] + destOffset[i];
+      remainder /= numChunks[i];
+    }
+
+    unsigned filterMask = 0;
+    haddr_t address = HADDR_UNDEF;
+    hsize_t numBytes = 0;
+    if(H5Dget_chunk_info_by_coord(source.getId(), chunkOffset.data(), &filterMask, &address, &numBytes) < 0)
+    {
+      returnError = -1;
+      break;
+    }
+    if(address == HADDR_UNDEF || numBytes == 0)
+    {
+      continue;
+    }
+
+    // The padding of a partial edge chunk would overwrite destination
+    // elements past the source's edge, so those chunks are copied element by
+    // element unless the padding falls outside the destination.
+    bool overlapsPadding = false;
+    for(size_t i = 0; i < rank; i++)
+    {
+      edgeCount[i] = std::min(chunkDims[i], sourceDims[i] - chunkOffset[i]);
+      overlapsPadding = overlapsPadding || (edgeCount[i] < chunkDims[i] && destOffset[i] + sourceDims[i] < requiredDims[i]);
+    }
+    if(overlapsPadding)
+    {
+      returnError = copyEdgeChunk(source.getId(), getId(), chunkOffset, chunkDestOffset, edgeCount, buffer);
+      continue;
+    }
+
+    H5SUPPORT_INSTRUMENT(WriteChunk, getId())
+    buffer.resize(numBytes);
+    returnError = H5Dread_chunk(source.getId(), H5P_DEFAULT, chunkOffset.data(), &filterMask, buffer.data());
+    if(returnError >= 0)
+    {
+      returnError = H5Dwrite_chunk(getId(), H5P_DEFAULT, filterMask, chunkDestOffset.data(), numBytes, buffer.data());
+      H5SUPPORT_INSTRUMENT_BYTES(returnError >= 0 ? numBytes : 0)
+    }
+  }
+  if(returnError < 0)
+  {
+    std::cout << "Error Copying Chunks from '" << source.getName() << "' to '" << getName() << "'" << std::endl;
+  }
+  return returnError;
+}
+
 ErrorType DatasetIO::writeVectorOfStrings(std::vector<std::string>& text)
 {
+  H5SUPPORT_MUTEX_LOCK()
+
   if(!isValid())
   {
     return -1;
@@ -689,9 +1381,16 @@ ErrorType DatasetIO::writeVectorOfStrings(std::vector<std::string>& text)
       datatype = H5Tcopy(H5T_C_S1);
       H5Tset_size(datatype, H5T_VARIABLE);
 
-      setId(H5Dcreate(getParentId(), getName().c_str(), datatype, dataspaceID, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT));
+      invalidateMetadata();
+      hid_t creationPropertiesId = m_Options.createCreationProperties();
+      setId(creationPropertiesId < 0 ? creationPropertiesId : H5Dcreate(getParentId(), getName().c_str(), datatype, dataspaceID, H5P_DEFAULT, creationPropertiesId, H5P_DEFAULT));
+      if(creationPropertiesId >= 0)
+      {
+        H5Pclose(creationPropertiesId);
+      }
       if(getId() >= 0)
       {
+        H5SUPPORT_INSTRUMENT(Write, getId())
         // Select the "memory" to be written out - just 1 record.
         hsize_t dataset_offset[] = {0};
         hsize_t dataset_count[] = {1};
@@ -711,6 +1410,7 @@ ErrorType DatasetIO::writeVectorOfStrings(std::vector<std::string>& text)
             std::cout << "Error Writing String Data: " __FILE__ << "(" << __LINE__ << ")" << std::endl;
             returnError = error;
           }
+          H5SUPPORT_INSTRUMENT_BYTES(error < 0 ? 0 : element.size())
         }
       }
       H5Tclose(datatype);
@@ -750,6 +1450,18 @@ template NXH5SUPPORT_EXPORT bool DatasetIO::readIntoSpan<size_t>(nonstd::span<si
 template NXH5SUPPORT_EXPORT bool DatasetIO::readIntoSpan<float>(nonstd::span<float>&) const;
 template NXH5SUPPORT_EXPORT bool DatasetIO::readIntoSpan<double>(nonstd::span<double>&) const;
 
+template NXH5SUPPORT_EXPORT bool DatasetIO::readIntoSpanDirect<int8_t>(nonstd::span<int8_t>&, SizeType) const;
+template NXH5SUPPORT_EXPORT bool DatasetIO::readIntoSpanDirect<int16_t>(nonstd::span<int16_t>&, SizeType) const;
+template NXH5SUPPORT_EXPORT bool DatasetIO::readIntoSpanDirect<int32_t>(nonstd::span<int32_t>&, SizeType) const;
+template NXH5SUPPORT_EXPORT bool DatasetIO::readIntoSpanDirect<int64_t>(nonstd::span<int64_t>&, SizeType) const;
+template NXH5SUPPORT_EXPORT bool DatasetIO::readIntoSpanDirect<uint8_t>(nonstd::span<uint8_t>&, SizeType) const;
+template NXH5SUPPORT_EXPORT bool DatasetIO::readIntoSpanDirect<uint16_t>(nonstd::span<uint16_t>&, SizeType) const;
+template NXH5SUPPORT_EXPORT bool DatasetIO::readIntoSpanDirect<uint32_t>(nonstd::span<uint32_t>&, SizeType) const;
+template NXH5SUPPORT_EXPORT bool DatasetIO::readIntoSpanDirect<uint64_t>(nonstd::span<uint64_t>&, SizeType) const;
+template NXH5SUPPORT_EXPORT bool DatasetIO::readIntoSpanDirect<bool>(nonstd::span<bool>&, SizeType) const;
+template NXH5SUPPORT_EXPORT bool DatasetIO::readIntoSpanDirect<float>(nonstd::span<float>&, SizeType) const;
+template NXH5SUPPORT_EXPORT bool DatasetIO::readIntoSpanDirect<double>(nonstd::span<double>&, SizeType) const;
+
 template NXH5SUPPORT_EXPORT bool DatasetIO::readChunkIntoSpan<int8_t>(nonstd::span<int8_t>, nonstd::span<const hsize_t>) const;
 template NXH5SUPPORT_EXPORT bool DatasetIO::readChunkIntoSpan<int16_t>(nonstd::span<int16_t>, nonstd::span<const hsize_t>) const;
 template NXH5SUPPORT_EXPORT bool DatasetIO::readChunkIntoSpan<int32_t>(nonstd::span<int32_t>, nonstd::span<const hsize_t>) const;
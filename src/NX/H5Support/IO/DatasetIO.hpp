@@ -1,12 +1,14 @@
 #pragma once
 
 #include "NX/H5Support/H5Support.hpp"
+#include "NX/H5Support/IO/DatasetOptions.hpp"
 #include "NX/H5Support/IO/ObjectIO.hpp"
 
 #include "NX/Common/Result.hpp"
 
 #include <nonstd/span.hpp>
 
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -14,10 +16,15 @@ namespace NX::H5Support
 {
 class GroupIO;
 
+template <typename T, size_t Rank>
+class TypedDataset;
+
 class NXH5SUPPORT_EXPORT DatasetIO : public ObjectIO
 {
 public:
   friend class GroupIO;
+  template <typename T, size_t Rank>
+  friend class TypedDataset;
 
   using DimsType = std::vector<SizeType>;
 
@@ -34,6 +41,17 @@ public:
    */
   DatasetIO(IdType parentId, const std::string& dataName);
 
+  /**
+   * @brief Constructs a DatasetIO wrapping a target HDF5 dataset
+   * belonging to the specified parent with the target name. The options are
+   * applied if the dataset is created by this DatasetIO and ignored if it
+   * already exists.
+   * @param parentId
+   * @param dataName
+   * @param options
+   */
+  DatasetIO(IdType parentId, const std::string& dataName, const DatasetOptions& options);
+
   DatasetIO(const DatasetIO& other) = delete;
 
   DatasetIO(DatasetIO&& other) noexcept;
@@ -163,17 +181,43 @@ public:
   template <class T>
   bool readChunkIntoSpan(nonstd::span<T> data, nonstd::span<const hsize_t> offset) const;
 
+  /**
+   * @brief Reads the dataset into the given span using direct I/O (O_DIRECT)
+   * so the read bypasses the operating system's page cache. Direct I/O is used
+   * when the dataset is stored contiguously or in unfiltered chunks that start
+   * on alignment boundaries, the file uses the sec2 driver and no type
+   * conversion is required. Otherwise the dataset is read with readIntoSpan.
+   * The dataset is flushed before a direct read if its file is writable.
+   * Requires the span to be the correct size. Returns false if unable to read.
+   * @tparam T
+   * @param data
+   * @param alignment Block size the storage must be aligned to
+   */
+  template <class T>
+  bool readIntoSpanDirect(nonstd::span<T>& data, SizeType alignment = 4096) const;
+
+  /**
+   * @brief Returns true if the dataset's raw data is stored contiguously or in
+   * unfiltered chunks that all start on alignment boundaries in the file,
+   * counting the user block.
+   * @param alignment
+   * @return bool
+   */
+  bool isAligned(SizeType alignment) const;
+
   /**
    * @brief Returns the current chunk dimensions as a vector.
    *
-   * Returns an empty vector if no chunks could be found.
+   * Returns an empty vector if no chunks could be found. The value is cached
+   * while the dataset stays open.
    * @return std::vector<hsize_t>
    */
   std::vector<hsize_t> getChunkDimensions() const;
 
   /**
    * @brief Returns a vector of the sizes of the dimensions for the dataset
-   * Returns empty vector if unable to read.
+   * Returns empty vector if unable to read. The value is cached until the
+   * dataset is written, resized, refreshed or closed.
    */
   std::vector<hsize_t> getDimensions() const;
 
@@ -199,6 +243,23 @@ public:
    */
   ErrorType writeVectorOfStrings(std::vector<std::string>& text);
 
+  /**
+   * @brief Copies every allocated chunk of the source dataset into this
+   * dataset without decoding it, placing the source's origin at offset.
+   * Both datasets must be open and chunked with the same chunk dimensions,
+   * datatype and filter pipeline, and offset must lie on a chunk boundary.
+   * This dataset is extended if it is too small to hold the copied chunks.
+   * Partial chunks on the source's edge are copied element by element when
+   * their padding would land inside this dataset.
+   * The source may belong to another file, which makes this the fastest way
+   * to merge datasets. Returns the HDF5 error, should one occur.
+   * @param source
+   * @param offset Position of the source's first element. Defaults to the
+   * origin.
+   * @return ErrorType
+   */
+  ErrorType copyChunksFrom(const DatasetIO& source, nonstd::span<const hsize_t> offset = {});
+
   /**
    * @brief Writes a span of values to the dataset. Returns the HDF5 error,
    * should one occur.
@@ -230,6 +291,8 @@ public:
   template <typename T>
   void createOrOpenDataset(const DimsType& dimensions, IdType propertiesId = 0)
   {
+    H5SUPPORT_MUTEX_LOCK()
+
     hid_t dataType = Support::HdfTypeForPrimitive<T>();
     hid_t dataspaceId = H5Screate_simple(dimensions.size(), dimensions.data(), nullptr);
     if(dataspaceId >= 0)
@@ -258,6 +321,70 @@ public:
     createOrOpenDataset<T>(dimensions, properties);
   }
 
+  /**
+   * @brief Opens the dataset or creates a chunked dataset whose dimensions can
+   * later be grown with setExtent(). This is the layout required for appending
+   * data to a file in SWMR write mode.
+   * @tparam T
+   * @param dimensions Initial dimensions
+   * @param chunkDimensions
+   */
+  template <typename T>
+  void createOrOpenExtendibleDataset(const DimsType& dimensions, const DimsType& chunkDimensions)
+  {
+    H5SUPPORT_MUTEX_LOCK()
+
+    hid_t dataType = Support::HdfTypeForPrimitive<T>();
+    DimsType maxDimensions(dimensions.size(), H5S_UNLIMITED);
+    hid_t dataspaceId = H5Screate_simple(dimensions.size(), dimensions.data(), maxDimensions.data());
+    if(dataspaceId >= 0)
+    {
+      herr_t error = findAndDeleteAttribute();
+      if(error < 0)
+      {
+        std::cout << "Error Removing Existing Attribute" << std::endl;
+      }
+      else
+      {
+        auto properties = CreateDatasetChunkProperties(chunkDimensions);
+        createOrOpenDataset(dataType, dataspaceId, properties);
+        if(properties > 0)
+        {
+          H5Pclose(properties);
+        }
+        if(getId() < 0)
+        {
+          std::cout << "Error Creating or Opening Extendible Dataset" << std::endl;
+        }
+      }
+      H5Sclose(dataspaceId);
+    }
+  }
+
+  /**
+   * @brief Changes the dimensions of an open chunked dataset. The dataset must
+   * have been created with maximum dimensions large enough for the new extent.
+   * Returns the HDF5 error, should one occur.
+   * @param dims
+   * @return ErrorType
+   */
+  ErrorType setExtent(const DimsType& dims);
+
+  /**
+   * @brief Refreshes the dataset's metadata from the file so that a SWMR
+   * reader picks up changes such as extended dimensions made by the writer.
+   * Returns the HDF5 error, should one occur.
+   * @return ErrorType
+   */
+  ErrorType refresh();
+
+  /**
+   * @brief Flushes the dataset's buffers to disk so that SWMR readers can see
+   * the newly written data. Returns the HDF5 error, should one occur.
+   * @return ErrorType
+   */
+  ErrorType flush();
+
   DatasetIO& operator=(const DatasetIO& rhs) = delete;
   DatasetIO& operator=(DatasetIO&& rhs) noexcept;
 
@@ -294,7 +421,46 @@ protected:
   static IdType CreateTransferChunkProperties(const DimsType& chunkDims);
 
 private:
+  /**
+   * @brief Dataset properties loaded once by getMetadata() and reused by the
+   * metadata getters and the read methods. The type and chunk dimensions do
+   * not change while the dataset is open, but another handle may change the
+   * dimensions of an extendible dataset, so reads never trust the cached
+   * dimensions to match the file.
+   */
+  struct Metadata
+  {
+    int32_t rank = 0;
+    std::vector<hsize_t> dims;
+    std::vector<hsize_t> chunkDims;
+    Type type = Type::unknown;
+    IdType classType = -1;
+    size_t typeSize = 0;
+  };
+
+  /**
+   * @brief Returns the cached metadata, loading it from the open dataset on
+   * first use. Returns nullptr if the dataset is not open.
+   * @return std::shared_ptr<const Metadata>
+   */
+  std::shared_ptr<const Metadata> getMetadata() const;
+
+  /**
+   * @brief Discards the cached metadata. Called whenever the dataset ID, its
+   * extent or its contents may have changed.
+   */
+  void invalidateMetadata();
+
+  /**
+   * @brief Reads the dataset's raw storage with O_DIRECT into the buffer.
+   * The dataset is flushed first if its file is writable. Returns false
+   * without modifying the buffer if direct I/O cannot be used.
+   */
+  bool readDirect(void* buffer, size_t numBytes, size_t typeSize, SizeType alignment) const;
+
   std::string m_DatasetName;
+  DatasetOptions m_Options;
+  mutable std::shared_ptr<const Metadata> m_Metadata;
 };
 extern template bool DatasetIO::readIntoSpan<bool>(nonstd::span<bool>&) const;
 extern template bool DatasetIO::readIntoSpan<int8_t>(nonstd::span<int8_t>&) const;
@@ -308,6 +474,18 @@ extern template bool DatasetIO::readIntoSpan<uint64_t>(nonstd::span<uint64_t>&)
 extern template bool DatasetIO::readIntoSpan<float>(nonstd::span<float>&) const;
 extern template bool DatasetIO::readIntoSpan<double>(nonstd::span<double>&) const;
 
+extern template bool DatasetIO::readIntoSpanDirect<bool>(nonstd::span<bool>&, SizeType) const;
+extern template bool DatasetIO::readIntoSpanDirect<int8_t>(nonstd::span<int8_t>&, SizeType) const;
+extern template bool DatasetIO::readIntoSpanDirect<int16_t>(nonstd::span<int16_t>&, SizeType) const;
+extern template bool DatasetIO::readIntoSpanDirect<int32_t>(nonstd::span<int32_t>&, SizeType) const;
+extern template bool DatasetIO::readIntoSpanDirect<int64_t>(nonstd::span<int64_t>&, SizeType) const;
+extern template bool DatasetIO::readIntoSpanDirect<uint8_t>(nonstd::span<uint8_t>&, SizeType) const;
+extern template bool DatasetIO::readIntoSpanDirect<uint16_t>(nonstd::span<uint16_t>&, SizeType) const;
+extern template bool DatasetIO::readIntoSpanDirect<uint32_t>(nonstd::span<uint32_t>&, SizeType) const;
+extern template bool DatasetIO::readIntoSpanDirect<uint64_t>(nonstd::span<uint64_t>&, SizeType) const;
+extern template bool DatasetIO::readIntoSpanDirect<float>(nonstd::span<float>&, SizeType) const;
+extern template bool DatasetIO::readIntoSpanDirect<double>(nonstd::span<double>&, SizeType) const;
+
 extern template bool DatasetIO::readChunkIntoSpan<bool>(nonstd::span<bool>, nonstd::span<const hsize_t>) const;
 extern template bool DatasetIO::readChunkIntoSpan<char>(nonstd::span<char>, nonstd::span<const hsize_t>) const;
 extern template bool DatasetIO::readChunkIntoSpan<int8_t>(nonstd::span<int8_t>, nonstd::span<const hsize_t>) const;
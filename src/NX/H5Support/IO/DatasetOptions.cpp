@@ -0,0 +1,38 @@
+#include "DatasetOptions.hpp"
+
+#include "NX/H5Support/H5Support.hpp"
+
+#include <H5Ppublic.h>
+
+#include <iostream>
+
+namespace NX::H5Support
+{
+DatasetOptions DatasetOptions::ManyAttributes()
+{
+  DatasetOptions options;
+  options.attributeMaxCompact = 0;
+  options.attributeMinDense = 0;
+  return options;
+}
+
+IdType DatasetOptions::createCreationProperties(IdType baseProperties) const
+{
+  H5SUPPORT_MUTEX_LOCK()
+
+  hid_t creationPropertiesId = baseProperties > 0 ? H5Pcopy(baseProperties) : H5Pcreate(H5P_DATASET_CREATE);
+  if(creationPropertiesId < 0)
+  {
+    return creationPropertiesId;
+  }
+
+  herr_t error = H5Pset_attr_phase_change(creationPropertiesId, attributeMaxCompact, attributeMinDense);
+  if(error < 0)
+  {
+    std::cout << "Error Setting Attribute Phase Change" << std::endl;
+    H5Pclose(creationPropertiesId);
+    return error;
+  }
+  return creationPropertiesId;
+}
+} // namespace NX::H5Support
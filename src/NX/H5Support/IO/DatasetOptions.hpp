@@ -0,0 +1,51 @@
+#pragma once
+
+#include "NX/H5Support/H5.hpp"
+#include "NX/H5Support/NXH5SUPPORT_EXPORT.hpp"
+
+#include <cstdint>
+
+namespace NX::H5Support
+{
+/**
+ * @brief DatasetOptions describes the HDF5 properties used when creating a
+ * dataset, on top of the layout chosen by the DatasetIO method that creates
+ * it. Default constructed options reproduce the HDF5 defaults. Attribute
+ * storage settings only take effect in datasets using the 1.8 object format,
+ * which is used in files opened with FileOptions::objectFormatV18.
+ */
+struct NXH5SUPPORT_EXPORT DatasetOptions
+{
+  /**
+   * @brief Attribute storage: maximum number of attributes kept in compact
+   * storage within the object header. Adding more attributes moves them into
+   * dense storage, which is indexed by name.
+   */
+  uint32_t attributeMaxCompact = 8;
+
+  /**
+   * @brief Attribute storage: number of attributes below which dense storage
+   * is converted back to compact storage. Must not exceed attributeMaxCompact.
+   */
+  uint32_t attributeMinDense = 6;
+
+  /**
+   * @brief Preset for datasets holding many attributes. Attributes are always
+   * kept in dense storage so that lookups, overwrites and deletions do not scan
+   * the object header.
+   * @return DatasetOptions
+   */
+  static DatasetOptions ManyAttributes();
+
+  /**
+   * @brief Creates an HDF5 dataset creation property list matching the
+   * options. The list starts as a copy of baseProperties, such as the chunked
+   * layout of the dataset, or with the HDF5 defaults if baseProperties is 0. The caller is responsible for closing the returned ID
+   * with H5Pclose. Returns a negative value if the property list could not be
+   * created.
+   * @param baseProperties
+   * @return IdType
+   */
+  IdType createCreationProperties(IdType baseProperties = 0) const;
+};
+} // namespace NX::H5Support
@@ -0,0 +1,473 @@
+#include "FileCatalog.hpp"
+
+#include "NX/H5Support/H5Support.hpp"
+#include "NX/H5Support/IO/FileIO.hpp"
+
+#include <fmt/format.h>
+#include <nlohmann/json.hpp>
+
+#include <H5Apublic.h>
+#include <H5Dpublic.h>
+#include <H5Opublic.h>
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <string_view>
+
+using namespace NX::Common;
+
+namespace NX::H5Support
+{
+NLOHMANN_JSON_SERIALIZE_ENUM(ObjectType, {
+                                             {ObjectType::unknown, "unknown"},
+                                             {ObjectType::group, "group"},
+                                             {ObjectType::dataset, "dataset"},
+                                             {ObjectType::namedDatatype, "namedDatatype"},
+                                         })
+
+NLOHMANN_JSON_SERIALIZE_ENUM(Type, {
+                                       {Type::unknown, "unknown"},
+                                       {Type::int8, "int8"},
+                                       {Type::int16, "int16"},
+                                       {Type::int32, "int32"},
+                                       {Type::int64, "int64"},
+                                       {Type::uint8, "uint8"},
+                                       {Type::uint16, "uint16"},
+                                       {Type::uint32, "uint32"},
+                                       {Type::uint64, "uint64"},
+                                       {Type::float32, "float32"},
+                                       {Type::float64, "float64"},
+                                       {Type::string, "string"},
+                                   })
+
+NLOHMANN_JSON_SERIALIZE_ENUM(FileCatalog::Layout, {
+                                                      {FileCatalog::Layout::Unknown, "unknown"},
+                                                      {FileCatalog::Layout::Compact, "compact"},
+                                                      {FileCatalog::Layout::Contiguous, "contiguous"},
+                                                      {FileCatalog::Layout::Chunked, "chunked"},
+                                                      {FileCatalog::Layout::Virtual, "virtual"},
+                                                  })
+
+namespace
+{
+constexpr int32_t k_IndexVersion = 1;
+constexpr std::streamsize k_ChecksumBlockSize = 64 * 1024;
+
+struct CatalogData
+{
+  FileCatalog::EntryMap* entries = nullptr;
+  bool includeDetails = false;
+};
+
+/**
+ * @brief Identifies the state of a file when its index was written.
+ */
+struct FileKey
+{
+  uint64_t size = 0;
+  int64_t modifiedTime = 0;
+  uint64_t checksum = 0;
+};
+
+/**
+ * @brief Returns the FNV-1a hash of the file's first and last blocks, which
+ * hold the superblock and the most recently allocated metadata.
+ */
+uint64_t checksumFile(const std::filesystem::path& filepath, uint64_t fileSize)
+{
+  std::ifstream file(filepath, std::ios::binary);
+  uint64_t hash = 14695981039346656037ull;
+  std::vector<char> buffer(k_ChecksumBlockSize);
+  auto hashBlock = [&](uint64_t offset) {
+    file.seekg(static_cast<std::streamoff>(offset));
+    file.read(buffer.data(), buffer.size());
+    const std::streamsize count = file.gcount();
+    for(std::streamsize i = 0; i < count; i++)
+    {
+      hash = (hash ^ static_cast<uint8_t>(buffer[i])) * 1099511628211ull;
+    }
+    file.clear();
+  };
+
+  hashBlock(0);
+  if(fileSize > static_cast<uint64_t>(k_ChecksumBlockSize))
+  {
+    hashBlock(std::max<uint64_t>(k_ChecksumBlockSize, fileSize - k_ChecksumBlockSize));
+  }
+  return hash;
+}
+
+bool getFileKey(const std::filesystem::path& filepath, FileKey& key)
+{
+  std::error_code errorCode;
+  key.size = std::filesystem::file_size(filepath, errorCode);
+  if(errorCode)
+  {
+    return false;
+  }
+  key.modifiedTime = static_cast<int64_t>(std::filesystem::last_write_time(filepath, errorCode).time_since_epoch().count());
+  if(errorCode)
+  {
+    return false;
+  }
+  key.checksum = checksumFile(filepath, key.size);
+  return true;
+}
+
+/**
+ * @brief H5Aiterate operator that appends each attribute name to the vector
+ * passed as the operator data.
+ */
+herr_t collectAttributeName(hid_t /*locationId*/, const char* name, const H5A_info_t* /*info*/, void* operatorData)
+{
+  static_cast<std::vector<std::string>*>(operatorData)->emplace_back(name);
+  return 0;
+}
+
+FileCatalog::Layout getLayout(H5D_layout_t layout)
+{
+  switch(layout)
+  {
+  case H5D_COMPACT:
+    return FileCatalog::Layout::Compact;
+  case H5D_CONTIGUOUS:
+    return FileCatalog::Layout::Contiguous;
+  case H5D_CHUNKED:
+    return FileCatalog::Layout::Chunked;
+  case H5D_VIRTUAL:
+    return FileCatalog::Layout::Virtual;
+  default:
+    break;
+  }
+  return FileCatalog::Layout::Unknown;
+}
+
+void readDatasetInfo(hid_t rootId, const char* name, FileCatalog::Entry& entry)
+{
+  hid_t datasetId = H5Dopen(rootId, name, H5P_DEFAULT);
+  if(datasetId < 0)
+  {
+    return;
+  }
+
+  hid_t typeId = H5Dget_type(datasetId);
+  entry.type = H5Tget_class(typeId) == H5T_STRING ? Type::string : getTypeFromId(typeId);
+  H5Tclose(typeId);
+
+  hid_t dataspaceId = H5Dget_space(datasetId);
+  const int rank = H5Sget_simple_extent_ndims(dataspaceId);
+  if(rank > 0)
+  {
+    entry.dims.resize(rank);
+    H5Sget_simple_extent_dims(dataspaceId, entry.dims.data(), nullptr);
+  }
+  H5Sclose(dataspaceId);
+
+  hid_t creationPropertiesId = H5Dget_create_plist(datasetId);
+  entry.layout = getLayout(H5Pget_layout(creationPropertiesId));
+  H5Pclose(creationPropertiesId);
+  H5Dclose(datasetId);
+}
+
+/**
+ * @brief H5Ovisit operator that adds each visited object to the
+ * FileCatalog::EntryMap passed as part of the operator data.
+ */
+herr_t catalogObject(hid_t rootId, const char* name, const H5O_info_t* info, void* operatorData)
+{
+  // The root object itself is visited as "."
+  if(name[0] == '.' && name[1] == '\0')
+  {
+    return 0;
+  }
+
+  auto& data = *static_cast<CatalogData*>(operatorData);
+  FileCatalog::Entry entry;
+  entry.objectType = Support::GetObjectType(info->type);
+  entry.address = info->addr;
+  entry.numAttributes = info->num_attrs;
+  if(data.includeDetails && entry.numAttributes > 0)
+  {
+    entry.attributeNames.reserve(entry.numAttributes);
+    H5Aiterate_by_name(rootId, name, H5_INDEX_NAME, H5_ITER_INC, nullptr, collectAttributeName, &entry.attributeNames, H5P_DEFAULT);
+  }
+  if(data.includeDetails && entry.objectType == ObjectType::dataset)
+  {
+    readDatasetInfo(rootId, name, entry);
+  }
+  data.entries->emplace_hint(data.entries->end(), name, std::move(entry));
+  return 0;
+}
+
+std::string_view trimLeadingSlash(std::string_view path)
+{
+  while(!path.empty() && path.front() == '/')
+  {
+    path.remove_prefix(1);
+  }
+  return path;
+}
+} // namespace
+
+Result<FileCatalog> FileCatalog::Build(const ObjectIO& root, bool includeDetails)
+{
+  H5SUPPORT_MUTEX_LOCK()
+
+  if(!root.isValid())
+  {
+    return MakeErrorResult<FileCatalog>(-320, "Error building HDF5 catalog. The root object is invalid.");
+  }
+
+  FileCatalog catalog;
+  catalog.m_RootId = root.getId();
+  catalog.m_HasDetails = includeDetails;
+  CatalogData data;
+  data.entries = &catalog.m_Entries;
+  data.includeDetails = includeDetails;
+
+  herr_t error = H5Ovisit2(root.getId(), H5_INDEX_NAME, H5_ITER_INC, catalogObject, &data, H5O_INFO_BASIC | H5O_INFO_NUM_ATTRS);
+  if(error < 0)
+  {
+    return MakeErrorResult<FileCatalog>(-321, fmt::format("Error building HDF5 catalog for '{}'. Visiting the objects failed.", root.getObjectPath()));
+  }
+  return {std::move(catalog)};
+}
+
+Result<FileCatalog> FileCatalog::LoadOrBuild(const std::filesystem::path& filepath, bool includeDetails)
+{
+  const std::filesystem::path indexPath = IndexPath(filepath);
+  if(std::filesystem::exists(indexPath))
+  {
+    auto indexResult = ReadIndex(indexPath, filepath);
+    if(indexResult.valid() && (indexResult.value().hasDetails() || !includeDetails))
+    {
+      return indexResult;
+    }
+  }
+
+  auto fileResult = FileIO::Open(filepath, FileIO::Mode::ReadOnly);
+  if(fileResult.invalid())
+  {
+    return MakeErrorResult<FileCatalog>(-326, fmt::format("Error building HDF5 catalog. The file '{}' could not be opened.", filepath.string()));
+  }
+
+  auto catalogResult = Build(fileResult.value(), includeDetails);
+  if(catalogResult.invalid())
+  {
+    return catalogResult;
+  }
+
+  // The file is closed on return
+  catalogResult.value().m_RootId = 0;
+  auto writeResult = catalogResult.value().writeIndex(indexPath, filepath);
+  if(writeResult.invalid())
+  {
+    std::cout << "Error Writing HDF5 Catalog Index '" << indexPath.string() << "'" << std::endl;
+  }
+  return catalogResult;
+}
+
+Result<FileCatalog> FileCatalog::ReadIndex(const std::filesystem::path& indexPath, const std::filesystem::path& filepath)
+{
+  FileKey key;
+  if(!getFileKey(filepath, key))
+  {
+    return MakeErrorResult<FileCatalog>(-322, fmt::format("Error reading HDF5 catalog index. The file '{}' does not exist.", filepath.string()));
+  }
+
+  std::ifstream indexFile(indexPath);
+  nlohmann::json index = nlohmann::json::parse(indexFile, nullptr, false);
+  if(index.is_discarded() || !index.is_object())
+  {
+    return MakeErrorResult<FileCatalog>(-323, fmt::format("Error reading HDF5 catalog index '{}'. The index is missing or malformed.", indexPath.string()));
+  }
+
+  // Every access may throw on a malformed index, which then gets rebuilt
+  try
+  {
+    if(index.value("version", 0) != k_IndexVersion)
+    {
+      return MakeErrorResult<FileCatalog>(-323, fmt::format("Error reading HDF5 catalog index '{}'. The index is missing or malformed.", indexPath.string()));
+    }
+
+    const nlohmann::json& fileKey = index.at("file");
+    if(fileKey.value("size", uint64_t{0}) != key.size || fileKey.value("modifiedTime", int64_t{0}) != key.modifiedTime || fileKey.value("checksum", uint64_t{0}) != key.checksum)
+    {
+      return MakeErrorResult<FileCatalog>(-324, fmt::format("Error reading HDF5 catalog index '{}'. The index is out of date.", indexPath.string()));
+    }
+
+    FileCatalog catalog;
+    catalog.m_HasDetails = index.at("details").get<bool>();
+    for(const auto& item : index.at("entries"))
+    {
+      Entry entry;
+      entry.objectType = item.at("objectType").get<ObjectType>();
+      entry.address = item.at("address").get<haddr_t>();
+      entry.numAttributes = item.at("numAttributes").get<size_t>();
+      if(item.contains("attributes"))
+      {
+        entry.attributeNames = item["attributes"].get<std::vector<std::string>>();
+      }
+      if(entry.objectType == ObjectType::dataset && catalog.m_HasDetails)
+      {
+        entry.type = item.at("type").get<Type>();
+        entry.dims = item.at("dims").get<DatasetIO::DimsType>();
+        entry.layout = item.at("layout").get<Layout>();
+      }
+      catalog.m_Entries.emplace_hint(catalog.m_Entries.end(), item.at("path").get<std::string>(), std::move(entry));
+    }
+    return {std::move(catalog)};
+  } catch(const nlohmann::json::exception& exception)
+  {
+    return MakeErrorResult<FileCatalog>(-323, fmt::format("Error reading HDF5 catalog index '{}'. The index is malformed: {}", indexPath.string(), exception.what()));
+  }
+}
+
+std::filesystem::path FileCatalog::IndexPath(const std::filesystem::path& filepath)
+{
+  std::filesystem::path indexPath = filepath;
+  indexPath += ".catalog.json";
+  return indexPath;
+}
+
+Result<> FileCatalog::writeIndex(const std::filesystem::path& indexPath, const std::filesystem::path& filepath) const
+{
+  FileKey key;
+  if(!getFileKey(filepath, key))
+  {
+    return MakeErrorResult(-322, fmt::format("Error writing HDF5 catalog index. The file '{}' does not exist.", filepath.string()));
+  }
+
+  nlohmann::json entries = nlohmann::json::array();
+  for(const auto& [path, entry] : m_Entries)
+  {
+    nlohmann::json item;
+    item["path"] = path;
+    item["objectType"] = entry.objectType;
+    item["address"] = entry.address;
+    item["numAttributes"] = entry.numAttributes;
+    if(m_HasDetails && !entry.attributeNames.empty())
+    {
+      item["attributes"] = entry.attributeNames;
+    }
+    if(m_HasDetails && entry.objectType == ObjectType::dataset)
+    {
+      item["type"] = entry.type;
+      item["dims"] = entry.dims;
+      item["layout"] = entry.layout;
+    }
+    entries.push_back(std::move(item));
+  }
+
+  nlohmann::json index;
+  index["version"] = k_IndexVersion;
+  index["file"] = {{"size", key.size}, {"modifiedTime", key.modifiedTime}, {"checksum", key.checksum}};
+  index["details"] = m_HasDetails;
+  index["entries"] = std::move(entries);
+
+  // Write to a temporary file first so readers never see a partial index
+  std::filesystem::path temporaryPath = indexPath;
+  temporaryPath += ".tmp";
+  {
+    std::ofstream indexFile(temporaryPath, std::ios::trunc);
+    indexFile << index.dump();
+    if(!indexFile)
+    {
+      return MakeErrorResult(-325, fmt::format("Error writing HDF5 catalog index '{}'.", indexPath.string()));
+    }
+  }
+  std::error_code errorCode;
+  std::filesystem::rename(temporaryPath, indexPath, errorCode);
+  if(errorCode)
+  {
+    std::filesystem::remove(temporaryPath, errorCode);
+    return MakeErrorResult(-325, fmt::format("Error writing HDF5 catalog index '{}'.", indexPath.string()));
+  }
+  return {};
+}
+
+FileCatalog::FileCatalog() = default;
+
+size_t FileCatalog::size() const
+{
+  return m_Entries.size();
+}
+
+const FileCatalog::EntryMap& FileCatalog::getEntries() const
+{
+  return m_Entries;
+}
+
+const FileCatalog::Entry* FileCatalog::find(const std::string& path) const
+{
+  auto iter = m_Entries.find(std::string(trimLeadingSlash(path)));
+  if(iter == m_Entries.end())
+  {
+    return nullptr;
+  }
+  return &iter->second;
+}
+
+std::vector<std::string> FileCatalog::getPathsWithPrefix(const std::string& prefix) const
+{
+  const std::string_view trimmedPrefix = trimLeadingSlash(prefix);
+  std::vector<std::string> paths;
+  for(auto iter = m_Entries.lower_bound(std::string(trimmedPrefix)); iter != m_Entries.end(); ++iter)
+  {
+    if(iter->first.compare(0, trimmedPrefix.size(), trimmedPrefix) != 0)
+    {
+      break;
+    }
+    paths.push_back(iter->first);
+  }
+  return paths;
+}
+
+std::vector<std::string> FileCatalog::getChildPaths(const std::string& groupPath) const
+{
+  std::string prefix(trimLeadingSlash(groupPath));
+  if(!prefix.empty() && prefix.back() != '/')
+  {
+    prefix += '/';
+  }
+
+  std::vector<std::string> paths;
+  auto iter = m_Entries.lower_bound(prefix);
+  while(iter != m_Entries.end() && iter->first.compare(0, prefix.size(), prefix) == 0)
+  {
+    const size_t separator = iter->first.find('/', prefix.size());
+    if(separator == std::string::npos)
+    {
+      paths.push_back(iter->first);
+      ++iter;
+      continue;
+    }
+    // Skips the rest of the child's subtree. Its paths all sort before the
+    // child's path followed by '0', the character after '/'.
+    iter = m_Entries.lower_bound(iter->first.substr(0, separator) + '0');
+  }
+  return paths;
+}
+
+ObjectIO FileCatalog::openObject(const std::string& path) const
+{
+  const Entry* entry = find(path);
+  if(m_RootId <= 0 || entry == nullptr || entry->address == HADDR_UNDEF)
+  {
+    return ObjectIO();
+  }
+
+  return ObjectIO::OpenByAddress(m_RootId, entry->address);
+}
+
+void FileCatalog::setRoot(const ObjectIO& root)
+{
+  m_RootId = root.getId();
+}
+
+bool FileCatalog::hasDetails() const
+{
+  return m_HasDetails;
+}
+} // namespace NX::H5Support
@@ -0,0 +1,179 @@
+#pragma once
+
+#include "NX/H5Support/IO/DatasetIO.hpp"
+#include "NX/H5Support/IO/ObjectIO.hpp"
+#include "NX/H5Support/NXH5SUPPORT_EXPORT.hpp"
+
+#include "NX/Common/Result.hpp"
+
+#include <filesystem>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace NX::H5Support
+{
+/**
+ * @brief FileCatalog is an in-memory table of every object below a root
+ * object, built in a single H5Ovisit pass. Paths are relative to the root
+ * object and do not start with '/'. Lookups and prefix queries do not touch
+ * the file, and objects can be reopened directly by address.
+ *
+ * A catalog can be saved to a JSON sidecar index next to the file and loaded
+ * again without opening the file with HDF5. The index records the file's
+ * size, modification time and a checksum of its first and last blocks, and is
+ * rebuilt by LoadOrBuild once any of them change.
+ *
+ * The catalog does not own the root object. openObject may only be used
+ * while the file is open.
+ */
+class NXH5SUPPORT_EXPORT FileCatalog
+{
+public:
+  /**
+   * @brief Storage layout of a dataset's raw data.
+   */
+  enum class Layout
+  {
+    Compact,    // Raw data stored in the object header
+    Contiguous, // Raw data stored in a single block
+    Chunked,    // Raw data stored in separately allocated chunks
+    Virtual,    // Raw data mapped from other datasets
+    Unknown
+  };
+
+  /**
+   * @brief Describes a single cataloged object. The attribute names, and for
+   * datasets the type, dimensions and layout, are only filled in when details
+   * are requested.
+   */
+  struct Entry
+  {
+    ObjectType objectType = ObjectType::unknown;
+    haddr_t address = HADDR_UNDEF;
+    size_t numAttributes = 0;
+    std::vector<std::string> attributeNames;
+    Type type = Type::unknown;
+    DatasetIO::DimsType dims;
+    Layout layout = Layout::Unknown;
+  };
+
+  using EntryMap = std::map<std::string, Entry>;
+
+  /**
+   * @brief Builds the catalog of every object reachable from the root object.
+   * Objects reachable through several hard links are listed once. Attribute
+   * names and dataset types, dimensions and layouts are included if
+   * includeDetails is true, which requires opening each dataset.
+   * @param root The file or group to catalog
+   * @param includeDetails
+   * @return A standard Result object that wraps the FileCatalog on success.
+   */
+  static Common::Result<FileCatalog> Build(const ObjectIO& root, bool includeDetails = true);
+
+  /**
+   * @brief Returns the catalog of the whole file at the target path. The
+   * catalog is read from the file's sidecar index if the index is up to date.
+   * Otherwise the file is opened read-only, cataloged and the index rewritten.
+   * The returned catalog is not attached to an open file.
+   * @param filepath The HDF5 file to catalog
+   * @param includeDetails
+   * @return A standard Result object that wraps the FileCatalog on success.
+   */
+  static Common::Result<FileCatalog> LoadOrBuild(const std::filesystem::path& filepath, bool includeDetails = true);
+
+  /**
+   * @brief Reads a catalog from the sidecar index at indexPath. Fails if the
+   * index does not describe the current state of the file at filepath.
+   * @param indexPath
+   * @param filepath
+   * @return A standard Result object that wraps the FileCatalog on success.
+   */
+  static Common::Result<FileCatalog> ReadIndex(const std::filesystem::path& indexPath, const std::filesystem::path& filepath);
+
+  /**
+   * @brief Returns the default sidecar index path for the target file.
+   * @param filepath
+   * @return std::filesystem::path
+   */
+  static std::filesystem::path IndexPath(const std::filesystem::path& filepath);
+
+  /**
+   * @brief Constructs an empty FileCatalog.
+   */
+  FileCatalog();
+
+  /**
+   * @brief Returns the number of cataloged objects.
+   * @return size_t
+   */
+  size_t size() const;
+
+  /**
+   * @brief Returns every cataloged object keyed by path.
+   * @return const EntryMap&
+   */
+  const EntryMap& getEntries() const;
+
+  /**
+   * @brief Returns the entry for the specified path. A leading '/' is
+   * ignored. Returns nullptr if no object exists at the path.
+   * @param path
+   * @return const Entry*
+   */
+  const Entry* find(const std::string& path) const;
+
+  /**
+   * @brief Returns the paths starting with the specified prefix in
+   * increasing order. A leading '/' is ignored.
+   * @param prefix
+   * @return std::vector<std::string>
+   */
+  std::vector<std::string> getPathsWithPrefix(const std::string& prefix) const;
+
+  /**
+   * @brief Returns the paths of the direct children of the specified group
+   * in increasing order. An empty path or "/" lists the root's children.
+   * @param groupPath
+   * @return std::vector<std::string>
+   */
+  std::vector<std::string> getChildPaths(const std::string& groupPath) const;
+
+  /**
+   * @brief Opens the object at the specified path by address without
+   * traversing the path. Returns an invalid ObjectIO if no object exists at
+   * the path or the file has been closed.
+   * @param path
+   * @return ObjectIO
+   */
+  ObjectIO openObject(const std::string& path) const;
+
+  /**
+   * @brief Attaches the catalog to the root of an open file so that
+   * openObject can be used with a catalog read from an index.
+   * @param root
+   */
+  void setRoot(const ObjectIO& root);
+
+  /**
+   * @brief Returns true if the catalog includes attribute names and dataset
+   * details.
+   * @return bool
+   */
+  bool hasDetails() const;
+
+  /**
+   * @brief Writes the catalog to a sidecar index at indexPath, keyed by the
+   * current state of the file at filepath.
+   * @param indexPath
+   * @param filepath
+   * @return Result<>
+   */
+  Common::Result<> writeIndex(const std::filesystem::path& indexPath, const std::filesystem::path& filepath) const;
+
+private:
+  IdType m_RootId = 0;
+  bool m_HasDetails = false;
+  EntryMap m_Entries;
+};
+} // namespace NX::H5Support
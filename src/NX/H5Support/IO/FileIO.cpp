@@ -1,22 +1,95 @@
 #include "FileIO.hpp"
 
 #include "NX/H5Support/H5Support.hpp"
+#include "NX/H5Support/Instrumentation.hpp"
 
 #include <fmt/format.h>
 
 #include <H5Apublic.h>
 
+#include <algorithm>
+#include <atomic>
+
 using namespace NX::Common;
 
 namespace NX::H5Support
 {
-Result<FileIO> FileIO::CreateFile(const std::filesystem::path& filepath)
+namespace
+{
+hid_t createOrOpenFile(const std::filesystem::path& filepath, const FileOptions& options)
+{
+  if(options.fileExists(filepath))
+  {
+    return OpenHdf5File(filepath, H5F_ACC_RDONLY, options);
+  }
+  return CreateHdf5File(filepath, H5F_ACC_TRUNC, options);
+}
+
+std::string uniqueInMemoryName()
+{
+  // Files using the core driver without a backing store still need a name
+  // that is unique among the files open in this process.
+  static std::atomic<uint64_t> s_Counter = 0;
+  return fmt::format("NXH5Support_InMemory_{}.h5", s_Counter++);
+}
+} // namespace
+
+Result<FileIO> FileIO::Open(const std::filesystem::path& filepath, Mode mode, const FileOptions& options)
+{
+  const bool fileExists = options.fileExists(filepath);
+  hid_t fileId = -1;
+  switch(mode)
+  {
+  case Mode::ReadOnly:
+    [[fallthrough]];
+  case Mode::ReadWrite: {
+    if(!fileExists)
+    {
+      return MakeErrorResult<FileIO>(-309, fmt::format("Error opening HDF5 file at path '{}'. File does not exist.", filepath.string()));
+    }
+    fileId = OpenHdf5File(filepath, mode == Mode::ReadOnly ? H5F_ACC_RDONLY : H5F_ACC_RDWR, options);
+    break;
+  }
+  case Mode::Create:
+    [[fallthrough]];
+  case Mode::Truncate: {
+    if(mode == Mode::Create && fileExists)
+    {
+      return MakeErrorResult<FileIO>(-310, fmt::format("Error creating HDF5 file at path '{}'. File already exists.", filepath.string()));
+    }
+    try
+    {
+      auto parentPath = filepath.parent_path();
+      if(!parentPath.empty() && !std::filesystem::exists(parentPath) && !std::filesystem::create_directories(parentPath))
+      {
+        return MakeErrorResult<FileIO>(-300, fmt::format("Error creating HDF5 file at path '{}'. "
+                                                         "Parent path could not be created.",
+                                                         filepath.string()));
+      }
+    } catch(std::filesystem::filesystem_error& fsError)
+    {
+      return MakeErrorResult<FileIO>(
+          -300, fmt::format("Error creating Output HDF5 file at path '{}'. Parent path could not be created. C++ error reported was\n'{}'", filepath.string(), fsError.what()));
+    }
+    fileId = CreateHdf5File(filepath, mode == Mode::Create ? H5F_ACC_EXCL : H5F_ACC_TRUNC, options);
+    break;
+  }
+  }
+
+  if(fileId < 0)
+  {
+    return MakeErrorResult<FileIO>(-311, fmt::format("Error opening HDF5 file at path '{}'. HDF5 library threw error.", filepath.string()));
+  }
+  return {FileIO(fileId)};
+}
+
+Result<FileIO> FileIO::CreateFile(const std::filesystem::path& filepath, const FileOptions& options)
 {
   try
   {
-    if(std::filesystem::exists(filepath))
+    if(options.fileExists(filepath))
     {
-      FileIO file(filepath);
+      FileIO file(filepath, options);
       if(!file.isValid())
       {
         return MakeErrorResult<FileIO>(-303, fmt::format("Error opening HDF5 file at path '{}'.", filepath.string()));
@@ -41,7 +114,7 @@ Result<FileIO> FileIO::CreateFile(const std::filesystem::path& filepath)
 
   try
   {
-    FileIO file(filepath);
+    FileIO file(filepath, options);
     if(!file.isValid())
     {
       return MakeErrorResult<FileIO>(-301, fmt::format("Error creating HDF5 file at path '{}'. "
@@ -58,11 +131,11 @@ Result<FileIO> FileIO::CreateFile(const std::filesystem::path& filepath)
   return {}; // Code should not get here. We return everywhere else.
 }
 
-Common::Result<std::shared_ptr<FileIO>> FileIO::CreateSharedFile(const std::filesystem::path& filepath)
+Common::Result<std::shared_ptr<FileIO>> FileIO::CreateSharedFile(const std::filesystem::path& filepath, const FileOptions& options)
 {
-  if(std::filesystem::exists(filepath))
+  if(options.fileExists(filepath))
   {
-    FileIO file(filepath);
+    FileIO file(filepath, options);
     if(!file.isValid())
     {
       return MakeErrorResult<std::shared_ptr<FileIO>>(-303, fmt::format("Error opening HDF5 file at path '{}'.", filepath.string()));
@@ -82,7 +155,7 @@ Common::Result<std::shared_ptr<FileIO>> FileIO::CreateSharedFile(const std::file
 
   try
   {
-    auto file = std::make_shared<FileIO>(filepath);
+    auto file = std::make_shared<FileIO>(filepath, options);
     if(!file->isValid())
     {
       return MakeErrorResult<std::shared_ptr<FileIO>>(-301, fmt::format("Error creating HDF5 file at path '{}'. "
@@ -108,13 +181,114 @@ Result<FileIO> FileIO::WrapHdf5FileId(IdType fileId)
   return {FileIO(fileId)};
 }
 
-hid_t createOrOpenFile(const std::filesystem::path& filepath)
+Result<FileIO> FileIO::CreateSwmrFile(const std::filesystem::path& filepath, const FileOptions& options)
 {
-  if(std::filesystem::exists(filepath))
+  H5SUPPORT_MUTEX_LOCK()
+
+  auto parentPath = filepath.parent_path();
+  try
+  {
+    if(!parentPath.empty() && !std::filesystem::exists(parentPath))
+    {
+      if(!std::filesystem::create_directories(parentPath))
+      {
+        return MakeErrorResult<FileIO>(-300, fmt::format("Error creating HDF5 file at path '{}'. "
+                                                         "Parent path could not be created.",
+                                                         filepath.string()));
+      }
+    }
+  } catch(std::filesystem::filesystem_error& fsError)
+  {
+    return MakeErrorResult<FileIO>(
+        -300, fmt::format("Error creating Output HDF5 file at path '{}'. Parent path could not be created. C++ error reported was\n'{}'", filepath.string(), fsError.what()));
+  }
+
+  hid_t creationPropertiesId = options.createCreationProperties();
+  if(creationPropertiesId < 0)
   {
-    return H5Fopen(filepath.string().c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+    return MakeErrorResult<FileIO>(-304, fmt::format("Error creating SWMR HDF5 file at path '{}'. Invalid file creation options.", filepath.string()));
   }
-  return H5Fcreate(filepath.string().c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
+  hid_t accessPropertiesId = options.createAccessProperties();
+  if(accessPropertiesId < 0)
+  {
+    H5Pclose(creationPropertiesId);
+    return MakeErrorResult<FileIO>(-304, fmt::format("Error creating SWMR HDF5 file at path '{}'. Invalid file access options.", filepath.string()));
+  }
+
+  // SWMR requires the latest file format for the file's metadata structures.
+  H5Pset_libver_bounds(accessPropertiesId, H5F_LIBVER_LATEST, H5F_LIBVER_LATEST);
+  hid_t fileId = H5Fcreate(filepath.string().c_str(), H5F_ACC_TRUNC, creationPropertiesId, accessPropertiesId);
+  H5Pclose(accessPropertiesId);
+  H5Pclose(creationPropertiesId);
+  if(fileId < 0)
+  {
+    return MakeErrorResult<FileIO>(-304, fmt::format("Error creating SWMR HDF5 file at path '{}'.", filepath.string()));
+  }
+  return {FileIO(fileId)};
+}
+
+Result<FileIO> FileIO::OpenSwmrReader(const std::filesystem::path& filepath)
+{
+  H5SUPPORT_MUTEX_LOCK()
+
+  if(!std::filesystem::exists(filepath))
+  {
+    return MakeErrorResult<FileIO>(-303, fmt::format("Error opening HDF5 file at path '{}'. File does not exist.", filepath.string()));
+  }
+
+  hid_t fileId = H5Fopen(filepath.string().c_str(), H5F_ACC_RDONLY | H5F_ACC_SWMR_READ, H5P_DEFAULT);
+  if(fileId < 0)
+  {
+    return MakeErrorResult<FileIO>(-305, fmt::format("Error opening HDF5 file at path '{}' as a SWMR reader.", filepath.string()));
+  }
+  return {FileIO(fileId)};
+}
+
+Result<FileIO> FileIO::CreateInMemory()
+{
+  FileOptions options;
+  options.driver = FileOptions::Driver::Core;
+  options.coreBackingStore = false;
+
+  hid_t fileId = CreateHdf5File(uniqueInMemoryName(), H5F_ACC_TRUNC, options);
+  if(fileId < 0)
+  {
+    return MakeErrorResult<FileIO>(-306, "Error creating in-memory HDF5 file.");
+  }
+  return {FileIO(fileId)};
+}
+
+Result<FileIO> FileIO::OpenFromImage(nonstd::span<const std::byte> image, bool writable)
+{
+  H5SUPPORT_MUTEX_LOCK()
+
+  if(image.empty())
+  {
+    return MakeErrorResult<FileIO>(-307, "Error opening HDF5 file image. The image is empty.");
+  }
+
+  FileOptions options;
+  options.driver = FileOptions::Driver::Core;
+  options.coreBackingStore = false;
+  options.coreIncrement = std::max(options.coreIncrement, image.size());
+
+  hid_t accessPropertiesId = options.createAccessProperties();
+  if(accessPropertiesId < 0)
+  {
+    return MakeErrorResult<FileIO>(-307, "Error opening HDF5 file image. The file access properties could not be created.");
+  }
+
+  hid_t fileId = -1;
+  if(H5Pset_file_image(accessPropertiesId, const_cast<std::byte*>(image.data()), image.size()) >= 0)
+  {
+    fileId = H5Fopen(uniqueInMemoryName().c_str(), writable ? H5F_ACC_RDWR : H5F_ACC_RDONLY, accessPropertiesId);
+  }
+  H5Pclose(accessPropertiesId);
+  if(fileId < 0)
+  {
+    return MakeErrorResult<FileIO>(-308, fmt::format("Error opening HDF5 file image of {} bytes.", image.size()));
+  }
+  return {FileIO(fileId)};
 }
 
 FileIO::FileIO()
@@ -122,8 +296,8 @@ FileIO::FileIO()
 {
 }
 
-FileIO::FileIO(const std::filesystem::path& filepath)
-: GroupIO(0, createOrOpenFile(filepath))
+FileIO::FileIO(const std::filesystem::path& filepath, const FileOptions& options)
+: GroupIO(0, createOrOpenFile(filepath, options))
 {
 }
 
@@ -138,6 +312,7 @@ FileIO::FileIO(FileIO&& rhs) noexcept
   auto rhsId = rhs.getId();
   setId(rhsId);
   rhs.setId(-1);
+  m_DatasetCache.swap(rhs.m_DatasetCache);
 }
 
 FileIO::~FileIO()
@@ -147,8 +322,15 @@ FileIO::~FileIO()
 
 void FileIO::closeHdf5()
 {
+  // Cached datasets are released before taking the HDF5 lock so the lock
+  // order matches DatasetCache::open().
+  m_DatasetCache->clear();
+
+  H5SUPPORT_MUTEX_LOCK()
+
   if(isValid())
   {
+    H5SUPPORT_INSTRUMENT(Close, getId())
     H5Fclose(getId());
     setId(0);
   }
@@ -156,6 +338,8 @@ void FileIO::closeHdf5()
 
 std::string FileIO::getName() const
 {
+  H5SUPPORT_MUTEX_LOCK()
+
   if(!isValid())
   {
     return "";
@@ -167,4 +351,153 @@ std::string FileIO::getName() const
 
   return GetNameFromBuffer(buffer);
 }
+
+ErrorType FileIO::startSwmrWrite()
+{
+  H5SUPPORT_MUTEX_LOCK()
+
+  if(!isValid())
+  {
+    return -1;
+  }
+
+  return H5Fstart_swmr_write(getId());
+}
+
+bool FileIO::isSwmr() const
+{
+  H5SUPPORT_MUTEX_LOCK()
+
+  if(!isValid())
+  {
+    return false;
+  }
+
+  unsigned intent = 0;
+  if(H5Fget_intent(getId(), &intent) < 0)
+  {
+    return false;
+  }
+  return (intent & (H5F_ACC_SWMR_WRITE | H5F_ACC_SWMR_READ)) != 0;
+}
+
+ErrorType FileIO::flush()
+{
+  H5SUPPORT_MUTEX_LOCK()
+
+  if(!isValid())
+  {
+    return -1;
+  }
+
+  return H5Fflush(getId(), H5F_SCOPE_GLOBAL);
+}
+
+std::vector<std::byte> FileIO::toImage() const
+{
+  H5SUPPORT_MUTEX_LOCK()
+
+  if(!isValid())
+  {
+    return {};
+  }
+
+  if(H5Fflush(getId(), H5F_SCOPE_GLOBAL) < 0)
+  {
+    return {};
+  }
+
+  ssize_t imageSize = H5Fget_file_image(getId(), nullptr, 0);
+  if(imageSize <= 0)
+  {
+    return {};
+  }
+
+  std::vector<std::byte> image(static_cast<size_t>(imageSize));
+  if(H5Fget_file_image(getId(), image.data(), image.size()) < 0)
+  {
+    return {};
+  }
+  return image;
+}
+
+ErrorType FileIO::resizeMetadataCache(size_t maxSize, size_t minSize)
+{
+  H5SUPPORT_MUTEX_LOCK()
+
+  if(!isValid() || maxSize == 0 || minSize > maxSize)
+  {
+    return -1;
+  }
+
+  H5AC_cache_config_t config{};
+  config.version = H5AC__CURR_CACHE_CONFIG_VERSION;
+  herr_t error = H5Fget_mdc_config(getId(), &config);
+  if(error < 0)
+  {
+    return error;
+  }
+
+  size_t maxCacheSize = 0;
+  size_t minCleanSize = 0;
+  size_t currentSize = 0;
+  int numEntries = 0;
+  error = H5Fget_mdc_size(getId(), &maxCacheSize, &minCleanSize, &currentSize, &numEntries);
+  if(error < 0)
+  {
+    return error;
+  }
+
+  config.max_size = maxSize;
+  config.min_size = std::min(minSize > 0 ? minSize : config.min_size, maxSize);
+  config.set_initial_size = true;
+  config.initial_size = std::clamp(maxCacheSize, config.min_size, config.max_size);
+  return H5Fset_mdc_config(getId(), &config);
+}
+
+Result<Instrumentation::CacheStats> FileIO::cacheStats() const
+{
+  if(!isValid())
+  {
+    return MakeErrorResult<Instrumentation::CacheStats>(-312, "Cannot read the cache statistics of an invalid file.");
+  }
+  return Instrumentation::ReadCacheStats(getId());
+}
+
+ErrorType FileIO::resetCacheStats()
+{
+  H5SUPPORT_MUTEX_LOCK()
+
+  if(!isValid())
+  {
+    return -1;
+  }
+
+  return H5Freset_mdc_hit_rate_stats(getId());
+}
+
+void FileIO::setDatasetCacheCapacity(size_t capacity)
+{
+  m_DatasetCache->setCapacity(capacity);
+}
+
+size_t FileIO::getDatasetCacheCapacity() const
+{
+  return m_DatasetCache->getCapacity();
+}
+
+std::shared_ptr<DatasetIO> FileIO::openCachedDataset(const std::string& path)
+{
+  if(!isValid())
+  {
+    return nullptr;
+  }
+
+  return m_DatasetCache->open(getId(), path);
+}
+
+void FileIO::clearDatasetCache()
+{
+  m_DatasetCache->clear();
+}
 } // namespace NX::H5Support
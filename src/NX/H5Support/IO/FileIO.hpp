@@ -1,35 +1,68 @@
 #pragma once
 
+#include "NX/H5Support/IO/DatasetCache.hpp"
+#include "NX/H5Support/IO/FileOptions.hpp"
 #include "NX/H5Support/IO/GroupIO.hpp"
+#include "NX/H5Support/Instrumentation.hpp"
 #include "NX/H5Support/NXH5SUPPORT_EXPORT.hpp"
 
 #include "NX/Common/Result.hpp"
 
+#include <nonstd/span.hpp>
+
+#include <cstddef>
 #include <filesystem>
+#include <memory>
 #include <string>
+#include <vector>
 
 namespace NX::H5Support
 {
 class NXH5SUPPORT_EXPORT FileIO : public GroupIO
 {
 public:
+  /**
+   * @brief Describes how FileIO::Open accesses the target file.
+   */
+  enum class Mode
+  {
+    ReadOnly,  // Opens an existing file for reading
+    ReadWrite, // Opens an existing file for reading and in-place updates
+    Create,    // Creates a new file. Fails if the file already exists
+    Truncate   // Creates a new file, discarding any existing file
+  };
+
+  /**
+   * @brief This static method opens or creates the HDF5 file at the target
+   * path according to the requested mode. Parent directories are created for
+   * the Create and Truncate modes.
+   * @param filepath The file path to the HDF5 file
+   * @param mode How the file is accessed
+   * @param options The driver and property options used to access the file.
+   * See FileOptions for presets.
+   * @return A standard Result object that wraps the FileIO object on success.
+   */
+  static Common::Result<FileIO> Open(const std::filesystem::path& filepath, Mode mode = Mode::ReadOnly, const FileOptions& options = {});
+
   /**
    * @brief This static method will ensure that the complete path to the file
    * exists and the file is created.
    * @param filepath The file path to the HDF5 file that should be created
+   * @param options The driver and property options used to access the file
    * @return A standard Result object that wraps a std::unique_ptr<FileWriter>
    * object on success.
    */
-  static Common::Result<FileIO> CreateFile(const std::filesystem::path& filepath);
+  static Common::Result<FileIO> CreateFile(const std::filesystem::path& filepath, const FileOptions& options = {});
 
   /**
    * @brief This static method will ensure that the complete path to the file
    * exists and the file is created.
    * @param filepath The file path to the HDF5 file that should be created
+   * @param options The driver and property options used to access the file
    * @return A standard Result object that wraps a std::unique_ptr<FileWriter>
    * object on success.
    */
-  static Common::Result<std::shared_ptr<FileIO>> CreateSharedFile(const std::filesystem::path& filepath);
+  static Common::Result<std::shared_ptr<FileIO>> CreateSharedFile(const std::filesystem::path& filepath, const FileOptions& options = {});
 
   /**
    * @brief This static method will wrap an existing HDF5 fileId value as long
@@ -41,6 +74,45 @@ public:
    */
   static Common::Result<FileIO> WrapHdf5FileId(IdType fileId);
 
+  /**
+   * @brief This static method will ensure that the complete path to the file
+   * exists and creates (or truncates) an HDF5 file using the latest file
+   * format so that it can be switched into SWMR write mode. Create all
+   * datasets and then call startSwmrWrite() before appending data.
+   * @param filepath The file path to the HDF5 file that should be created
+   * @param options The driver and property options used to create the file.
+   * The library version bounds are always raised to the latest format.
+   * @return A standard Result object that wraps the FileIO object on success.
+   */
+  static Common::Result<FileIO> CreateSwmrFile(const std::filesystem::path& filepath, const FileOptions& options = {});
+
+  /**
+   * @brief This static method opens an existing HDF5 file as a SWMR reader.
+   * The file may be concurrently written by a single SWMR writer. Datasets
+   * opened from this file must call DatasetIO::refresh() to pick up changes
+   * made by the writer.
+   * @param filepath The file path to the HDF5 file that should be opened
+   * @return A standard Result object that wraps the FileIO object on success.
+   */
+  static Common::Result<FileIO> OpenSwmrReader(const std::filesystem::path& filepath);
+
+  /**
+   * @brief This static method creates an empty HDF5 file that only exists in
+   * memory using the core driver. The file can be serialized with toImage().
+   * @return A standard Result object that wraps the FileIO object on success.
+   */
+  static Common::Result<FileIO> CreateInMemory();
+
+  /**
+   * @brief This static method opens an in-memory HDF5 file from a serialized
+   * file image such as the one returned by toImage(). The image is copied so
+   * the provided buffer does not need to outlive the FileIO.
+   * @param image The bytes of a complete HDF5 file
+   * @param writable Opens the in-memory file for writing when true
+   * @return A standard Result object that wraps the FileIO object on success.
+   */
+  static Common::Result<FileIO> OpenFromImage(nonstd::span<const std::byte> image, bool writable = false);
+
   /**
    * @brief Constructs an invalid FileIO.
    */
@@ -51,8 +123,9 @@ public:
    * filepath. The constructed object will be invalid if the HDF5 file cannot
    * be found or openned.
    * @param filepath
+   * @param options
    */
-  FileIO(const std::filesystem::path& filepath);
+  FileIO(const std::filesystem::path& filepath, const FileOptions& options = {});
 
   /**
    * @brief Constructs a FileIO wrapping the target HDF5 file ID. The
@@ -79,10 +152,99 @@ public:
    */
   std::string getName() const override;
 
+  /**
+   * @brief Switches a file created with CreateSwmrFile() into SWMR write
+   * mode. No new objects can be created after this call. Returns the HDF5
+   * error, should one occur.
+   * @return ErrorType
+   */
+  ErrorType startSwmrWrite();
+
+  /**
+   * @brief Returns true if the file is open as either a SWMR writer or a SWMR
+   * reader. Returns false otherwise.
+   * @return bool
+   */
+  bool isSwmr() const;
+
+  /**
+   * @brief Flushes all buffers associated with the file to disk. Returns the
+   * HDF5 error, should one occur.
+   * @return ErrorType
+   */
+  ErrorType flush();
+
+  /**
+   * @brief Changes the bounds of the file's metadata cache at runtime. The
+   * current cache size is clamped into the new bounds. A minSize of 0 keeps the
+   * current lower bound (clamped to maxSize). A minSize larger than maxSize
+   * is rejected. Returns the HDF5 error, should one occur.
+   * @param maxSize
+   * @param minSize
+   * @return ErrorType
+   */
+  ErrorType resizeMetadataCache(size_t maxSize, size_t minSize = 0);
+
+  /**
+   * @brief Returns the file's metadata cache and page buffer statistics.
+   * Returns an error if the file is invalid or HDF5 cannot report them.
+   * @return Result<Instrumentation::CacheStats>
+   */
+  Common::Result<Instrumentation::CacheStats> cacheStats() const;
+
+  /**
+   * @brief Restarts the metadata cache hit rate statistics reported by
+   * cacheStats(). Returns the HDF5 error, should one occur.
+   * @return ErrorType
+   */
+  ErrorType resetCacheStats();
+
+  /**
+   * @brief Flushes the file and returns its serialized bytes. Works for both
+   * in-memory and on-disk files. Returns an empty vector if the file is
+   * invalid or the image could not be retrieved.
+   * @return std::vector<std::byte>
+   */
+  std::vector<std::byte> toImage() const;
+
+  /**
+   * @brief Sets how many datasets openCachedDataset() keeps open. When the
+   * limit is reached the least recently used dataset is released. The default
+   * capacity of 0 disables the cache.
+   * @param capacity
+   */
+  void setDatasetCacheCapacity(size_t capacity);
+
+  /**
+   * @brief Returns how many datasets openCachedDataset() keeps open.
+   * @return size_t
+   */
+  size_t getDatasetCacheCapacity() const;
+
+  /**
+   * @brief Returns a shared, open DatasetIO for the dataset at the path
+   * relative to the file root. Datasets are served from the file's LRU handle
+   * cache when it is enabled, so repeated calls skip H5Dopen and reuse the
+   * dataset's cached metadata. Returns nullptr if the dataset cannot be
+   * opened.
+   * @param path
+   * @return std::shared_ptr<DatasetIO>
+   */
+  std::shared_ptr<DatasetIO> openCachedDataset(const std::string& path);
+
+  /**
+   * @brief Releases every dataset held by the handle cache. Call this after
+   * deleting or replacing a cached dataset.
+   */
+  void clearDatasetCache();
+
 protected:
   /**
    * @brief Closes the HDF5 ID and resets it to 0.
    */
   void closeHdf5() override;
+
+private:
+  std::unique_ptr<DatasetCache> m_DatasetCache = std::make_unique<DatasetCache>();
 };
 } // namespace NX::H5Support
@@ -0,0 +1,361 @@
+#include "FileOptions.hpp"
+
+#include "NX/H5Support/H5Support.hpp"
+#include "NX/H5Support/Instrumentation.hpp"
+
+#include <H5FDcore.h>
+#include <H5FDfamily.h>
+#include <H5FDmulti.h>
+#include <H5FDsec2.h>
+#include <H5FDstdio.h>
+
+#include <fmt/printf.h>
+
+#include <algorithm>
+
+namespace NX::H5Support
+{
+namespace
+{
+constexpr SizeType k_KiB = 1024;
+constexpr SizeType k_MiB = 1024 * k_KiB;
+
+/**
+ * @brief Returns true if the open file was created with the paged file space
+ * strategy, which HDF5 requires before it applies a page buffer.
+ */
+bool usesPagedAggregation(hid_t fileId)
+{
+  hid_t creationPropertiesId = H5Fget_create_plist(fileId);
+  if(creationPropertiesId < 0)
+  {
+    return false;
+  }
+  H5F_fspace_strategy_t strategy = H5F_FSPACE_STRATEGY_FSM_AGGR;
+  hbool_t persist = false;
+  hsize_t threshold = 0;
+  herr_t error = H5Pget_file_space_strategy(creationPropertiesId, &strategy, &persist, &threshold);
+  H5Pclose(creationPropertiesId);
+  return error >= 0 && strategy == H5F_FSPACE_STRATEGY_PAGE;
+}
+} // namespace
+
+FileOptions FileOptions::ReadMostlyLargeChunks()
+{
+  FileOptions options;
+  options.alignmentThreshold = 64 * k_KiB;
+  options.alignment = 4 * k_KiB;
+  options.metadataBlockSize = 64 * k_KiB;
+  options.sieveBufferSize = 4 * k_MiB;
+  options.smallDataBlockSize = 64 * k_KiB;
+  return options;
+}
+
+FileOptions FileOptions::ManySmallObjects()
+{
+  FileOptions options;
+  options.metadataBlockSize = 256 * k_KiB;
+  options.smallDataBlockSize = 256 * k_KiB;
+  options.metadataCacheInitialSize = 16 * k_MiB;
+  options.metadataCacheMaxSize = 128 * k_MiB;
+  options.objectFormatV18 = true;
+  return options;
+}
+
+FileOptions FileOptions::StreamingAppend()
+{
+  FileOptions options;
+  options.alignmentThreshold = 64 * k_KiB;
+  options.alignment = 4 * k_KiB;
+  options.metadataBlockSize = k_MiB;
+  options.sieveBufferSize = k_MiB;
+  options.evictOnClose = true;
+  return options;
+}
+
+FileOptions FileOptions::DirectIO(SizeType blockSize)
+{
+  FileOptions options;
+  options.alignmentThreshold = blockSize;
+  options.alignment = blockSize;
+  options.metadataBlockSize = blockSize;
+  return options;
+}
+
+IdType FileOptions::createAccessProperties() const
+{
+  H5SUPPORT_MUTEX_LOCK()
+
+  hid_t accessPropertiesId = H5Pcreate(H5P_FILE_ACCESS);
+  if(accessPropertiesId < 0)
+  {
+    return accessPropertiesId;
+  }
+
+  herr_t error = 0;
+  switch(driver)
+  {
+  case Driver::Default:
+    break;
+  case Driver::Sec2:
+    error = H5Pset_fapl_sec2(accessPropertiesId);
+    break;
+  case Driver::Core:
+    error = H5Pset_fapl_core(accessPropertiesId, coreIncrement, coreBackingStore);
+    break;
+  case Driver::Family:
+    error = H5Pset_fapl_family(accessPropertiesId, familyMemberSize, H5P_DEFAULT);
+    break;
+  case Driver::Split:
+    error = H5Pset_fapl_split(accessPropertiesId, splitMetadataExtension.c_str(), H5P_DEFAULT, splitRawDataExtension.c_str(), H5P_DEFAULT);
+    break;
+  case Driver::Stdio:
+    error = H5Pset_fapl_stdio(accessPropertiesId);
+    break;
+  case Driver::IoUring:
+    error = SetIoUringDriver(accessPropertiesId, ioUring);
+    break;
+  }
+
+  if(error < 0)
+  {
+    std::cout << "Error Setting File Driver" << std::endl;
+    H5Pclose(accessPropertiesId);
+    return error;
+  }
+
+  if(pageBufferSize > 0)
+  {
+    error = H5Pset_page_buffer_size(accessPropertiesId, pageBufferSize, 0, 0);
+    if(error < 0)
+    {
+      std::cout << "Error Setting Page Buffer Size" << std::endl;
+      H5Pclose(accessPropertiesId);
+      return error;
+    }
+  }
+  if(metadataCacheInitialSize > 0 || metadataCacheMinSize > 0 || metadataCacheMaxSize > 0)
+  {
+    H5AC_cache_config_t config{};
+    config.version = H5AC__CURR_CACHE_CONFIG_VERSION;
+    error = H5Pget_mdc_config(accessPropertiesId, &config);
+    if(error >= 0)
+    {
+      if(metadataCacheMaxSize > 0)
+      {
+        config.max_size = metadataCacheMaxSize;
+      }
+      if(metadataCacheMinSize > 0)
+      {
+        config.min_size = metadataCacheMinSize;
+      }
+      if(metadataCacheInitialSize > 0)
+      {
+        config.initial_size = metadataCacheInitialSize;
+      }
+      // HDF5 defaults are brought within the requested bounds, but sizes that
+      // were requested explicitly and conflict are rejected
+      if(metadataCacheMinSize == 0)
+      {
+        config.min_size = std::min(config.min_size, config.max_size);
+      }
+      if(metadataCacheInitialSize == 0)
+      {
+        config.initial_size = std::clamp(config.initial_size, config.min_size, config.max_size);
+      }
+      if(config.min_size > config.max_size || config.initial_size < config.min_size || config.initial_size > config.max_size)
+      {
+        std::cout << "Error Metadata Cache Sizes Must Satisfy Min <= Initial <= Max" << std::endl;
+        H5Pclose(accessPropertiesId);
+        return -1;
+      }
+      config.set_initial_size = true;
+      error = H5Pset_mdc_config(accessPropertiesId, &config);
+    }
+    if(error < 0)
+    {
+      std::cout << "Error Setting Metadata Cache Configuration" << std::endl;
+      H5Pclose(accessPropertiesId);
+      return error;
+    }
+  }
+
+  if(evictOnClose)
+  {
+    error = H5Pset_evict_on_close(accessPropertiesId, true);
+    if(error < 0)
+    {
+      std::cout << "Error Setting Evict On Close" << std::endl;
+      H5Pclose(accessPropertiesId);
+      return error;
+    }
+  }
+
+  if(metadataReadAttempts > 0)
+  {
+    error = H5Pset_metadata_read_attempts(accessPropertiesId, metadataReadAttempts);
+    if(error < 0)
+    {
+      std::cout << "Error Setting Metadata Read Attempts" << std::endl;
+      H5Pclose(accessPropertiesId);
+      return error;
+    }
+  }
+
+  if(objectFormatV18)
+  {
+    error = H5Pset_libver_bounds(accessPropertiesId, H5F_LIBVER_V18, H5F_LIBVER_LATEST);
+    if(error < 0)
+    {
+      std::cout << "Error Setting Library Version Bounds" << std::endl;
+      H5Pclose(accessPropertiesId);
+      return error;
+    }
+  }
+
+  if(chunkCacheSize > 0 || chunkCacheSlots > 0)
+  {
+    int32_t metadataElements = 0;
+    size_t slots = 0;
+    size_t numBytes = 0;
+    double preemption = 0.0;
+    error = H5Pget_cache(accessPropertiesId, &metadataElements, &slots, &numBytes, &preemption);
+    if(error >= 0)
+    {
+      slots = chunkCacheSlots > 0 ? chunkCacheSlots : slots;
+      numBytes = chunkCacheSize > 0 ? chunkCacheSize : numBytes;
+      error = H5Pset_cache(accessPropertiesId, metadataElements, slots, numBytes, preemption);
+    }
+    if(error < 0)
+    {
+      std::cout << "Error Setting Chunk Cache" << std::endl;
+      H5Pclose(accessPropertiesId);
+      return error;
+    }
+  }
+
+  if(alignment > 1)
+  {
+    error = H5Pset_alignment(accessPropertiesId, alignmentThreshold, alignment);
+  }
+  if(error >= 0 && metadataBlockSize > 0)
+  {
+    error = H5Pset_meta_block_size(accessPropertiesId, metadataBlockSize);
+  }
+  if(error >= 0 && sieveBufferSize > 0)
+  {
+    error = H5Pset_sieve_buf_size(accessPropertiesId, sieveBufferSize);
+  }
+  if(error >= 0 && smallDataBlockSize > 0)
+  {
+    error = H5Pset_small_data_block_size(accessPropertiesId, smallDataBlockSize);
+  }
+  if(error < 0)
+  {
+    std::cout << "Error Setting File Allocation Properties" << std::endl;
+    H5Pclose(accessPropertiesId);
+    return error;
+  }
+  return accessPropertiesId;
+}
+
+IdType FileOptions::createCreationProperties() const
+{
+  H5SUPPORT_MUTEX_LOCK()
+
+  hid_t creationPropertiesId = H5Pcreate(H5P_FILE_CREATE);
+  if(creationPropertiesId < 0)
+  {
+    return creationPropertiesId;
+  }
+
+  if(pagedAggregation)
+  {
+    herr_t error = H5Pset_file_space_strategy(creationPropertiesId, H5F_FSPACE_STRATEGY_PAGE, persistFreeSpace, 1);
+    if(error >= 0)
+    {
+      error = H5Pset_file_space_page_size(creationPropertiesId, pageSize);
+    }
+    if(error < 0)
+    {
+      std::cout << "Error Setting Paged File Space Strategy" << std::endl;
+      H5Pclose(creationPropertiesId);
+      return error;
+    }
+  }
+  return creationPropertiesId;
+}
+
+bool FileOptions::fileExists(const std::filesystem::path& filepath) const
+{
+  switch(driver)
+  {
+  case Driver::Family:
+    return std::filesystem::exists(fmt::sprintf(filepath.string(), 0));
+  case Driver::Split:
+    return std::filesystem::exists(filepath.string() + splitMetadataExtension);
+  default:
+    break;
+  }
+  return std::filesystem::exists(filepath);
+}
+
+IdType OpenHdf5File(const std::filesystem::path& filepath, unsigned flags, const FileOptions& options)
+{
+  H5SUPPORT_MUTEX_LOCK()
+
+  hid_t accessPropertiesId = options.createAccessProperties();
+  if(accessPropertiesId < 0)
+  {
+    return accessPropertiesId;
+  }
+
+  H5SUPPORT_INSTRUMENT(Open, 0)
+  hid_t fileId = -1;
+  if(options.pageBufferSize > 0)
+  {
+    // HDF5 refuses to open files without paged aggregation when a page buffer
+    // is requested. The file is opened without one first and only reopened
+    // with the page buffer if its file space strategy allows it.
+    H5Pset_page_buffer_size(accessPropertiesId, 0, 0, 0);
+    fileId = H5Fopen(filepath.string().c_str(), flags, accessPropertiesId);
+    if(fileId >= 0 && usesPagedAggregation(fileId))
+    {
+      H5Fclose(fileId);
+      H5Pset_page_buffer_size(accessPropertiesId, options.pageBufferSize, 0, 0);
+      fileId = H5Fopen(filepath.string().c_str(), flags, accessPropertiesId);
+    }
+  }
+  else
+  {
+    fileId = H5Fopen(filepath.string().c_str(), flags, accessPropertiesId);
+  }
+  H5Pclose(accessPropertiesId);
+  H5SUPPORT_INSTRUMENT_OBJECT(fileId)
+  return fileId;
+}
+
+IdType CreateHdf5File(const std::filesystem::path& filepath, unsigned flags, const FileOptions& options)
+{
+  H5SUPPORT_MUTEX_LOCK()
+
+  hid_t creationPropertiesId = options.createCreationProperties();
+  if(creationPropertiesId < 0)
+  {
+    return creationPropertiesId;
+  }
+  hid_t accessPropertiesId = options.createAccessProperties();
+  if(accessPropertiesId < 0)
+  {
+    H5Pclose(creationPropertiesId);
+    return accessPropertiesId;
+  }
+
+  H5SUPPORT_INSTRUMENT(Open, 0)
+  hid_t fileId = H5Fcreate(filepath.string().c_str(), flags, creationPropertiesId, accessPropertiesId);
+  H5Pclose(accessPropertiesId);
+  H5Pclose(creationPropertiesId);
+  H5SUPPORT_INSTRUMENT_OBJECT(fileId)
+  return fileId;
+}
+} // namespace NX::H5Support
@@ -0,0 +1,255 @@
+#pragma once
+
+#include "NX/H5Support/Drivers/IoUringDriver.hpp"
+#include "NX/H5Support/H5.hpp"
+#include "NX/H5Support/NXH5SUPPORT_EXPORT.hpp"
+
+#include <filesystem>
+#include <string>
+
+namespace NX::H5Support
+{
+/**
+ * @brief FileOptions describes the HDF5 properties used when opening or
+ * creating a file. Default constructed options reproduce the HDF5 defaults.
+ */
+struct NXH5SUPPORT_EXPORT FileOptions
+{
+  /**
+   * @brief The HDF5 virtual file driver used to perform the file's I/O.
+   */
+  enum class Driver
+  {
+    Default, // HDF5 default driver (sec2 unless overridden by the environment)
+    Sec2,    // Unbuffered POSIX I/O
+    Core,    // File image held in memory with an optional backing store
+    Family,  // File split across members of a fixed size
+    Split,   // Metadata and raw data written to separate files
+    Stdio,   // Buffered C standard library I/O
+    IoUring  // Batched POSIX I/O submitted through io_uring with readahead
+  };
+
+  Driver driver = Driver::Default;
+
+  /**
+   * @brief Core driver: number of bytes the in-memory image grows by.
+   */
+  size_t coreIncrement = 1024 * 1024;
+
+  /**
+   * @brief Core driver: writes the in-memory image to the file path when the
+   * file is closed. Otherwise the file never touches the disk.
+   */
+  bool coreBackingStore = false;
+
+  /**
+   * @brief Family driver: size in bytes of each member file. The file path
+   * must contain a printf style integer pattern such as "data_%d.h5".
+   */
+  SizeType familyMemberSize = 1024ull * 1024ull * 1024ull;
+
+  /**
+   * @brief Split driver: extension appended to the file path for the metadata
+   * file.
+   */
+  std::string splitMetadataExtension = "-m.h5";
+
+  /**
+   * @brief Split driver: extension appended to the file path for the raw data
+   * file.
+   */
+  std::string splitRawDataExtension = "-r.h5";
+
+  /**
+   * @brief IoUring driver: queue depth, segmenting and readahead settings.
+   */
+  IoUringDriverConfig ioUring;
+
+  /**
+   * @brief File creation: allocates file space in fixed size pages so that
+   * metadata and raw data are aggregated into separate pages instead of being
+   * interleaved in small allocations.
+   */
+  bool pagedAggregation = false;
+
+  /**
+   * @brief File creation: page size in bytes used by paged aggregation.
+   */
+  SizeType pageSize = 4096;
+
+  /**
+   * @brief File creation: keeps free-space tracking information in the file
+   * so that space freed in one session can be reused in the next.
+   */
+  bool persistFreeSpace = false;
+
+  /**
+   * @brief File access: size in bytes of the page buffer. Zero disables page
+   * buffering. The size must be a multiple of the file's page size and page
+   * buffering is only applied to files created with paged aggregation.
+   */
+  size_t pageBufferSize = 0;
+
+  /**
+   * @brief File access: initial size in bytes of the metadata cache. Zero keeps
+   * the HDF5 default. The initial, minimum and maximum sizes that are set must
+   * satisfy minimum <= initial <= maximum, otherwise the access properties
+   * cannot be created. HDF5 defaults are adjusted to fit the sizes that are
+   * set.
+   */
+  size_t metadataCacheInitialSize = 0;
+
+  /**
+   * @brief File access: lower bound in bytes for the adaptive metadata cache.
+   * Zero keeps the HDF5 default.
+   */
+  size_t metadataCacheMinSize = 0;
+
+  /**
+   * @brief File access: upper bound in bytes for the adaptive metadata cache.
+   * Zero keeps the HDF5 default.
+   */
+  size_t metadataCacheMaxSize = 0;
+
+  /**
+   * @brief File access: evicts an object's metadata from the cache when the
+   * object is closed. Keeps long-lived file handles from growing the cache
+   * without bound.
+   */
+  bool evictOnClose = false;
+
+  /**
+   * @brief File access: number of attempts made to read checksummed metadata
+   * before failing. Zero keeps the HDF5 default. Mostly useful for SWMR
+   * readers.
+   */
+  unsigned metadataReadAttempts = 0;
+
+  /**
+   * @brief File access: writes new objects with at least the HDF5 1.8 object
+   * format. Required for dense attribute storage (see GroupOptions). Files
+   * written this way cannot be read by HDF5 versions older than 1.8.
+   */
+  bool objectFormatV18 = false;
+
+  /**
+   * @brief File access: objects of at least alignmentThreshold bytes are
+   * placed on alignment byte boundaries. The defaults disable alignment.
+   */
+  SizeType alignmentThreshold = 1;
+  SizeType alignment = 1;
+
+  /**
+   * @brief File access: minimum size in bytes of metadata block allocations.
+   * Zero keeps the HDF5 default.
+   */
+  SizeType metadataBlockSize = 0;
+
+  /**
+   * @brief File access: size in bytes of the sieve buffer used for partial
+   * I/O on contiguous datasets. Zero keeps the HDF5 default.
+   */
+  size_t sieveBufferSize = 0;
+
+  /**
+   * @brief File access: default size in bytes of each chunked dataset's chunk
+   * cache. Zero keeps the HDF5 default of 1 MiB.
+   */
+  size_t chunkCacheSize = 0;
+
+  /**
+   * @brief File access: default number of hash table slots in each chunked
+   * dataset's chunk cache. Should be a prime about 100 times the number of
+   * chunks that fit in the cache. Zero keeps the HDF5 default.
+   */
+  size_t chunkCacheSlots = 0;
+
+  /**
+   * @brief File access: size in bytes of the block reserved for small raw
+   * data allocations. Zero keeps the HDF5 default.
+   */
+  SizeType smallDataBlockSize = 0;
+
+  /**
+   * @brief Preset for files dominated by large chunked datasets that are read
+   * much more often than written. Aligns large objects, uses a large sieve
+   * buffer and groups metadata into large blocks.
+   * @return FileOptions
+   */
+  static FileOptions ReadMostlyLargeChunks();
+
+  /**
+   * @brief Preset for files holding many small groups, datasets and
+   * attributes. Aggregates metadata and small raw data into large blocks,
+   * enlarges the metadata cache and enables the 1.8 object format.
+   * @return FileOptions
+   */
+  static FileOptions ManySmallObjects();
+
+  /**
+   * @brief Preset for files that are continuously appended to. Aligns chunk
+   * allocations, keeps metadata together and evicts closed objects from the
+   * metadata cache so memory use stays bounded.
+   * @return FileOptions
+   */
+  static FileOptions StreamingAppend();
+
+  /**
+   * @brief Preset for files read with DatasetIO::readIntoSpanDirect. Every
+   * object of at least one block is placed on a block boundary so that its
+   * raw data can be read with O_DIRECT.
+   * @param blockSize Alignment in bytes. Should match the device's logical
+   * block size or the page size.
+   * @return FileOptions
+   */
+  static FileOptions DirectIO(SizeType blockSize = 4096);
+
+  /**
+   * @brief Creates an HDF5 file access property list matching the options.
+   * The caller is responsible for closing the returned ID with H5Pclose.
+   * Returns a negative value if the property list could not be created.
+   * @return IdType
+   */
+  IdType createAccessProperties() const;
+
+  /**
+   * @brief Creates an HDF5 file creation property list matching the options.
+   * The caller is responsible for closing the returned ID with H5Pclose.
+   * Returns a negative value if the property list could not be created.
+   * @return IdType
+   */
+  IdType createCreationProperties() const;
+
+  /**
+   * @brief Returns true if the file at the target path exists on disk. The
+   * check accounts for drivers that store the file under a different name,
+   * such as the first member of a family or the split metadata file.
+   * @param filepath
+   * @return bool
+   */
+  bool fileExists(const std::filesystem::path& filepath) const;
+};
+
+/**
+ * @brief Opens an existing HDF5 file using the access properties described
+ * by the options. Files that were not created with paged aggregation are
+ * opened without the page buffer. Returns the HDF5 file ID or a negative value
+ * if the file could not be opened.
+ * @param filepath
+ * @param flags H5F_ACC_* access flags
+ * @param options
+ * @return IdType
+ */
+IdType NXH5SUPPORT_EXPORT OpenHdf5File(const std::filesystem::path& filepath, unsigned flags, const FileOptions& options);
+
+/**
+ * @brief Creates an HDF5 file using the creation and access properties
+ * described by the options. Returns the HDF5 file ID or a negative value if
+ * the file could not be created.
+ * @param filepath
+ * @param flags H5F_ACC_TRUNC or H5F_ACC_EXCL
+ * @param options
+ * @return IdType
+ */
+IdType NXH5SUPPORT_EXPORT CreateHdf5File(const std::filesystem::path& filepath, unsigned flags, const FileOptions& options);
+} // namespace NX::H5Support
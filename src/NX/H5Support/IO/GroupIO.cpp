@@ -1,30 +1,127 @@
 #include "GroupIO.hpp"
 
 #include "NX/H5Support/H5Support.hpp"
+#include "NX/H5Support/Instrumentation.hpp"
 
+#include <H5Dpublic.h>
 #include <H5Gpublic.h>
+#include <H5Lpublic.h>
 #include <H5Opublic.h>
 
+#include <algorithm>
 #include <iostream>
 
 namespace NX::H5Support
 {
-IdType getGroupId(IdType parentId, const std::string& groupName)
+namespace
 {
-  // Check if group exists
+struct ChildIterationData
+{
+  const GroupIO::ChildCallback* callback = nullptr;
+  std::vector<GroupIO::ChildInfo>* children = nullptr;
+  size_t maxCount = 0;
+  bool includeDatasetInfo = false;
+};
+
+void readDatasetInfo(hid_t groupId, const char* name, GroupIO::ChildInfo& child)
+{
+  hid_t datasetId = H5Dopen(groupId, name, H5P_DEFAULT);
+  if(datasetId < 0)
+  {
+    return;
+  }
+
+  hid_t typeId = H5Dget_type(datasetId);
+  child.type = H5Tget_class(typeId) == H5T_STRING ? Type::string : getTypeFromId(typeId);
+  H5Tclose(typeId);
+
+  hid_t dataspaceId = H5Dget_space(datasetId);
+  const int rank = H5Sget_simple_extent_ndims(dataspaceId);
+  if(rank > 0)
+  {
+    child.dims.resize(rank);
+    H5Sget_simple_extent_dims(dataspaceId, child.dims.data(), nullptr);
+  }
+  H5Sclose(dataspaceId);
+  H5Dclose(datasetId);
+}
+
+GroupIO::ChildInfo getChildInfo(hid_t groupId, const char* name, const H5L_info_t* linkInfo, bool includeDatasetInfo)
+{
+  GroupIO::ChildInfo child;
+  child.name = name;
+  if(linkInfo->type == H5L_TYPE_HARD)
+  {
+    child.address = linkInfo->u.address;
+  }
+
+  // Soft and external links may dangle
+  H5O_info_t objectInfo{};
   HDF_ERROR_HANDLER_OFF
-  auto status = H5Gget_objinfo(parentId, groupName.c_str(), 0, NULL);
+  herr_t error = H5Oget_info_by_name2(groupId, name, &objectInfo, H5O_INFO_BASIC, H5P_DEFAULT);
   HDF_ERROR_HANDLER_ON
+  if(error < 0)
+  {
+    return child;
+  }
 
-  if(status == 0) // if group exists...
+  child.objectType = Support::GetObjectType(objectInfo.type);
+  child.address = objectInfo.addr;
+  if(includeDatasetInfo && child.objectType == ObjectType::dataset)
   {
-    return H5Gopen(parentId, groupName.c_str(), H5P_DEFAULT);
+    readDatasetInfo(groupId, name, child);
   }
-  else // if group does not exist...
+  return child;
+}
+
+/**
+ * @brief H5Literate operator that appends each child to the vector passed as
+ * part of the operator data until maxCount children have been collected.
+ */
+herr_t collectChild(hid_t groupId, const char* name, const H5L_info_t* linkInfo, void* operatorData)
+{
+  auto& data = *static_cast<ChildIterationData*>(operatorData);
+  data.children->push_back(getChildInfo(groupId, name, linkInfo, data.includeDatasetInfo));
+  return data.children->size() < data.maxCount ? 0 : 1;
+}
+
+/**
+ * @brief H5Literate operator that passes each child to the callback passed as
+ * part of the operator data.
+ */
+herr_t visitChild(hid_t groupId, const char* name, const H5L_info_t* linkInfo, void* operatorData)
+{
+  auto& data = *static_cast<ChildIterationData*>(operatorData);
+  GroupIO::ChildInfo child = getChildInfo(groupId, name, linkInfo, data.includeDatasetInfo);
+
+  Support::Hdf5CallbackScope callbackScope;
+  return (*data.callback)(child) ? 0 : 1;
+}
+
+IdType getGroupId(IdType parentId, const std::string& groupName, IdType creationPropertiesId = H5P_DEFAULT)
+{
+  H5SUPPORT_MUTEX_LOCK()
+
+  H5SUPPORT_INSTRUMENT(Open, 0)
+  IdType groupId = Support::OpenOrCreateGroup(parentId, groupName, creationPropertiesId);
+  H5SUPPORT_INSTRUMENT_OBJECT(groupId)
+  return groupId;
+}
+
+IdType getGroupId(IdType parentId, const std::string& groupName, const GroupOptions& options)
+{
+  H5SUPPORT_MUTEX_LOCK()
+
+  hid_t creationPropertiesId = options.createCreationProperties();
+  if(creationPropertiesId < 0)
   {
-    return H5Gcreate(parentId, groupName.c_str(), H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+    return creationPropertiesId;
   }
+  IdType groupId = getGroupId(parentId, groupName, creationPropertiesId);
+  H5Pclose(creationPropertiesId);
+  return groupId;
 }
+} // namespace
 
 GroupIO::GroupIO() = default;
 
@@ -33,6 +130,11 @@ GroupIO::GroupIO(IdType parentId, const std::string& groupName)
 {
 }
 
+GroupIO::GroupIO(IdType parentId, const std::string& groupName, const GroupOptions& options)
+: ObjectIO(parentId, getGroupId(parentId, groupName, options))
+{
+}
+
 GroupIO::GroupIO(IdType parentId, IdType objectId)
 : ObjectIO(parentId, objectId)
 {
@@ -45,8 +147,11 @@ GroupIO::~GroupIO()
 
 void GroupIO::closeHdf5()
 {
+  H5SUPPORT_MUTEX_LOCK()
+
   if(isValid())
   {
+    H5SUPPORT_INSTRUMENT(Close, getId())
     H5Gclose(getId());
     setId(0);
   }
@@ -104,51 +209,118 @@ ObjectIO GroupIO::openObject(const std::string& name) const
 
 size_t GroupIO::getNumChildren() const
 {
+  H5SUPPORT_MUTEX_LOCK()
+
   if(!isValid())
   {
     return 0;
   }
 
-  SizeType numChildren;
-  auto err = H5Gget_num_objs(getId(), &numChildren);
+  H5G_info_t groupInfo{};
+  auto err = H5Gget_info(getId(), &groupInfo);
   if(err < 0)
   {
     return 0;
   }
-  return numChildren;
+  return groupInfo.nlinks;
 }
 
 std::vector<std::string> GroupIO::getChildNames() const
 {
+  H5SUPPORT_MUTEX_LOCK()
+
   std::vector<std::string> childNames;
   if(!isValid())
   {
     return childNames;
   }
 
-  constexpr size_t size = 1024;
-  char buffer[size];
+  auto collectName = [](hid_t /*groupId*/, const char* name, const H5L_info_t* /*linkInfo*/, void* operatorData) -> herr_t {
+    static_cast<std::vector<std::string>*>(operatorData)->emplace_back(name);
+    return 0;
+  };
 
-  const size_t numChildren = getNumChildren();
-  for(size_t i = 0; i < numChildren; i++)
+  H5SUPPORT_INSTRUMENT(Query, getId())
+  childNames.reserve(getNumChildren());
+  if(H5Literate(getId(), H5_INDEX_NAME, H5_ITER_INC, nullptr, collectName, &childNames) < 0)
   {
-    auto err = H5Gget_objname_by_idx(getId(), i, buffer, size);
-    if(err >= 0)
-    {
-      childNames.push_back(GetNameFromBuffer(buffer));
-    }
+    std::cout << "Error Iterating Group Links" << std::endl;
   }
 
   return childNames;
 }
 
+std::vector<GroupIO::ChildInfo> GroupIO::listChildren(bool includeDatasetInfo) const
+{
+  SizeType position = 0;
+  return listChildren(position, getNumChildren(), includeDatasetInfo);
+}
+
+std::vector<GroupIO::ChildInfo> GroupIO::listChildren(SizeType& position, size_t count, bool includeDatasetInfo) const
+{
+  H5SUPPORT_MUTEX_LOCK()
+
+  std::vector<ChildInfo> children;
+  if(!isValid() || count == 0)
+  {
+    return children;
+  }
+
+  H5SUPPORT_INSTRUMENT(Query, getId())
+  const SizeType numChildren = getNumChildren();
+  if(position >= numChildren)
+  {
+    position = numChildren;
+    return children;
+  }
+
+  children.reserve(std::min<SizeType>(count, numChildren - position));
+  ChildIterationData data;
+  data.children = &children;
+  data.maxCount = count;
+  data.includeDatasetInfo = includeDatasetInfo;
+
+  hsize_t index = position;
+  if(H5Literate(getId(), H5_INDEX_NAME, H5_ITER_INC, &index, collectChild, &data) < 0)
+  {
+    std::cout << "Error Iterating Group Links" << std::endl;
+  }
+  position = index;
+  return children;
+}
+
+ErrorType GroupIO::forEachChild(const ChildCallback& callback, bool includeDatasetInfo) const
+{
+  H5SUPPORT_MUTEX_LOCK()
+
+  if(!isValid())
+  {
+    return -1;
+  }
+
+  ChildIterationData data;
+  data.callback = &callback;
+  data.includeDatasetInfo = includeDatasetInfo;
+
+  herr_t error = H5Literate(getId(), H5_INDEX_NAME, H5_ITER_NATIVE, nullptr, visitChild, &data);
+  if(error < 0)
+  {
+    std::cout << "Error Iterating Group Links" << std::endl;
+    return error;
+  }
+  return 0;
+}
+
 bool GroupIO::isGroup(const std::string& childName) const
 {
+  H5SUPPORT_MUTEX_LOCK()
+
   if(!isValid())
   {
     return false;
   }
 
+  H5SUPPORT_INSTRUMENT(Query, getId())
   bool isGroup = true;
   H5O_info_t objectInfo{};
   auto error = H5Oget_info_by_name(getId(), childName.c_str(), &objectInfo, H5P_DEFAULT);
@@ -176,11 +348,14 @@ bool GroupIO::isGroup(const std::string& childName) const
 
 bool GroupIO::isDataset(const std::string& childName) const
 {
+  H5SUPPORT_MUTEX_LOCK()
+
   if(!isValid())
   {
     return false;
   }
 
+  H5SUPPORT_INSTRUMENT(Query, getId())
   bool isDataset = true;
   H5O_info_t objectInfo{};
   auto error = H5Oget_info_by_name(getId(), childName.c_str(), &objectInfo, H5P_DEFAULT);
@@ -216,6 +391,31 @@ GroupIO GroupIO::createGroup(const std::string& childName)
   return GroupIO(getId(), childName);
 }
 
+GroupIO GroupIO::openOrCreatePath(const std::string& path, const GroupOptions& options)
+{
+  if(!isValid())
+  {
+    return GroupIO();
+  }
+
+  return GroupIO(getId(), path, options);
+}
+
+GroupIO GroupIO::createGroup(const std::string& childName, const GroupOptions& options)
+{
+  if(!isValid())
+  {
+    return GroupIO();
+  }
+
+  return GroupIO(getId(), childName, options);
+}
+
+GroupIO GroupIO::createGroupForEntries(const std::string& childName, size_t estimatedNumEntries)
+{
+  return createGroup(childName, GroupOptions::ForEstimatedEntries(estimatedNumEntries));
+}
+
 std::shared_ptr<GroupIO> GroupIO::createGroupPtr(const std::string& childName)
 {
   if(!isValid())
@@ -226,6 +426,16 @@ std::shared_ptr<GroupIO> GroupIO::createGroupPtr(const std::string& childName)
   return std::make_shared<GroupIO>(getId(), childName);
 }
 
+std::shared_ptr<GroupIO> GroupIO::createGroupPtr(const std::string& childName, const GroupOptions& options)
+{
+  if(!isValid())
+  {
+    return nullptr;
+  }
+
+  return std::make_shared<GroupIO>(getId(), childName, options);
+}
+
 DatasetIO GroupIO::openDataset(const std::string& childName)
 {
   if(!isValid())
@@ -257,6 +467,16 @@ DatasetIO GroupIO::createDataset(const std::string& childName)
   return std::move(dataset);
 }
 
+DatasetIO GroupIO::createDataset(const std::string& childName, const DatasetOptions& options)
+{
+  if(!isValid())
+  {
+    return DatasetIO();
+  }
+
+  return DatasetIO(getId(), childName, options);
+}
+
 std::shared_ptr<DatasetIO> GroupIO::createDatasetPtr(const std::string& childName)
 {
   if(!isValid())
@@ -269,6 +489,8 @@ std::shared_ptr<DatasetIO> GroupIO::createDatasetPtr(const std::string& childNam
 
 ErrorType GroupIO::createLink(const std::string& objectPath)
 {
+  H5SUPPORT_MUTEX_LOCK()
+
   if(objectPath.empty())
   {
     return -1;
@@ -284,5 +506,36 @@ ErrorType GroupIO::createLink(const std::string& objectPath)
   return errorCode;
 }
 
+ErrorType GroupIO::copyFrom(const ObjectIO& source, const std::string& destName, const CopyOptions& options)
+{
+  H5SUPPORT_MUTEX_LOCK()
+
+  if(!isValid() || source.getId() <= 0 || destName.empty())
+  {
+    return -1;
+  }
+
+  hid_t copyPropertiesId = options.createCopyProperties();
+  if(copyPropertiesId < 0)
+  {
+    return copyPropertiesId;
+  }
+  hid_t linkPropertiesId = options.createLinkProperties();
+  if(linkPropertiesId < 0)
+  {
+    H5Pclose(copyPropertiesId);
+    return linkPropertiesId;
+  }
+
+  herr_t error = H5Ocopy(source.getId(), ".", getId(), destName.c_str(), copyPropertiesId, linkPropertiesId);
+  if(error < 0)
+  {
+    std::cout << "Error Copying Object '" << source.getObjectPath() << "' to '" << destName << "'" << std::endl;
+  }
+  H5Pclose(linkPropertiesId);
+  H5Pclose(copyPropertiesId);
+  return error;
+}
+
 // -----------------------------------------------------------------------------
 } // namespace NX::H5Support
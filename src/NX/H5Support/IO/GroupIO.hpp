@@ -1,14 +1,37 @@
 #pragma once
 
+#include "NX/H5Support/IO/CopyOptions.hpp"
 #include "NX/H5Support/IO/DatasetIO.hpp"
+#include "NX/H5Support/IO/GroupOptions.hpp"
 
+#include <functional>
 #include <string>
+#include <vector>
 
 namespace NX::H5Support
 {
 class NXH5SUPPORT_EXPORT GroupIO : public ObjectIO
 {
 public:
+  /**
+   * @brief Describes a child object of a group. The type and dimensions are
+   * only filled in for datasets, and only when requested.
+   */
+  struct ChildInfo
+  {
+    std::string name;
+    ObjectType objectType = ObjectType::unknown;
+    haddr_t address = HADDR_UNDEF;
+    Type type = Type::unknown;
+    DatasetIO::DimsType dims;
+  };
+
+  /**
+   * @brief Called for each child visited by forEachChild. Returning false
+   * stops the iteration.
+   */
+  using ChildCallback = std::function<bool(const ChildInfo&)>;
+
   /**
    * @brief Constructs an invalid GroupIO.
    */
@@ -21,6 +44,15 @@ public:
    */
   GroupIO(IdType parentId, const std::string& groupName);
 
+  /**
+   * @brief Opens and wraps an HDF5 group found within the specified parent.
+   * If the group does not exist, it is created using the specified options.
+   * @param parentId
+   * @param groupName
+   * @param options
+   */
+  GroupIO(IdType parentId, const std::string& groupName, const GroupOptions& options);
+
   /**
    * @brief Releases the wrapped HDF5 group.
    */
@@ -66,8 +98,45 @@ public:
    */
   GroupIO createGroup(const std::string& childName);
 
+  /**
+   * @brief Creates a GroupIO for writing to a child group with the
+   * target name using the specified creation options. The options are ignored
+   * if the group already exists. Returns an invalid GroupIO if the group
+   * cannot be created.
+   * @param childName
+   * @param options
+   * @return GroupIO
+   */
+  GroupIO createGroup(const std::string& childName, const GroupOptions& options);
+
+  /**
+   * @brief Creates a GroupIO for writing to a child group expected to hold
+   * estimatedNumEntries links. Groups above GroupOptions::k_LargeGroupThreshold
+   * are created with GroupOptions::LargeGroup() so that insertion and lookup
+   * stay fast as the group grows. The estimate is ignored if the group already
+   * exists. Returns an invalid GroupIO if the group cannot be created.
+   * @param childName
+   * @param estimatedNumEntries
+   * @return GroupIO
+   */
+  GroupIO createGroupForEntries(const std::string& childName, size_t estimatedNumEntries);
+
   std::shared_ptr<GroupIO> createGroupPtr(const std::string& childName);
 
+  /**
+   * @brief Opens the group at the target path relative to this group,
+   * creating it together with any missing intermediate groups in a single
+   * call. The options only apply to the final group, and only if it is
+   * created. Returns an invalid GroupIO if the group cannot be opened or
+   * created.
+   * @param path Path such as "a/b/c"
+   * @param options
+   * @return GroupIO
+   */
+  GroupIO openOrCreatePath(const std::string& path, const GroupOptions& options = {});
+
+  std::shared_ptr<GroupIO> createGroupPtr(const std::string& childName, const GroupOptions& options);
+
   /**
    * @brief Opens a DatasetIO for writing to a child group with the
    * target name. Returns an invalid DatasetIO if the dataset cannot be
@@ -88,6 +157,17 @@ public:
    */
   DatasetIO createDataset(const std::string& childName);
 
+  /**
+   * @brief Creates a DatasetIO for writing to a child group with the
+   * target name using the specified creation options. The options are ignored
+   * if the dataset already exists. Returns an invalid DatasetIO if the dataset
+   * cannot be created.
+   * @param childName
+   * @param options
+   * @return DatasetIO
+   */
+  DatasetIO createDataset(const std::string& childName, const DatasetOptions& options);
+
   std::shared_ptr<DatasetIO> createDatasetPtr(const std::string& childName);
 
   /**
@@ -99,6 +179,21 @@ public:
    */
   ErrorType createLink(const std::string& objectPath);
 
+  /**
+   * @brief Copies the source object into this group under destName with
+   * H5Ocopy. Groups are copied with their complete subtree and attributes
+   * unless the options say otherwise. The source may belong to another file.
+   * Raw data is moved without being decoded unless a datatype conversion is
+   * required. To add chunks to an existing dataset instead, see
+   * DatasetIO::copyChunksFrom.
+   * Returns an error code if one occurs. Otherwise, this method returns 0.
+   * @param source Open group or dataset to copy
+   * @param destName Path of the copy relative to this group
+   * @param options
+   * @return ErrorType
+   */
+  ErrorType copyFrom(const ObjectIO& source, const std::string& destName, const CopyOptions& options = {});
+
   /**
    * @brief Returns the number of children objects within the group.
    *
@@ -115,6 +210,43 @@ public:
    */
   std::vector<std::string> getChildNames() const;
 
+  /**
+   * @brief Returns the name, object type and address of each child object in
+   * increasing name order, collected in a single pass over the group's links.
+   * Dataset types and dimensions are included if includeDatasetInfo is true.
+   *
+   * This will return an empty vector if the GroupIO is invalid.
+   * @param includeDatasetInfo
+   * @return std::vector<ChildInfo>
+   */
+  std::vector<ChildInfo> listChildren(bool includeDatasetInfo = false) const;
+
+  /**
+   * @brief Returns up to count children in increasing name order, starting
+   * at the child index given by position. On return, position is the index
+   * of the next child to list, or getNumChildren() once every child has been
+   * listed.
+   *
+   * This will return an empty vector if the GroupIO is invalid.
+   * @param position
+   * @param count
+   * @param includeDatasetInfo
+   * @return std::vector<ChildInfo>
+   */
+  std::vector<ChildInfo> listChildren(SizeType& position, size_t count, bool includeDatasetInfo = false) const;
+
+  /**
+   * @brief Calls the callback for each child in the order the links are
+   * stored, without collecting the children first. This is the fastest way to
+   * visit groups with millions of links. The callback is invoked while the
+   * group is being iterated and must not modify the group.
+   * Returns an error code if one occurs. Otherwise, this method returns 0.
+   * @param callback
+   * @param includeDatasetInfo
+   * @return ErrorType
+   */
+  ErrorType forEachChild(const ChildCallback& callback, bool includeDatasetInfo = false) const;
+
   /**
    * @brief Returns true if the target child is a group. Returns false
    * otherwise.
@@ -0,0 +1,94 @@
+#include "GroupOptions.hpp"
+
+#include "NX/H5Support/H5Support.hpp"
+
+#include <H5Ppublic.h>
+
+#include <algorithm>
+#include <iostream>
+
+namespace NX::H5Support
+{
+namespace
+{
+// H5Pset_est_link_info rejects estimates that do not fit in 16 bits.
+constexpr uint32_t k_MaxLinkEstimate = 65535;
+} // namespace
+
+GroupOptions GroupOptions::ManyAttributes()
+{
+  GroupOptions options;
+  options.attributeMaxCompact = 0;
+  options.attributeMinDense = 0;
+  return options;
+}
+
+GroupOptions GroupOptions::LargeGroup(size_t numEntries)
+{
+  GroupOptions options;
+  options.trackLinkCreationOrder = true;
+  options.linkMaxCompact = 0;
+  options.linkMinDense = 0;
+  options.estimatedNumEntries = static_cast<uint32_t>(std::min<size_t>(numEntries, k_MaxLinkEstimate));
+  return options;
+}
+
+GroupOptions GroupOptions::ForEstimatedEntries(size_t numEntries)
+{
+  if(numEntries > k_LargeGroupThreshold)
+  {
+    return LargeGroup(numEntries);
+  }
+  GroupOptions options;
+  options.estimatedNumEntries = static_cast<uint32_t>(numEntries);
+  return options;
+}
+
+IdType GroupOptions::createCreationProperties() const
+{
+  H5SUPPORT_MUTEX_LOCK()
+
+  hid_t creationPropertiesId = H5Pcreate(H5P_GROUP_CREATE);
+  if(creationPropertiesId < 0)
+  {
+    return creationPropertiesId;
+  }
+
+  herr_t error = H5Pset_attr_phase_change(creationPropertiesId, attributeMaxCompact, attributeMinDense);
+  if(error < 0)
+  {
+    std::cout << "Error Setting Attribute Phase Change" << std::endl;
+    H5Pclose(creationPropertiesId);
+    return error;
+  }
+
+  if(trackLinkCreationOrder || indexLinkCreationOrder)
+  {
+    const unsigned flags = indexLinkCreationOrder ? (H5P_CRT_ORDER_TRACKED | H5P_CRT_ORDER_INDEXED) : H5P_CRT_ORDER_TRACKED;
+    error = H5Pset_link_creation_order(creationPropertiesId, flags);
+    if(error < 0)
+    {
+      std::cout << "Error Setting Link Creation Order" << std::endl;
+      H5Pclose(creationPropertiesId);
+      return error;
+    }
+  }
+
+  error = H5Pset_link_phase_change(creationPropertiesId, linkMaxCompact, linkMinDense);
+  if(error < 0)
+  {
+    std::cout << "Error Setting Link Phase Change" << std::endl;
+    H5Pclose(creationPropertiesId);
+    return error;
+  }
+
+  error = H5Pset_est_link_info(creationPropertiesId, std::min(estimatedNumEntries, k_MaxLinkEstimate), std::min(estimatedNameLength, k_MaxLinkEstimate));
+  if(error < 0)
+  {
+    std::cout << "Error Setting Estimated Link Info" << std::endl;
+    H5Pclose(creationPropertiesId);
+    return error;
+  }
+  return creationPropertiesId;
+}
+} // namespace NX::H5Support
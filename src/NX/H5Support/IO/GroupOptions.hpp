@@ -0,0 +1,113 @@
+#pragma once
+
+#include "NX/H5Support/H5.hpp"
+#include "NX/H5Support/NXH5SUPPORT_EXPORT.hpp"
+
+#include <cstddef>
+
+namespace NX::H5Support
+{
+/**
+ * @brief GroupOptions describes the HDF5 properties used when creating a
+ * group. Default constructed options reproduce the HDF5 defaults. Attribute
+ * and link storage settings only take effect in groups using the 1.8 object
+ * format, which is used in files opened with FileOptions::objectFormatV18 and
+ * for any group that tracks link creation order.
+ */
+struct NXH5SUPPORT_EXPORT GroupOptions
+{
+  /**
+   * @brief Attribute storage: maximum number of attributes kept in compact
+   * storage within the object header. Adding more attributes moves them into
+   * dense storage, which is indexed by name.
+   */
+  uint32_t attributeMaxCompact = 8;
+
+  /**
+   * @brief Attribute storage: number of attributes below which dense storage
+   * is converted back to compact storage. Must not exceed attributeMaxCompact.
+   */
+  uint32_t attributeMinDense = 6;
+
+  /**
+   * @brief Link storage: records the order in which links are created. This
+   * always stores the group in the 1.8 object format, even in files using the
+   * default format.
+   */
+  bool trackLinkCreationOrder = false;
+
+  /**
+   * @brief Link storage: maintains an index on link creation order so that
+   * iterating by creation order does not sort the links. Implies
+   * trackLinkCreationOrder.
+   */
+  bool indexLinkCreationOrder = false;
+
+  /**
+   * @brief Link storage: maximum number of links kept in compact storage
+   * within the object header. Adding more links moves them into dense storage,
+   * which is indexed by a B-tree of name hashes.
+   */
+  uint32_t linkMaxCompact = 8;
+
+  /**
+   * @brief Link storage: number of links below which dense storage is
+   * converted back to compact storage. Must not exceed linkMaxCompact + 1.
+   */
+  uint32_t linkMinDense = 6;
+
+  /**
+   * @brief Link storage: expected number of links, used to size the object
+   * header for compact storage. HDF5 limits the hint to 65535.
+   */
+  uint32_t estimatedNumEntries = 4;
+
+  /**
+   * @brief Link storage: expected average link name length, used to size the
+   * object header for compact storage. HDF5 limits the hint to 65535.
+   */
+  uint32_t estimatedNameLength = 8;
+
+  /**
+   * @brief Number of expected links above which ForEstimatedEntries()
+   * configures a group with LargeGroup().
+   */
+  static constexpr size_t k_LargeGroupThreshold = 1024;
+
+  /**
+   * @brief Preset for groups holding many attributes. Attributes are always
+   * kept in dense storage so that lookups, overwrites and deletions do not scan
+   * the object header.
+   * @return GroupOptions
+   */
+  static GroupOptions ManyAttributes();
+
+  /**
+   * @brief Preset for groups holding many links. Links are stored in dense
+   * storage from the first insertion so the group never migrates from compact
+   * storage, and creation order is tracked so the group uses the 1.8 object
+   * format regardless of the file format. Lookups by name then go through the
+   * dense name index instead of the 1.6 symbol table.
+   * @param numEntries Expected number of links
+   * @return GroupOptions
+   */
+  static GroupOptions LargeGroup(size_t numEntries);
+
+  /**
+   * @brief Returns options suited to a group expected to hold numEntries
+   * links: LargeGroup() above k_LargeGroupThreshold and the HDF5 defaults,
+   * with the entry estimate applied, otherwise.
+   * @param numEntries Expected number of links
+   * @return GroupOptions
+   */
+  static GroupOptions ForEstimatedEntries(size_t numEntries);
+
+  /**
+   * @brief Creates an HDF5 group creation property list matching the options.
+   * The caller is responsible for closing the returned ID with H5Pclose.
+   * Returns a negative value if the property list could not be created.
+   * @return IdType
+   */
+  IdType createCreationProperties() const;
+};
+} // namespace NX::H5Support
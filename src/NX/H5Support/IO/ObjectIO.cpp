@@ -7,6 +7,140 @@
 
 namespace NX::H5Support
 {
+namespace
+{
+template <typename T>
+void readAttributeValues(hid_t attributeId, size_t numElements, const char* name, ObjectIO::AttributeMap& attributes)
+{
+  std::vector<T> values(numElements);
+  if(H5Aread(attributeId, Support::HdfTypeForPrimitive<T>(), values.data()) >= 0)
+  {
+    attributes.emplace(name, std::move(values));
+  }
+}
+
+/**
+ * @brief Reads a string attribute. Scalar and single element attributes are
+ * stored as a std::string, larger ones as a vector with one string per
+ * element.
+ */
+void readAttributeString(hid_t attributeId, hid_t typeId, hid_t dataspaceId, size_t numElements, const char* name, ObjectIO::AttributeMap& attributes)
+{
+  if(numElements == 0)
+  {
+    return;
+  }
+
+  std::vector<std::string> values;
+  if(H5Tis_variable_str(typeId) > 0)
+  {
+    hid_t memoryTypeId = H5Tcopy(H5T_C_S1);
+    H5Tset_size(memoryTypeId, H5T_VARIABLE);
+    H5Tset_cset(memoryTypeId, H5Tget_cset(typeId));
+    std::vector<char*> buffer(numElements, nullptr);
+    if(H5Aread(attributeId, memoryTypeId, buffer.data()) >= 0)
+    {
+      for(const char* element : buffer)
+      {
+        values.emplace_back(element != nullptr ? element : "");
+      }
+      H5Dvlen_reclaim(memoryTypeId, dataspaceId, H5P_DEFAULT, buffer.data());
+    }
+    H5Tclose(memoryTypeId);
+  }
+  else
+  {
+    const size_t elementSize = H5Tget_size(typeId);
+    std::vector<char> buffer(elementSize * numElements);
+    if(!buffer.empty() && H5Aread(attributeId, typeId, buffer.data()) >= 0)
+    {
+      for(size_t i = 0; i < numElements; i++)
+      {
+        std::string value(buffer.data() + i * elementSize, elementSize);
+        value.erase(value.find_last_not_of('\0') + 1);
+        values.push_back(std::move(value));
+      }
+    }
+  }
+
+  if(values.size() == 1)
+  {
+    attributes.emplace(name, std::move(values.front()));
+  }
+  else if(!values.empty())
+  {
+    attributes.emplace(name, std::move(values));
+  }
+}
+
+/**
+ * @brief H5Aiterate operator that reads each attribute into the
+ * ObjectIO::AttributeMap passed as the operator data.
+ */
+herr_t collectAttribute(hid_t locationId, const char* name, const H5A_info_t* /*info*/, void* operatorData)
+{
+  auto& attributes = *static_cast<ObjectIO::AttributeMap*>(operatorData);
+  hid_t attributeId = H5Aopen(locationId, name, H5P_DEFAULT);
+  if(attributeId < 0)
+  {
+    return 0;
+  }
+
+  hid_t typeId = H5Aget_type(attributeId);
+  hid_t dataspaceId = H5Aget_space(attributeId);
+  const size_t numElements = static_cast<size_t>(H5Sget_simple_extent_npoints(dataspaceId));
+  if(H5Tget_class(typeId) == H5T_STRING)
+  {
+    readAttributeString(attributeId, typeId, dataspaceId, numElements, name, attributes);
+  }
+  else
+  {
+    hid_t nativeTypeId = H5Tget_native_type(typeId, H5T_DIR_ASCEND);
+    switch(getTypeFromId(nativeTypeId))
+    {
+    case Type::int8:
+      readAttributeValues<int8_t>(attributeId, numElements, name, attributes);
+      break;
+    case Type::int16:
+      readAttributeValues<int16_t>(attributeId, numElements, name, attributes);
+      break;
+    case Type::int32:
+      readAttributeValues<int32_t>(attributeId, numElements, name, attributes);
+      break;
+    case Type::int64:
+      readAttributeValues<int64_t>(attributeId, numElements, name, attributes);
+      break;
+    case Type::uint8:
+      readAttributeValues<uint8_t>(attributeId, numElements, name, attributes);
+      break;
+    case Type::uint16:
+      readAttributeValues<uint16_t>(attributeId, numElements, name, attributes);
+      break;
+    case Type::uint32:
+      readAttributeValues<uint32_t>(attributeId, numElements, name, attributes);
+      break;
+    case Type::uint64:
+      readAttributeValues<uint64_t>(attributeId, numElements, name, attributes);
+      break;
+    case Type::float32:
+      readAttributeValues<float>(attributeId, numElements, name, attributes);
+      break;
+    case Type::float64:
+      readAttributeValues<double>(attributeId, numElements, name, attributes);
+      break;
+    default:
+      break;
+    }
+    H5Tclose(nativeTypeId);
+  }
+
+  H5Sclose(dataspaceId);
+  H5Tclose(typeId);
+  H5Aclose(attributeId);
+  return 0;
+}
+} // namespace
+
 ObjectIO::ObjectIO() = default;
 
 ObjectIO::ObjectIO(IdType parentId)
@@ -23,9 +157,25 @@ ObjectIO::ObjectIO(IdType parentId, IdType objectId)
 ObjectIO::ObjectIO(IdType parentId, const std::string& targetName)
 : m_ParentId(parentId)
 {
+  H5SUPPORT_MUTEX_LOCK()
+
   m_Id = H5Oopen(parentId, targetName.c_str(), H5P_DEFAULT);
 }
 
+ObjectIO ObjectIO::OpenByAddress(IdType locationId, haddr_t address)
+{
+  H5SUPPORT_MUTEX_LOCK()
+
+  HDF_ERROR_HANDLER_OFF
+  IdType objectId = H5Oopen_by_addr(locationId, address);
+  HDF_ERROR_HANDLER_ON
+  if(objectId < 0)
+  {
+    return ObjectIO();
+  }
+  return ObjectIO(locationId, objectId);
+}
+
 ObjectIO::~ObjectIO() noexcept
 {
   closeHdf5();
@@ -33,6 +183,8 @@ ObjectIO::~ObjectIO() noexcept
 
 void ObjectIO::closeHdf5()
 {
+  H5SUPPORT_MUTEX_LOCK()
+
   if(isValid())
   {
     H5Oclose(m_Id);
@@ -53,6 +205,8 @@ bool ObjectIO::isValid() const
 
 IdType ObjectIO::getFileId() const
 {
+  H5SUPPORT_MUTEX_LOCK()
+
   if(!isValid())
   {
     return 0;
@@ -87,6 +241,8 @@ void ObjectIO::setSharedParent(std::shared_ptr<GroupIO> sharedParent)
 
 haddr_t ObjectIO::getObjectId() const
 {
+  H5SUPPORT_MUTEX_LOCK()
+
   if(!isValid())
   {
     return 0;
@@ -142,6 +298,8 @@ std::string ObjectIO::getObjectPath() const
 
 size_t ObjectIO::getNumAttributes() const
 {
+  H5SUPPORT_MUTEX_LOCK()
+
   if(!isValid())
   {
     return 0;
@@ -162,6 +320,23 @@ std::vector<std::string> ObjectIO::getAttributeNames() const
   return attributeNames;
 }
 
+ObjectIO::AttributeMap ObjectIO::readAllAttributes() const
+{
+  H5SUPPORT_MUTEX_LOCK()
+
+  AttributeMap attributes;
+  if(!isValid())
+  {
+    return attributes;
+  }
+
+  if(H5Aiterate(getId(), H5_INDEX_NAME, H5_ITER_NATIVE, nullptr, collectAttribute, &attributes) < 0)
+  {
+    std::cout << "Error Iterating Attributes" << std::endl;
+  }
+  return attributes;
+}
+
 AttributeIO ObjectIO::getAttribute(const std::string& name) const
 {
   if(!isValid())
@@ -3,8 +3,10 @@
 #include "NX/H5Support/H5.hpp"
 #include "NX/H5Support/IO/AttributeIO.hpp"
 
+#include <map>
 #include <memory>
 #include <string>
+#include <variant>
 #include <vector>
 
 namespace NX::H5Support
@@ -13,6 +15,16 @@ class GroupIO;
 class NXH5SUPPORT_EXPORT ObjectIO
 {
 public:
+  /**
+   * @brief Value of a single attribute. Numeric attributes are stored as a
+   * vector holding every element, scalar attributes included. String
+   * attributes with a single element are stored as a std::string and string
+   * arrays as a vector of strings.
+   */
+  using AttributeValue = std::variant<std::vector<int8_t>, std::vector<int16_t>, std::vector<int32_t>, std::vector<int64_t>, std::vector<uint8_t>, std::vector<uint16_t>, std::vector<uint32_t>,
+                                      std::vector<uint64_t>, std::vector<float>, std::vector<double>, std::string, std::vector<std::string>>;
+  using AttributeMap = std::map<std::string, AttributeValue>;
+
   /**
    * @brief Constructs an invalid ObjectIO.
    */
@@ -26,6 +38,16 @@ public:
    */
   ObjectIO(IdType parentId, const std::string& targetName);
 
+  /**
+   * @brief Opens the HDF5 object at the specified address within the file
+   * containing locationId without traversing any links. Returns an invalid
+   * ObjectIO if no object exists at the address.
+   * @param locationId Any open object in the target file
+   * @param address
+   * @return ObjectIO
+   */
+  static ObjectIO OpenByAddress(IdType locationId, haddr_t address);
+
   /**
    * @brief Releases the wrapped HDF5 object.
    */
@@ -95,6 +117,15 @@ public:
    */
   std::vector<std::string> getAttributeNames() const;
 
+  /**
+   * @brief Reads every attribute of the object in a single pass and returns
+   * the values keyed by attribute name. Attributes whose type is not a
+   * supported numeric or string type are skipped. Returns an empty map if the
+   * object is invalid.
+   * @return AttributeMap
+   */
+  AttributeMap readAllAttributes() const;
+
   /**
    * @brief Returns the HDF5 object path from the file ID. Returns an empty
    * string if the writer is invalid.
@@ -0,0 +1,425 @@
+#pragma once
+
+#include "NX/H5Support/H5Support.hpp"
+#include "NX/H5Support/IO/DatasetIO.hpp"
+#include "NX/H5Support/Instrumentation.hpp"
+
+#include <nonstd/span.hpp>
+
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <memory>
+#include <numeric>
+#include <vector>
+
+namespace NX::H5Support
+{
+/**
+ * @brief Wraps a DatasetIO whose element type and rank are known at compile
+ * time. Dimensions are passed as std::array and the HDF5 memory type is
+ * picked when the template is instantiated, so unsupported element types
+ * fail to compile instead of failing at runtime. The dataset's dimensions
+ * and type are loaded once while it stays open, after which reads, writes
+ * and dimension queries do not allocate. Datasets of another rank or of
+ * strings are rejected.
+ * @tparam T
+ * @tparam Rank
+ */
+template <typename T, size_t Rank>
+class TypedDataset
+{
+  static_assert(Support::k_IsHdfPrimitive<T>, "TypedDataset requires a type supported by HdfTypeForPrimitive");
+  static_assert(Rank > 0, "TypedDataset requires a rank of at least 1");
+
+public:
+  using DimsType = std::array<hsize_t, Rank>;
+
+  /**
+   * @brief Constructs an invalid TypedDataset.
+   */
+  TypedDataset() = default;
+
+  /**
+   * @brief Constructs a TypedDataset taking over the given dataset, such as
+   * one returned by GroupIO::openDataset() or GroupIO::createDataset().
+   * @param dataset
+   */
+  explicit TypedDataset(DatasetIO&& dataset)
+  : m_Dataset(std::move(dataset))
+  {
+  }
+
+  TypedDataset(const TypedDataset& other) = delete;
+  TypedDataset(TypedDataset&& other) noexcept = default;
+  TypedDataset& operator=(const TypedDataset& rhs) = delete;
+  TypedDataset& operator=(TypedDataset&& rhs) noexcept = default;
+  ~TypedDataset() = default;
+
+  /**
+   * @brief Returns the number of elements described by the dimensions.
+   * @param dims
+   * @return SizeType
+   */
+  static SizeType NumElements(const DimsType& dims)
+  {
+    return std::accumulate(dims.cbegin(), dims.cend(), SizeType{1}, std::multiplies<>());
+  }
+
+  /**
+   * @brief Returns true if the TypedDataset has a valid target.
+   * @return bool
+   */
+  bool isValid() const
+  {
+    return m_Dataset.isValid();
+  }
+
+  /**
+   * @brief Returns the wrapped dataset, for example to access its
+   * attributes.
+   * @return DatasetIO&
+   */
+  DatasetIO& getDatasetIO()
+  {
+    return m_Dataset;
+  }
+
+  const DatasetIO& getDatasetIO() const
+  {
+    return m_Dataset;
+  }
+
+  /**
+   * @brief Opens the existing dataset. Returns false if it cannot be opened
+   * or does not hold Rank-dimensional numeric data.
+   * @return bool
+   */
+  bool open()
+  {
+    return m_Dataset.open() && getMetadata() != nullptr;
+  }
+
+  /**
+   * @brief Opens the dataset or creates it with the given dimensions. The
+   * dataset is chunked unless chunkDims is left at zero. Returns false if it
+   * cannot be created or an existing dataset has another rank.
+   * @param dims
+   * @param chunkDims
+   * @return bool
+   */
+  bool createOrOpen(const DimsType& dims, const DimsType& chunkDims = {})
+  {
+    return createOrOpen(dims, chunkDims, nullptr);
+  }
+
+  /**
+   * @brief Opens the dataset or creates a chunked dataset whose dimensions can
+   * later be grown with setExtent(). Returns false if it cannot be created or
+   * an existing dataset has another rank.
+   * @param dims Initial dimensions
+   * @param chunkDims
+   * @return bool
+   */
+  bool createOrOpenExtendible(const DimsType& dims, const DimsType& chunkDims)
+  {
+    DimsType maxDims;
+    maxDims.fill(H5S_UNLIMITED);
+    return createOrOpen(dims, chunkDims, maxDims.data());
+  }
+
+  /**
+   * @brief Returns the dimensions of the open dataset. Returns all zeros if
+   * the dataset is not open or has another rank.
+   * @return DimsType
+   */
+  DimsType getDimensions() const
+  {
+    DimsType dims{};
+    auto metadata = getMetadata();
+    if(metadata != nullptr)
+    {
+      std::copy(metadata->dims.cbegin(), metadata->dims.cend(), dims.begin());
+    }
+    return dims;
+  }
+
+  /**
+   * @brief Returns the chunk dimensions of the open dataset. Returns all
+   * zeros if the dataset is not chunked.
+   * @return DimsType
+   */
+  DimsType getChunkDimensions() const
+  {
+    DimsType chunkDims{};
+    auto metadata = getMetadata();
+    if(metadata != nullptr && metadata->chunkDims.size() == Rank)
+    {
+      std::copy(metadata->chunkDims.cbegin(), metadata->chunkDims.cend(), chunkDims.begin());
+    }
+    return chunkDims;
+  }
+
+  /**
+   * @brief Returns the number of elements in the open dataset.
+   * @return SizeType
+   */
+  SizeType getNumElements() const
+  {
+    auto metadata = getMetadata();
+    return metadata != nullptr ? std::accumulate(metadata->dims.cbegin(), metadata->dims.cend(), SizeType{1}, std::multiplies<>()) : 0;
+  }
+
+  /**
+   * @brief Reads the whole dataset into the given span. Requires the span to
+   * hold exactly getNumElements() values. Returns false if unable to read.
+   * @param data
+   * @return bool
+   */
+  bool readIntoSpan(nonstd::span<T> data) const
+  {
+    H5SUPPORT_MUTEX_LOCK()
+
+    auto metadata = getMetadata();
+    if(metadata == nullptr)
+    {
+      return false;
+    }
+    DimsType dims;
+    std::copy(metadata->dims.cbegin(), metadata->dims.cend(), dims.begin());
+    if(NumElements(dims) != data.size())
+    {
+      return false;
+    }
+
+    // The memory dataspace comes from the checked dimensions, so HDF5 fails
+    // instead of overflowing data if another handle changed the extent
+    hid_t memorySpaceId = H5Screate_simple(static_cast<int>(Rank), dims.data(), nullptr);
+    if(memorySpaceId < 0)
+    {
+      return false;
+    }
+    const hid_t dataType = Support::HdfTypeForPrimitive<T>();
+    H5SUPPORT_INSTRUMENT(Read, m_Dataset.getId())
+    H5SUPPORT_INSTRUMENT_CONVERSION(metadata->type, dataType)
+    herr_t error = H5Dread(m_Dataset.getId(), dataType, memorySpaceId, H5S_ALL, H5P_DEFAULT, data.data());
+    H5Sclose(memorySpaceId);
+    if(error < 0)
+    {
+      return false;
+    }
+    H5SUPPORT_INSTRUMENT_BYTES(data.size() * sizeof(T))
+    H5SUPPORT_INSTRUMENT_CHUNK_CACHE(m_Dataset)
+    return true;
+  }
+
+  /**
+   * @brief Reads the block of count elements starting at offset into the
+   * given span in row-major order. Requires the span to hold exactly
+   * NumElements(count) values and the block to lie inside the dataset.
+   * Returns false if unable to read.
+   * @param offset
+   * @param count
+   * @param data
+   * @return bool
+   */
+  bool readHyperslab(const DimsType& offset, const DimsType& count, nonstd::span<T> data) const
+  {
+    H5SUPPORT_MUTEX_LOCK()
+
+    if(!containsBlock(offset, count) || NumElements(count) != data.size())
+    {
+      return false;
+    }
+
+    const hid_t dataType = Support::HdfTypeForPrimitive<T>();
+    hid_t fileSpaceId = -1;
+    hid_t memorySpaceId = -1;
+    bool success = selectBlock(offset, count, fileSpaceId, memorySpaceId);
+    if(success)
+    {
+      H5SUPPORT_INSTRUMENT(Read, m_Dataset.getId())
+      success = H5Dread(m_Dataset.getId(), dataType, memorySpaceId, fileSpaceId, H5P_DEFAULT, data.data()) >= 0;
+      H5SUPPORT_INSTRUMENT_BYTES(success ? data.size() * sizeof(T) : 0)
+    }
+    closeSpaces(fileSpaceId, memorySpaceId);
+    return success;
+  }
+
+  /**
+   * @brief Writes the values to the dataset, creating it with the given
+   * dimensions if it is not open. The dimensions must match those of an
+   * existing dataset, including changes made through other handles. Returns
+   * the HDF5 error, should one occur.
+   * @param dims
+   * @param values
+   * @return ErrorType
+   */
+  ErrorType writeSpan(const DimsType& dims, nonstd::span<const T> values)
+  {
+    H5SUPPORT_MUTEX_LOCK()
+
+    if(NumElements(dims) != values.size() || (m_Dataset.getId() <= 0 && !createOrOpen(dims)))
+    {
+      return -1;
+    }
+    if(getDimensions() != dims)
+    {
+      std::cout << "Error Writing data: dimensions do not match dataset '" << m_Dataset.getName() << "'" << std::endl;
+      return -1;
+    }
+
+    hid_t memorySpaceId = H5Screate_simple(static_cast<int>(Rank), dims.data(), nullptr);
+    if(memorySpaceId < 0)
+    {
+      return static_cast<ErrorType>(memorySpaceId);
+    }
+    H5SUPPORT_INSTRUMENT(Write, m_Dataset.getId())
+    herr_t error = H5Dwrite(m_Dataset.getId(), Support::HdfTypeForPrimitive<T>(), memorySpaceId, H5S_ALL, H5P_DEFAULT, values.data());
+    H5Sclose(memorySpaceId);
+    H5SUPPORT_INSTRUMENT_BYTES(error < 0 ? 0 : values.size() * sizeof(T))
+    H5SUPPORT_INSTRUMENT_CHUNK_CACHE(m_Dataset)
+    return error;
+  }
+
+  /**
+   * @brief Writes the values into the block of count elements starting at
+   * offset. The dataset must be open and contain the block. Returns the HDF5
+   * error, should one occur.
+   * @param offset
+   * @param count
+   * @param values
+   * @return ErrorType
+   */
+  ErrorType writeHyperslab(const DimsType& offset, const DimsType& count, nonstd::span<const T> values)
+  {
+    H5SUPPORT_MUTEX_LOCK()
+
+    if(!containsBlock(offset, count) || NumElements(count) != values.size())
+    {
+      return -1;
+    }
+
+    hid_t fileSpaceId = -1;
+    hid_t memorySpaceId = -1;
+    herr_t error = selectBlock(offset, count, fileSpaceId, memorySpaceId) ? 0 : -1;
+    if(error >= 0)
+    {
+      H5SUPPORT_INSTRUMENT(Write, m_Dataset.getId())
+      error = H5Dwrite(m_Dataset.getId(), Support::HdfTypeForPrimitive<T>(), memorySpaceId, fileSpaceId, H5P_DEFAULT, values.data());
+      H5SUPPORT_INSTRUMENT_BYTES(error < 0 ? 0 : values.size() * sizeof(T))
+    }
+    closeSpaces(fileSpaceId, memorySpaceId);
+    return error;
+  }
+
+  /**
+   * @brief Changes the dimensions of an open dataset created with
+   * createOrOpenExtendible(). Returns the HDF5 error, should one occur.
+   * @param dims
+   * @return ErrorType
+   */
+  ErrorType setExtent(const DimsType& dims)
+  {
+    H5SUPPORT_MUTEX_LOCK()
+
+    if(m_Dataset.getId() <= 0)
+    {
+      return -1;
+    }
+
+    m_Dataset.invalidateMetadata();
+    return H5Dset_extent(m_Dataset.getId(), dims.data());
+  }
+
+private:
+  /**
+   * @brief Returns the dataset's cached metadata, or nullptr if the dataset
+   * is not open or does not hold Rank-dimensional numeric data.
+   */
+  std::shared_ptr<const DatasetIO::Metadata> getMetadata() const
+  {
+    auto metadata = m_Dataset.getMetadata();
+    if(metadata == nullptr || metadata->rank != static_cast<int32_t>(Rank) || metadata->classType == H5T_STRING)
+    {
+      return nullptr;
+    }
+    return metadata;
+  }
+
+  bool createOrOpen(const DimsType& dims, const DimsType& chunkDims, const hsize_t* maxDims)
+  {
+    H5SUPPORT_MUTEX_LOCK()
+
+    if(!m_Dataset.isValid())
+    {
+      return false;
+    }
+    if(m_Dataset.getId() <= 0)
+    {
+      hid_t dataspaceId = H5Screate_simple(static_cast<int>(Rank), dims.data(), maxDims);
+      if(dataspaceId < 0)
+      {
+        return false;
+      }
+      const bool chunked = std::any_of(chunkDims.cbegin(), chunkDims.cend(), [](hsize_t value) { return value > 0; });
+      IdType propertiesId = chunked ? DatasetIO::CreateDatasetChunkProperties(chunkDims) : H5P_DEFAULT;
+      m_Dataset.createOrOpenDataset(Support::HdfTypeForPrimitive<T>(), dataspaceId, propertiesId);
+      if(propertiesId != H5P_DEFAULT)
+      {
+        H5Pclose(propertiesId);
+      }
+      H5Sclose(dataspaceId);
+      if(m_Dataset.getId() <= 0)
+      {
+        std::cout << "Error Creating or Opening Dataset" << std::endl;
+        return false;
+      }
+    }
+    return getMetadata() != nullptr;
+  }
+
+  bool containsBlock(const DimsType& offset, const DimsType& count) const
+  {
+    auto metadata = getMetadata();
+    if(metadata == nullptr)
+    {
+      return false;
+    }
+    const std::vector<hsize_t>& dims = metadata->dims;
+    for(size_t i = 0; i < Rank; i++)
+    {
+      if(offset[i] > dims[i] || count[i] > dims[i] - offset[i])
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /**
+   * @brief Selects the block in the dataset's dataspace and creates a
+   * matching memory dataspace. The caller closes both with closeSpaces().
+   */
+  bool selectBlock(const DimsType& offset, const DimsType& count, hid_t& fileSpaceId, hid_t& memorySpaceId) const
+  {
+    fileSpaceId = H5Dget_space(m_Dataset.getId());
+    memorySpaceId = H5Screate_simple(static_cast<int>(Rank), count.data(), nullptr);
+    return fileSpaceId >= 0 && memorySpaceId >= 0 && H5Sselect_hyperslab(fileSpaceId, H5S_SELECT_SET, offset.data(), nullptr, count.data(), nullptr) >= 0;
+  }
+
+  static void closeSpaces(hid_t fileSpaceId, hid_t memorySpaceId)
+  {
+    if(memorySpaceId >= 0)
+    {
+      H5Sclose(memorySpaceId);
+    }
+    if(fileSpaceId >= 0)
+    {
+      H5Sclose(fileSpaceId);
+    }
+  }
+
+  DatasetIO m_Dataset;
+};
+} // namespace NX::H5Support
@@ -0,0 +1,581 @@
+#include "Instrumentation.hpp"
+
+#include "NX/H5Support/H5Support.hpp"
+#include "NX/H5Support/IO/DatasetIO.hpp"
+#include "NX/H5Support/Tracing.hpp"
+
+#include <fmt/format.h>
+#include <nlohmann/json.hpp>
+
+#include <atomic>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <numeric>
+#include <unordered_map>
+
+using namespace NX::Common;
+
+namespace NX::H5Support::Instrumentation
+{
+namespace
+{
+std::atomic<bool> s_Enabled = false;
+
+std::mutex& countersMutex()
+{
+  static std::mutex mutex;
+  return mutex;
+}
+
+std::map<std::string, FileCounters>& recordedFiles()
+{
+  static std::map<std::string, FileCounters> files;
+  return files;
+}
+
+/**
+ * @brief Model of an open dataset's chunk cache. Chunks are identified by
+ * their row-major index in the chunk grid and all have the same size.
+ */
+struct ChunkCacheModel
+{
+  std::vector<hsize_t> dims;
+  std::vector<hsize_t> chunkDims;
+  size_t chunkBytes = 0;
+  size_t capacityBytes = 0;
+  size_t numSlots = 0;
+  size_t usedBytes = 0;
+  std::list<uint64_t> recency; // Most recently used first
+  std::unordered_map<uint64_t, std::list<uint64_t>::iterator> entries;
+  std::unordered_map<size_t, uint64_t> slots;
+
+  void evict(uint64_t chunkIndex, size_t slot)
+  {
+    auto entry = entries.find(chunkIndex);
+    recency.erase(entry->second);
+    entries.erase(entry);
+    slots.erase(slot);
+    usedBytes -= chunkBytes;
+  }
+};
+
+/**
+ * @brief Chunk cache models of the open datasets, keyed by dataset ID. A
+ * model is dropped whenever its dataset is closed, recording or not, since
+ * HDF5 reuses released IDs. Guarded by countersMutex().
+ */
+std::map<IdType, ChunkCacheModel>& chunkCacheModels()
+{
+  static std::map<IdType, ChunkCacheModel> models;
+  return models;
+}
+
+/**
+ * @brief Returns the number of bits HDF5 1.10 uses to encode a chunk
+ * coordinate in a dimension with the given number of chunks.
+ */
+uint32_t encodeBits(hsize_t numChunks)
+{
+  uint32_t bits = 0;
+  while((hsize_t{1} << bits) < numChunks)
+  {
+    bits++;
+  }
+  return bits;
+}
+
+/**
+ * @brief Returns the chunk grid coordinates of the chunk with the given
+ * row-major index.
+ */
+std::vector<hsize_t> scaledCoordinates(uint64_t chunkIndex, const std::vector<hsize_t>& numChunks)
+{
+  std::vector<hsize_t> scaled(numChunks.size());
+  for(size_t i = numChunks.size(); i-- > 0;)
+  {
+    scaled[i] = chunkIndex % numChunks[i];
+    chunkIndex /= numChunks[i];
+  }
+  return scaled;
+}
+
+/**
+ * @brief Returns the cache slot HDF5 1.10 stores the chunk at the given
+ * chunk grid coordinates in.
+ */
+size_t chunkSlot(const std::vector<hsize_t>& scaled, const std::vector<uint32_t>& bits, size_t numSlots)
+{
+  hsize_t value = scaled[0];
+  for(size_t i = 1; i < scaled.size(); i++)
+  {
+    value <<= bits[i];
+    value ^= scaled[i];
+  }
+  return static_cast<size_t>(value % numSlots);
+}
+
+/**
+ * @brief Returns the name of the file containing the object, or an empty
+ * string if the ID is not valid.
+ */
+std::string fileName(IdType objectId)
+{
+  H5SUPPORT_MUTEX_LOCK()
+
+  ssize_t nameLength = H5Fget_name(objectId, nullptr, 0);
+  if(nameLength <= 0)
+  {
+    return "";
+  }
+  std::string name(static_cast<size_t>(nameLength), '\0');
+  H5Fget_name(objectId, name.data(), name.size() + 1);
+  return name;
+}
+
+/**
+ * @brief Returns the path of the object within its file. Anonymous objects
+ * are reported as "<anonymous>".
+ */
+std::string objectPath(IdType objectId)
+{
+  H5SUPPORT_MUTEX_LOCK()
+
+  ssize_t nameLength = H5Iget_name(objectId, nullptr, 0);
+  if(nameLength <= 0)
+  {
+    return "<anonymous>";
+  }
+  std::string path(static_cast<size_t>(nameLength), '\0');
+  H5Iget_name(objectId, path.data(), path.size() + 1);
+  return path;
+}
+
+nlohmann::json countersToJson(const Counters& counters)
+{
+  nlohmann::json json = nlohmann::json::object();
+  const EstimatedChunkCacheCounters& estimatedChunkCache = counters.estimatedChunkCache;
+  if(estimatedChunkCache.hits > 0 || estimatedChunkCache.misses > 0)
+  {
+    json["estimatedChunkCache"] = {{"hits", estimatedChunkCache.hits}, {"misses", estimatedChunkCache.misses}, {"evictions", estimatedChunkCache.evictions}};
+  }
+  for(size_t i = 0; i < k_NumOperations; i++)
+  {
+    const OperationCounters& operation = counters.operations[i];
+    if(operation.calls == 0)
+    {
+      continue;
+    }
+    nlohmann::json& entry = json[OperationName(static_cast<Operation>(i))];
+    entry["calls"] = operation.calls;
+    entry["bytes"] = operation.bytes;
+    entry["nanoseconds"] = operation.nanoseconds;
+    entry["convertingCalls"] = operation.convertingCalls;
+    entry["convertingCallNanoseconds"] = operation.convertingCallNanoseconds;
+  }
+  return json;
+}
+
+nlohmann::json cacheStatsToJson(const CacheStats& stats)
+{
+  nlohmann::json json;
+  json["metadataHitRate"] = stats.metadataHitRate;
+  json["metadataMaxSize"] = stats.metadataMaxSize;
+  json["metadataMinCleanSize"] = stats.metadataMinCleanSize;
+  json["metadataCurrentSize"] = stats.metadataCurrentSize;
+  json["metadataNumEntries"] = stats.metadataNumEntries;
+  json["pageBufferEnabled"] = stats.pageBufferEnabled;
+  if(stats.pageBufferEnabled)
+  {
+    json["pageAccesses"] = stats.pageAccesses;
+    json["pageHits"] = stats.pageHits;
+    json["pageMisses"] = stats.pageMisses;
+    json["pageEvictions"] = stats.pageEvictions;
+    json["pageBypasses"] = stats.pageBypasses;
+  }
+  return json;
+}
+} // namespace
+
+std::string OperationName(Operation operation)
+{
+  switch(operation)
+  {
+  case Operation::Open:
+    return "open";
+  case Operation::Close:
+    return "close";
+  case Operation::Read:
+    return "read";
+  case Operation::Write:
+    return "write";
+  case Operation::ReadChunk:
+    return "readChunk";
+  case Operation::WriteChunk:
+    return "writeChunk";
+  case Operation::ReadAttribute:
+    return "readAttribute";
+  case Operation::WriteAttribute:
+    return "writeAttribute";
+  case Operation::Query:
+    return "query";
+  }
+  return "unknown";
+}
+
+OperationCounters& OperationCounters::operator+=(const OperationCounters& rhs)
+{
+  calls += rhs.calls;
+  bytes += rhs.bytes;
+  nanoseconds += rhs.nanoseconds;
+  convertingCalls += rhs.convertingCalls;
+  convertingCallNanoseconds += rhs.convertingCallNanoseconds;
+  return *this;
+}
+
+EstimatedChunkCacheCounters& EstimatedChunkCacheCounters::operator+=(const EstimatedChunkCacheCounters& rhs)
+{
+  hits += rhs.hits;
+  misses += rhs.misses;
+  evictions += rhs.evictions;
+  return *this;
+}
+
+Counters& Counters::operator+=(const Counters& rhs)
+{
+  for(size_t i = 0; i < k_NumOperations; i++)
+  {
+    operations[i] += rhs.operations[i];
+  }
+  estimatedChunkCache += rhs.estimatedChunkCache;
+  return *this;
+}
+
+OperationCounters Counters::total() const
+{
+  OperationCounters sum;
+  for(const auto& operation : operations)
+  {
+    sum += operation;
+  }
+  return sum;
+}
+
+Counters Snapshot::totals() const
+{
+  Counters sum;
+  for(const auto& [name, file] : files)
+  {
+    sum += file.totals;
+  }
+  return sum;
+}
+
+std::string Snapshot::toJson(int32_t indent) const
+{
+  nlohmann::json json;
+  json["totals"] = countersToJson(totals());
+  json["files"] = nlohmann::json::object();
+  for(const auto& [name, file] : files)
+  {
+    nlohmann::json& fileJson = json["files"][name];
+    fileJson["totals"] = countersToJson(file.totals);
+    if(file.cacheStats.has_value())
+    {
+      fileJson["cacheStats"] = cacheStatsToJson(*file.cacheStats);
+    }
+    fileJson["objects"] = nlohmann::json::object();
+    for(const auto& [path, counters] : file.objects)
+    {
+      fileJson["objects"][path] = countersToJson(counters);
+    }
+  }
+  return json.dump(indent);
+}
+
+bool IsCompiledIn()
+{
+#ifdef H5Support_USE_INSTRUMENTATION
+  return true;
+#else
+  return false;
+#endif
+}
+
+void SetEnabled(bool enabled)
+{
+  s_Enabled = enabled;
+}
+
+bool IsEnabled()
+{
+  return s_Enabled;
+}
+
+Result<CacheStats> ReadCacheStats(IdType fileId)
+{
+  H5SUPPORT_MUTEX_LOCK()
+
+  CacheStats stats;
+  int numEntries = 0;
+  if(H5Fget_mdc_hit_rate(fileId, &stats.metadataHitRate) < 0 ||
+     H5Fget_mdc_size(fileId, &stats.metadataMaxSize, &stats.metadataMinCleanSize, &stats.metadataCurrentSize, &numEntries) < 0)
+  {
+    return MakeErrorResult<CacheStats>(-341, fmt::format("Error reading the metadata cache statistics of file ID {}.", fileId));
+  }
+  stats.metadataNumEntries = static_cast<uint32_t>(std::max(numEntries, 0));
+
+  hid_t accessPropertiesId = H5Fget_access_plist(fileId);
+  size_t pageBufferSize = 0;
+  if(accessPropertiesId >= 0)
+  {
+    H5Pget_page_buffer_size(accessPropertiesId, &pageBufferSize, nullptr, nullptr);
+    H5Pclose(accessPropertiesId);
+  }
+  std::array<unsigned, 2> accesses{};
+  std::array<unsigned, 2> hits{};
+  std::array<unsigned, 2> misses{};
+  std::array<unsigned, 2> evictions{};
+  std::array<unsigned, 2> bypasses{};
+  if(pageBufferSize > 0)
+  {
+    // HDF5 skips the page buffer for files created without paged aggregation
+    // and then fails to report its statistics
+    HDF_ERROR_HANDLER_OFF
+    stats.pageBufferEnabled = H5Fget_page_buffering_stats(fileId, accesses.data(), hits.data(), misses.data(), evictions.data(), bypasses.data()) >= 0;
+    HDF_ERROR_HANDLER_ON
+  }
+  if(stats.pageBufferEnabled)
+  {
+    for(size_t i = 0; i < 2; i++)
+    {
+      stats.pageAccesses[i] = accesses[i];
+      stats.pageHits[i] = hits[i];
+      stats.pageMisses[i] = misses[i];
+      stats.pageEvictions[i] = evictions[i];
+      stats.pageBypasses[i] = bypasses[i];
+    }
+  }
+  return {stats};
+}
+
+Snapshot TakeSnapshot()
+{
+  Snapshot snapshot;
+  {
+    std::lock_guard<std::mutex> lock(countersMutex());
+    snapshot.files = recordedFiles();
+  }
+  if(!IsCompiledIn())
+  {
+    return snapshot;
+  }
+
+  H5SUPPORT_MUTEX_LOCK()
+
+  const ssize_t numFiles = H5Fget_obj_count(H5F_OBJ_ALL, H5F_OBJ_FILE);
+  std::vector<hid_t> fileIds(static_cast<size_t>(std::max<ssize_t>(numFiles, 0)));
+  if(!fileIds.empty())
+  {
+    fileIds.resize(static_cast<size_t>(std::max<ssize_t>(H5Fget_obj_ids(H5F_OBJ_ALL, H5F_OBJ_FILE, fileIds.size(), fileIds.data()), 0)));
+  }
+  for(hid_t fileId : fileIds)
+  {
+    auto statsResult = ReadCacheStats(fileId);
+    const std::string name = fileName(fileId);
+    if(statsResult.valid() && !name.empty())
+    {
+      snapshot.files[name].cacheStats = statsResult.value();
+    }
+  }
+  return snapshot;
+}
+
+void Reset()
+{
+  std::lock_guard<std::mutex> lock(countersMutex());
+  recordedFiles().clear();
+  chunkCacheModels().clear();
+}
+
+Scope::Scope(Operation operation, IdType objectId)
+: m_Counting(s_Enabled)
+, m_Tracing(Tracing::IsActive())
+, m_Operation(operation)
+{
+  if(operation == Operation::Close && objectId > 0)
+  {
+    std::lock_guard<std::mutex> lock(countersMutex());
+    chunkCacheModels().erase(objectId);
+  }
+
+  m_Active = m_Counting || m_Tracing;
+  if(!m_Active)
+  {
+    return;
+  }
+  m_Start = std::chrono::steady_clock::now();
+  setObjectId(objectId);
+}
+
+Scope::~Scope()
+{
+  if(!m_Active || m_FileName.empty())
+  {
+    return;
+  }
+
+  const auto end = std::chrono::steady_clock::now();
+  if(m_Tracing)
+  {
+    Tracing::RecordSpan(m_Operation, m_FileName, m_ObjectPath, m_Bytes, m_Start, end);
+  }
+  if(!m_Counting)
+  {
+    return;
+  }
+
+  OperationCounters counters;
+  counters.calls = 1;
+  counters.bytes = m_Bytes;
+  counters.nanoseconds = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - m_Start - m_Excluded).count());
+  if(m_Converted)
+  {
+    counters.convertingCalls = 1;
+    counters.convertingCallNanoseconds = counters.nanoseconds;
+  }
+
+  std::lock_guard<std::mutex> lock(countersMutex());
+  FileCounters& file = recordedFiles()[m_FileName];
+  file.totals[m_Operation] += counters;
+  file.totals.estimatedChunkCache += m_EstimatedChunkCache;
+  if(!m_ObjectPath.empty())
+  {
+    Counters& object = file.objects[m_ObjectPath];
+    object[m_Operation] += counters;
+    object.estimatedChunkCache += m_EstimatedChunkCache;
+  }
+}
+
+void Scope::setObjectId(IdType objectId)
+{
+  if(!m_Active || objectId <= 0)
+  {
+    return;
+  }
+
+  H5SUPPORT_MUTEX_LOCK()
+
+  // The name lookups are not part of the instrumented call
+  const auto start = std::chrono::steady_clock::now();
+  m_ObjectId = objectId;
+  m_FileName = fileName(objectId);
+  const bool isFileOperation = (m_Operation == Operation::Open || m_Operation == Operation::Close) && H5Iget_type(objectId) == H5I_FILE;
+  m_ObjectPath = isFileOperation ? "" : objectPath(objectId);
+  m_Excluded += std::chrono::steady_clock::now() - start;
+}
+
+void Scope::setConversion(Type fileType, IdType memoryTypeId)
+{
+  if(!m_Active || fileType == Type::string || fileType == Type::unknown)
+  {
+    return;
+  }
+
+  H5SUPPORT_MUTEX_LOCK()
+
+  m_Converted = H5Tequal(getIdForType(fileType), memoryTypeId) <= 0;
+}
+
+void Scope::accessAllChunks(const DatasetIO& dataset)
+{
+  if(!m_Counting || m_ObjectId <= 0)
+  {
+    return;
+  }
+
+  const std::vector<hsize_t> dims = dataset.getDimensions();
+  const std::vector<hsize_t> chunkDims = dataset.getChunkDimensions();
+  if(chunkDims.empty() || chunkDims.size() != dims.size())
+  {
+    return;
+  }
+
+  H5SUPPORT_MUTEX_LOCK()
+
+  const auto start = std::chrono::steady_clock::now();
+  std::lock_guard<std::mutex> lock(countersMutex());
+  ChunkCacheModel& model = chunkCacheModels()[m_ObjectId];
+  if(model.dims != dims || model.chunkDims != chunkDims)
+  {
+    model = ChunkCacheModel();
+    model.dims = dims;
+    model.chunkDims = chunkDims;
+    model.chunkBytes = std::accumulate(chunkDims.cbegin(), chunkDims.cend(), dataset.getTypeSize(), std::multiplies<>());
+    hid_t accessPropertiesId = H5Dget_access_plist(m_ObjectId);
+    if(accessPropertiesId >= 0)
+    {
+      double w0 = 0.0;
+      H5Pget_chunk_cache(accessPropertiesId, &model.numSlots, &model.capacityBytes, &w0);
+      H5Pclose(accessPropertiesId);
+    }
+  }
+
+  const size_t rank = dims.size();
+  std::vector<hsize_t> numChunks(rank);
+  std::vector<uint32_t> bits(rank);
+  uint64_t totalChunks = 1;
+  for(size_t i = 0; i < rank; i++)
+  {
+    numChunks[i] = (dims[i] + chunkDims[i] - 1) / chunkDims[i];
+    bits[i] = encodeBits(numChunks[i]);
+    totalChunks *= numChunks[i];
+  }
+
+  std::vector<hsize_t> scaled(rank, 0);
+  for(uint64_t chunkIndex = 0; chunkIndex < totalChunks; chunkIndex++)
+  {
+    auto entry = model.entries.find(chunkIndex);
+    if(entry != model.entries.end())
+    {
+      m_EstimatedChunkCache.hits++;
+      model.recency.splice(model.recency.begin(), model.recency, entry->second);
+    }
+    else
+    {
+      m_EstimatedChunkCache.misses++;
+      if(model.numSlots > 0 && model.chunkBytes <= model.capacityBytes)
+      {
+        const size_t slot = chunkSlot(scaled, bits, model.numSlots);
+        auto occupant = model.slots.find(slot);
+        if(occupant != model.slots.end())
+        {
+          model.evict(occupant->second, slot);
+          m_EstimatedChunkCache.evictions++;
+        }
+        while(model.usedBytes + model.chunkBytes > model.capacityBytes)
+        {
+          const uint64_t leastRecent = model.recency.back();
+          model.evict(leastRecent, chunkSlot(scaledCoordinates(leastRecent, numChunks), bits, model.numSlots));
+          m_EstimatedChunkCache.evictions++;
+        }
+        model.recency.push_front(chunkIndex);
+        model.entries[chunkIndex] = model.recency.begin();
+        model.slots[slot] = chunkIndex;
+        model.usedBytes += model.chunkBytes;
+      }
+    }
+
+    // Advances the row-major chunk coordinates
+    for(size_t i = rank; i-- > 0;)
+    {
+      if(++scaled[i] < numChunks[i])
+      {
+        break;
+      }
+      scaled[i] = 0;
+    }
+  }
+  m_Excluded += std::chrono::steady_clock::now() - start;
+}
+} // namespace NX::H5Support::Instrumentation
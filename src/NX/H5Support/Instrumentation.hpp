@@ -0,0 +1,281 @@
+#pragma once
+
+#include "NX/H5Support/H5.hpp"
+#include "NX/H5Support/NXH5SUPPORT_EXPORT.hpp"
+
+#include "NX/Common/Result.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <string>
+
+/**
+ * Per-operation I/O counters for DatasetIO, AttributeIO, GroupIO and FileIO.
+ * The hooks are compiled in with NXH5SUPPORT_ENABLE_INSTRUMENTATION and then
+ * record nothing until Instrumentation::SetEnabled(true) or Tracing::Start()
+ * is called. Without the CMake option the H5SUPPORT_INSTRUMENT macros expand
+ * to nothing, while the functions below remain available and return empty
+ * snapshots.
+ */
+namespace NX::H5Support
+{
+class DatasetIO;
+}
+
+namespace NX::H5Support::Instrumentation
+{
+enum class Operation : uint8_t
+{
+  Open,
+  Close,
+  Read,
+  Write,
+  ReadChunk,
+  WriteChunk,
+  ReadAttribute,
+  WriteAttribute,
+  Query
+};
+
+inline constexpr size_t k_NumOperations = 9;
+
+/**
+ * @brief Returns the name used for the operation in JSON output.
+ * @param operation
+ * @return std::string
+ */
+std::string NXH5SUPPORT_EXPORT OperationName(Operation operation);
+
+struct NXH5SUPPORT_EXPORT OperationCounters
+{
+  uint64_t calls = 0;
+  uint64_t bytes = 0;
+  uint64_t nanoseconds = 0; // Time spent inside the instrumented calls
+  // Calls whose memory type differed from the file type, so that HDF5
+  // converted every element, and the whole time spent inside them. The
+  // conversion itself is not timed separately.
+  uint64_t convertingCalls = 0;
+  uint64_t convertingCallNanoseconds = 0;
+
+  OperationCounters& operator+=(const OperationCounters& rhs);
+};
+
+/**
+ * @brief Estimated chunk cache behaviour of whole-dataset reads and writes.
+ * The counts are simulated rather than measured. HDF5 does not report chunk
+ * cache statistics, so each open dataset keeps a model of its chunk cache:
+ * chunks are hashed into the cache's slots the way HDF5 1.10 does, a chunk
+ * evicts the chunk in its slot, and the least recently used chunks are
+ * evicted when the cache runs out of bytes. Chunks larger
+ * than the cache are counted as misses without being cached. Only the
+ * whole-dataset DatasetIO::readIntoSpan and DatasetIO::writeSpan, and their
+ * TypedDataset counterparts, feed the model. Chunk, hyperslab and direct
+ * reads and writes are not counted, so the model misses the chunks they
+ * bring into the cache.
+ */
+struct NXH5SUPPORT_EXPORT EstimatedChunkCacheCounters
+{
+  uint64_t hits = 0;
+  uint64_t misses = 0;
+  uint64_t evictions = 0;
+
+  EstimatedChunkCacheCounters& operator+=(const EstimatedChunkCacheCounters& rhs);
+};
+
+struct NXH5SUPPORT_EXPORT Counters
+{
+  std::array<OperationCounters, k_NumOperations> operations;
+  EstimatedChunkCacheCounters estimatedChunkCache;
+
+  OperationCounters& operator[](Operation operation)
+  {
+    return operations[static_cast<size_t>(operation)];
+  }
+
+  const OperationCounters& operator[](Operation operation) const
+  {
+    return operations[static_cast<size_t>(operation)];
+  }
+
+  Counters& operator+=(const Counters& rhs);
+
+  /**
+   * @brief Returns the sum over every operation.
+   * @return OperationCounters
+   */
+  OperationCounters total() const;
+};
+
+/**
+ * @brief Metadata cache and page buffer statistics reported by HDF5 for an
+ * open file. The hit rate covers the accesses since the file was opened or
+ * the statistics were last reset.
+ */
+struct NXH5SUPPORT_EXPORT CacheStats
+{
+  double metadataHitRate = 0.0;
+  size_t metadataMaxSize = 0;
+  size_t metadataMinCleanSize = 0;
+  size_t metadataCurrentSize = 0;
+  uint32_t metadataNumEntries = 0;
+  bool pageBufferEnabled = false;
+  // Page buffer counters are only set when the page buffer is enabled.
+  // Index 0 counts metadata pages and index 1 raw data pages.
+  std::array<uint32_t, 2> pageAccesses{};
+  std::array<uint32_t, 2> pageHits{};
+  std::array<uint32_t, 2> pageMisses{};
+  std::array<uint32_t, 2> pageEvictions{};
+  std::array<uint32_t, 2> pageBypasses{};
+};
+
+/**
+ * @brief Reads the cache statistics of an open file.
+ * @param fileId
+ * @return Result<CacheStats>
+ */
+Common::Result<CacheStats> NXH5SUPPORT_EXPORT ReadCacheStats(IdType fileId);
+
+/**
+ * @brief Counters of a single file. File opens and closes only appear in
+ * the totals, every other operation is also attributed to the path of the
+ * dataset or group it was called on. Attribute operations are attributed to
+ * the object owning the attribute.
+ */
+struct NXH5SUPPORT_EXPORT FileCounters
+{
+  Counters totals;
+  std::map<std::string, Counters> objects;
+  std::optional<CacheStats> cacheStats; // Set if the file was open when the snapshot was taken
+};
+
+/**
+ * @brief Copy of the counters at the time it was taken, keyed by file name.
+ */
+struct NXH5SUPPORT_EXPORT Snapshot
+{
+  std::map<std::string, FileCounters> files;
+
+  /**
+   * @brief Returns the counters summed over every file.
+   * @return Counters
+   */
+  Counters totals() const;
+
+  /**
+   * @brief Returns the snapshot as a JSON document. Operations without any
+   * calls are omitted.
+   * @param indent Indentation passed to the JSON writer, -1 for compact output
+   * @return std::string
+   */
+  std::string toJson(int32_t indent = 2) const;
+};
+
+/**
+ * @brief Returns true if the library was built with instrumentation hooks.
+ * @return bool
+ */
+bool NXH5SUPPORT_EXPORT IsCompiledIn();
+
+/**
+ * @brief Starts or stops recording. Recording is off by default.
+ * @param enabled
+ */
+void NXH5SUPPORT_EXPORT SetEnabled(bool enabled);
+
+/**
+ * @brief Returns true while counters are being recorded.
+ * @return bool
+ */
+bool NXH5SUPPORT_EXPORT IsEnabled();
+
+/**
+ * @brief Returns a copy of the counters recorded so far, together with the
+ * cache statistics of every open file.
+ * @return Snapshot
+ */
+Snapshot NXH5SUPPORT_EXPORT TakeSnapshot();
+
+/**
+ * @brief Discards every recorded counter.
+ */
+void NXH5SUPPORT_EXPORT Reset();
+
+/**
+ * @brief Times an instrumented call for its lifetime and records it on
+ * destruction, in the counters and as a Tracing span. The file and object
+ * names are looked up when the object ID is known, so close operations must
+ * pass the ID before it is released. Does nothing unless recording or tracing
+ * was enabled when the scope was created.
+ */
+class NXH5SUPPORT_EXPORT Scope
+{
+public:
+  Scope(Operation operation, IdType objectId);
+  ~Scope();
+
+  Scope(const Scope&) = delete;
+  Scope& operator=(const Scope&) = delete;
+
+  /**
+   * @brief Sets the object the call operates on, for calls that open or
+   * create it.
+   * @param objectId
+   */
+  void setObjectId(IdType objectId);
+
+  /**
+   * @brief Adds to the number of bytes moved by the call.
+   * @param numBytes
+   */
+  void addBytes(uint64_t numBytes)
+  {
+    m_Bytes += numBytes;
+  }
+
+  /**
+   * @brief Marks the call as converting if the file type differs from the
+   * memory type in class, size or sign.
+   * @param fileType
+   * @param memoryTypeId
+   */
+  void setConversion(Type fileType, IdType memoryTypeId);
+
+  /**
+   * @brief Runs every chunk of the dataset through its chunk cache model, as
+   * a whole-dataset read or write does.
+   * @param dataset
+   */
+  void accessAllChunks(const DatasetIO& dataset);
+
+private:
+  bool m_Active = false;
+  bool m_Counting = false;
+  bool m_Tracing = false;
+  bool m_Converted = false;
+  Operation m_Operation;
+  IdType m_ObjectId = 0;
+  uint64_t m_Bytes = 0;
+  EstimatedChunkCacheCounters m_EstimatedChunkCache;
+  std::string m_FileName;
+  std::string m_ObjectPath;
+  std::chrono::steady_clock::time_point m_Start;
+  std::chrono::steady_clock::duration m_Excluded{0};
+};
+} // namespace NX::H5Support::Instrumentation
+
+#ifdef H5Support_USE_INSTRUMENTATION
+#define H5SUPPORT_INSTRUMENT(operation, objectId) NX::H5Support::Instrumentation::Scope _h5SupportInstrumentation(NX::H5Support::Instrumentation::Operation::operation, objectId);
+#define H5SUPPORT_INSTRUMENT_OBJECT(objectId) _h5SupportInstrumentation.setObjectId(objectId);
+#define H5SUPPORT_INSTRUMENT_BYTES(numBytes) _h5SupportInstrumentation.addBytes(numBytes);
+#define H5SUPPORT_INSTRUMENT_CONVERSION(fileType, memoryTypeId) _h5SupportInstrumentation.setConversion(fileType, memoryTypeId);
+#define H5SUPPORT_INSTRUMENT_CHUNK_CACHE(dataset) _h5SupportInstrumentation.accessAllChunks(dataset);
+#else
+#define H5SUPPORT_INSTRUMENT(operation, objectId)
+#define H5SUPPORT_INSTRUMENT_OBJECT(objectId)
+#define H5SUPPORT_INSTRUMENT_BYTES(numBytes)
+#define H5SUPPORT_INSTRUMENT_CONVERSION(fileType, memoryTypeId)
+#define H5SUPPORT_INSTRUMENT_CHUNK_CACHE(dataset)
+#endif
@@ -13,12 +13,16 @@ AttributeReader::AttributeReader() = default;
 AttributeReader::AttributeReader(IdType objectId, size_t attrIdx)
 : m_ObjectId(objectId)
 {
+  H5SUPPORT_MUTEX_LOCK()
+
   m_AttributeId = H5Aopen_idx(objectId, attrIdx);
 }
 
 AttributeReader::AttributeReader(IdType objectId, const std::string& attrName)
 : m_ObjectId(objectId)
 {
+  H5SUPPORT_MUTEX_LOCK()
+
   m_AttributeId = H5Aopen(objectId, attrName.c_str(), H5P_DEFAULT);
 }
 
@@ -29,6 +33,8 @@ AttributeReader::~AttributeReader() noexcept
 
 void AttributeReader::closeHdf5()
 {
+  H5SUPPORT_MUTEX_LOCK()
+
   if(isValid())
   {
     H5Aclose(m_AttributeId);
@@ -53,11 +59,15 @@ IdType AttributeReader::getAttributeId() const
 
 IdType AttributeReader::getDataspaceId() const
 {
+  H5SUPPORT_MUTEX_LOCK()
+
   return H5Aget_space(getAttributeId());
 }
 
 std::string AttributeReader::getName() const
 {
+  H5SUPPORT_MUTEX_LOCK()
+
   if(!isValid())
   {
     return "";
@@ -77,17 +87,23 @@ Type AttributeReader::getType() const
 
 IdType AttributeReader::getClassType() const
 {
+  H5SUPPORT_MUTEX_LOCK()
+
   auto typeId = getTypeId();
   return H5Tget_class(typeId);
 }
 
 IdType AttributeReader::getTypeId() const
 {
+  H5SUPPORT_MUTEX_LOCK()
+
   return H5Aget_type(getAttributeId());
 }
 
 size_t AttributeReader::getNumElements() const
 {
+  H5SUPPORT_MUTEX_LOCK()
+
   size_t typeSize = H5Tget_size(getTypeId());
   std::vector<hsize_t> dims;
   hid_t dataspaceId = getDataspaceId();
@@ -146,6 +162,8 @@ T AttributeReader::readAsValue() const
 
 std::string AttributeReader::readAsString() const
 {
+  H5SUPPORT_MUTEX_LOCK()
+
   if(!isValid())
   {
     return "";
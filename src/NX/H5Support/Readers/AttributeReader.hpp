@@ -7,6 +7,7 @@
 #include <H5Apublic.h>
 
 #include "NX/H5Support/H5.hpp"
+#include "NX/H5Support/H5Support.hpp"
 
 #include "NX/H5Support/NXH5SUPPORT_EXPORT.hpp"
 
@@ -121,6 +122,8 @@ public:
   template <typename T>
   std::vector<T> readAsVector() const
   {
+    H5SUPPORT_MUTEX_LOCK()
+
     if(!isValid())
     {
       return {};
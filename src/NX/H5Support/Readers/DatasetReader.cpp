@@ -12,12 +12,22 @@ using namespace NX::Common;
 
 namespace NX::H5Support
 {
+namespace
+{
+IdType openDatasetId(IdType parentId, const std::string& dataName)
+{
+  H5SUPPORT_MUTEX_LOCK()
+
+  return H5Dopen(parentId, dataName.c_str(), H5P_DEFAULT);
+}
+} // namespace
+
 DatasetReader::DatasetReader()
 {
 }
 
 DatasetReader::DatasetReader(IdType parentId, const std::string& dataName)
-: ObjectReader(parentId, H5Dopen(parentId, dataName.c_str(), H5P_DEFAULT))
+: ObjectReader(parentId, openDatasetId(parentId, dataName))
 {
 }
 
@@ -28,6 +38,8 @@ DatasetReader::~DatasetReader()
 
 void DatasetReader::closeHdf5()
 {
+  H5SUPPORT_MUTEX_LOCK()
+
   if(isValid())
   {
     H5Dclose(getId());
@@ -37,6 +49,8 @@ void DatasetReader::closeHdf5()
 
 IdType DatasetReader::getDataspaceId() const
 {
+  H5SUPPORT_MUTEX_LOCK()
+
   return H5Dget_space(getId());
 }
 
@@ -48,6 +62,8 @@ Type DatasetReader::getType() const
 
 IdType DatasetReader::getClassType() const
 {
+  H5SUPPORT_MUTEX_LOCK()
+
   auto typeId = getTypeId();
   return H5Tget_class(typeId);
 }
@@ -85,12 +101,16 @@ Result<Type> DatasetReader::getDataType() const
 
 IdType DatasetReader::getTypeId() const
 {
+  H5SUPPORT_MUTEX_LOCK()
+
   auto identifier = getId();
   return H5Dget_type(identifier);
 }
 
 size_t DatasetReader::getTypeSize() const
 {
+  H5SUPPORT_MUTEX_LOCK()
+
   return H5Tget_size(getTypeId());
 }
 
@@ -103,6 +123,8 @@ size_t DatasetReader::getNumElements() const
 
 std::string DatasetReader::readAsString() const
 {
+  H5SUPPORT_MUTEX_LOCK()
+
   if(!isValid())
   {
     return "";
@@ -152,6 +174,8 @@ std::string DatasetReader::readAsString() const
 
 std::vector<std::string> DatasetReader::readAsVectorOfStrings() const
 {
+  H5SUPPORT_MUTEX_LOCK()
+
   if(!isValid())
   {
     return {};
@@ -244,16 +268,14 @@ std::vector<T> DatasetReader::readAsVector() const
 template <class T>
 bool DatasetReader::readIntoSpan(nonstd::span<T> data) const
 {
+  H5SUPPORT_MUTEX_LOCK()
+
   if(!isValid())
   {
     return false;
   }
 
   hid_t dataType = Support::HdfTypeForPrimitive<T>();
-  if(dataType == -1)
-  {
-    return false;
-  }
 
   auto spaceId = getDataspaceId();
   if(spaceId > 0)
@@ -289,6 +311,8 @@ bool DatasetReader::readIntoSpan(nonstd::span<T> data) const
 
 std::vector<hsize_t> DatasetReader::getDimensions() const
 {
+  H5SUPPORT_MUTEX_LOCK()
+
   std::vector<hsize_t> dims;
   auto dataspaceId = getDataspaceId();
   if(dataspaceId >= 0)
@@ -6,8 +6,8 @@
 
 namespace NX::H5Support
 {
-FileReader::FileReader(const std::filesystem::path& filepath)
-: GroupReader(0, H5Fopen(filepath.string().c_str(), H5F_ACC_RDONLY, H5P_DEFAULT))
+FileReader::FileReader(const std::filesystem::path& filepath, const FileOptions& options)
+: GroupReader(0, OpenHdf5File(filepath, H5F_ACC_RDONLY, options))
 {
 }
 
@@ -23,6 +23,8 @@ FileReader::~FileReader()
 
 void FileReader::closeHdf5()
 {
+  H5SUPPORT_MUTEX_LOCK()
+
   if(isValid())
   {
     H5Fclose(getId());
@@ -32,6 +34,8 @@ void FileReader::closeHdf5()
 
 std::string FileReader::getName() const
 {
+  H5SUPPORT_MUTEX_LOCK()
+
   if(!isValid())
   {
     return "";
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "NX/H5Support/IO/FileOptions.hpp"
 #include "NX/H5Support/NXH5SUPPORT_EXPORT.hpp"
 #include "NX/H5Support/Readers/GroupReader.hpp"
 
@@ -16,8 +17,9 @@ public:
    * filepath. The constructed object will be invalid if the HDF5 file cannot
    * be found or openned.
    * @param filepath
+   * @param options
    */
-  FileReader(const std::filesystem::path& filepath);
+  FileReader(const std::filesystem::path& filepath, const FileOptions& options = {});
 
   /**
    * @brief Constructs a FileReader wrapping the target HDF5 file ID. The
@@ -9,10 +9,20 @@
 
 namespace NX::H5Support
 {
+namespace
+{
+IdType openGroupId(IdType parentId, const std::string& groupName)
+{
+  H5SUPPORT_MUTEX_LOCK()
+
+  return H5Gopen(parentId, groupName.c_str(), H5P_DEFAULT);
+}
+} // namespace
+
 GroupReader::GroupReader() = default;
 
 GroupReader::GroupReader(IdType parentId, const std::string& groupName)
-: ObjectReader(parentId, H5Gopen(parentId, groupName.c_str(), H5P_DEFAULT))
+: ObjectReader(parentId, openGroupId(parentId, groupName))
 {
 }
 
@@ -28,6 +38,8 @@ GroupReader::~GroupReader()
 
 void GroupReader::closeHdf5()
 {
+  H5SUPPORT_MUTEX_LOCK()
+
   if(isValid())
   {
     H5Gclose(getId());
@@ -67,6 +79,8 @@ ObjectReader GroupReader::openObject(const std::string& name) const
 
 size_t GroupReader::getNumChildren() const
 {
+  H5SUPPORT_MUTEX_LOCK()
+
   if(!isValid())
   {
     return 0;
@@ -83,6 +97,8 @@ size_t GroupReader::getNumChildren() const
 
 std::vector<std::string> GroupReader::getChildNames() const
 {
+  H5SUPPORT_MUTEX_LOCK()
+
   std::vector<std::string> childNames;
   if(!isValid())
   {
@@ -107,6 +123,8 @@ std::vector<std::string> GroupReader::getChildNames() const
 
 bool GroupReader::isGroup(const std::string& childName) const
 {
+  H5SUPPORT_MUTEX_LOCK()
+
   if(!isValid())
   {
     return false;
@@ -139,6 +157,8 @@ bool GroupReader::isGroup(const std::string& childName) const
 
 bool GroupReader::isDataset(const std::string& childName) const
 {
+  H5SUPPORT_MUTEX_LOCK()
+
   if(!isValid())
   {
     return false;
@@ -22,6 +22,8 @@ ObjectReader::ObjectReader(IdType parentId, IdType objectId)
 ObjectReader::ObjectReader(IdType parentId, const std::string& targetName)
 : m_ParentId(parentId)
 {
+  H5SUPPORT_MUTEX_LOCK()
+
   m_Id = H5Oopen(parentId, targetName.c_str(), H5P_DEFAULT);
 }
 
@@ -32,6 +34,8 @@ ObjectReader::~ObjectReader() noexcept
 
 void ObjectReader::closeHdf5()
 {
+  H5SUPPORT_MUTEX_LOCK()
+
   if(isValid())
   {
     H5Oclose(m_Id);
@@ -51,6 +55,8 @@ IdType ObjectReader::getParentId() const
 
 haddr_t ObjectReader::getObjectId() const
 {
+  H5SUPPORT_MUTEX_LOCK()
+
   if(!isValid())
   {
     return 0;
@@ -85,6 +91,8 @@ std::string ObjectReader::getName() const
 
 size_t ObjectReader::getNumAttributes() const
 {
+  H5SUPPORT_MUTEX_LOCK()
+
   if(!isValid())
   {
     return 0;
@@ -0,0 +1,311 @@
+#include "Tracing.hpp"
+
+#include <fmt/format.h>
+#include <nlohmann/json.hpp>
+
+#ifdef _WIN32
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+#ifdef __linux__
+#include <sys/syscall.h>
+#endif
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+using namespace NX::Common;
+
+namespace NX::H5Support::Tracing
+{
+namespace
+{
+/**
+ * @brief A recorded call. The file name and object path are indices into the
+ * recording thread's string table.
+ */
+struct Span
+{
+  Instrumentation::Operation operation = Instrumentation::Operation::Open;
+  uint32_t fileName = 0;
+  uint32_t objectPath = 0;
+  uint64_t bytes = 0;
+  int64_t startNanoseconds = 0;
+  int64_t durationNanoseconds = 0;
+};
+
+/**
+ * @brief Fixed block of spans. Only the owning thread writes spans and
+ * publishes them by incrementing count, so readers never see a partially
+ * written span.
+ */
+struct SpanBlock
+{
+  static constexpr size_t k_Capacity = 1024;
+
+  std::array<Span, k_Capacity> spans;
+  std::atomic<size_t> count = 0;
+  std::atomic<SpanBlock*> next = nullptr;
+};
+
+/**
+ * @brief Spans recorded by a single thread. The buffer is shared with the
+ * registry so that spans outlive the thread. File names and object paths are
+ * interned per thread, so appending a span only copies a string the first
+ * time the thread sees it.
+ */
+class ThreadBuffer
+{
+public:
+  explicit ThreadBuffer(uint64_t threadId)
+  : m_ThreadId(threadId)
+  , m_Head(std::make_unique<SpanBlock>())
+  , m_Tail(m_Head.get())
+  {
+  }
+
+  ~ThreadBuffer()
+  {
+    releaseBlocks();
+  }
+
+  ThreadBuffer(const ThreadBuffer&) = delete;
+  ThreadBuffer& operator=(const ThreadBuffer&) = delete;
+
+  uint64_t getThreadId() const
+  {
+    return m_ThreadId;
+  }
+
+  /**
+   * @brief Appends the span with the given names unless tracing was stopped.
+   * Only called by the owning thread.
+   */
+  void append(Span&& span, const std::string& fileName, const std::string& objectPath, const std::atomic<bool>& tracing)
+  {
+    // Start() waits for m_Writing to clear before discarding spans, and a
+    // writer that raises it afterwards sees tracing stopped.
+    m_Writing.store(true);
+    if(tracing.load())
+    {
+      span.fileName = intern(fileName);
+      span.objectPath = intern(objectPath);
+      size_t count = m_Tail->count.load(std::memory_order_relaxed);
+      if(count == SpanBlock::k_Capacity)
+      {
+        auto* block = new SpanBlock();
+        m_Tail->next.store(block, std::memory_order_release);
+        m_Tail = block;
+        count = 0;
+      }
+      m_Tail->spans[count] = std::move(span);
+      m_Tail->count.store(count + 1, std::memory_order_release);
+    }
+    m_Writing.store(false, std::memory_order_release);
+  }
+
+  /**
+   * @brief Discards every span. Called with tracing stopped and the registry
+   * locked.
+   */
+  void clear()
+  {
+    while(m_Writing.load())
+    {
+      std::this_thread::yield();
+    }
+    releaseBlocks();
+    m_Head->count.store(0);
+    m_Tail = m_Head.get();
+    std::lock_guard<std::mutex> lock(m_StringsMutex);
+    m_Strings.clear();
+    m_StringIds.clear();
+  }
+
+  /**
+   * @brief Calls func for every published span along with its file name and
+   * object path. Called with the registry locked.
+   */
+  template <typename Func>
+  void forEach(Func&& func) const
+  {
+    std::lock_guard<std::mutex> lock(m_StringsMutex);
+    for(const SpanBlock* block = m_Head.get(); block != nullptr; block = block->next.load(std::memory_order_acquire))
+    {
+      const size_t count = block->count.load(std::memory_order_acquire);
+      for(size_t i = 0; i < count; i++)
+      {
+        const Span& span = block->spans[i];
+        func(span, m_Strings[span.fileName], m_Strings[span.objectPath]);
+      }
+    }
+  }
+
+private:
+  /**
+   * @brief Returns the index of text in the string table, adding it if
+   * needed. Only the owning thread modifies the table, so lookups need no
+   * lock.
+   */
+  uint32_t intern(const std::string& text)
+  {
+    auto iter = m_StringIds.find(text);
+    if(iter != m_StringIds.end())
+    {
+      return iter->second;
+    }
+    std::lock_guard<std::mutex> lock(m_StringsMutex);
+    const auto id = static_cast<uint32_t>(m_Strings.size());
+    m_Strings.push_back(text);
+    m_StringIds.emplace(text, id);
+    return id;
+  }
+
+  void releaseBlocks()
+  {
+    SpanBlock* block = m_Head->next.exchange(nullptr);
+    while(block != nullptr)
+    {
+      SpanBlock* next = block->next.load();
+      delete block;
+      block = next;
+    }
+  }
+
+  uint64_t m_ThreadId = 0;
+  std::unique_ptr<SpanBlock> m_Head;
+  SpanBlock* m_Tail = nullptr;
+  std::atomic<bool> m_Writing = false;
+  mutable std::mutex m_StringsMutex;
+  std::vector<std::string> m_Strings;
+  std::unordered_map<std::string, uint32_t> m_StringIds;
+};
+
+std::atomic<bool> s_Tracing = false;
+
+std::mutex& registryMutex()
+{
+  static std::mutex mutex;
+  return mutex;
+}
+
+std::vector<std::shared_ptr<ThreadBuffer>>& registeredBuffers()
+{
+  static std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+  return buffers;
+}
+
+int64_t processId()
+{
+#ifdef _WIN32
+  return _getpid();
+#else
+  return getpid();
+#endif
+}
+
+uint64_t currentThreadId()
+{
+#ifdef __linux__
+  return static_cast<uint64_t>(::syscall(SYS_gettid));
+#else
+  static std::atomic<uint64_t> s_NextThreadId = 1;
+  return s_NextThreadId++;
+#endif
+}
+
+ThreadBuffer& threadBuffer()
+{
+  thread_local std::shared_ptr<ThreadBuffer> buffer;
+  if(buffer == nullptr)
+  {
+    buffer = std::make_shared<ThreadBuffer>(currentThreadId());
+    std::lock_guard<std::mutex> lock(registryMutex());
+    registeredBuffers().push_back(buffer);
+  }
+  return *buffer;
+}
+} // namespace
+
+void Start()
+{
+  std::lock_guard<std::mutex> lock(registryMutex());
+  s_Tracing = false;
+  // Buffers only held by the registry belong to threads that exited. Their
+  // spans are discarded here anyway, so the buffers are dropped as well.
+  auto& buffers = registeredBuffers();
+  buffers.erase(std::remove_if(buffers.begin(), buffers.end(), [](const std::shared_ptr<ThreadBuffer>& buffer) { return buffer.use_count() == 1; }), buffers.end());
+  for(const auto& buffer : buffers)
+  {
+    buffer->clear();
+  }
+  s_Tracing = true;
+}
+
+void Stop()
+{
+  s_Tracing = false;
+}
+
+bool IsActive()
+{
+  return s_Tracing;
+}
+
+std::string ToJson()
+{
+  const int64_t pid = processId();
+  nlohmann::json events = nlohmann::json::array();
+  std::lock_guard<std::mutex> lock(registryMutex());
+  for(const auto& buffer : registeredBuffers())
+  {
+    buffer->forEach([&](const Span& span, const std::string& fileName, const std::string& objectPath) {
+      nlohmann::json event;
+      event["name"] = Instrumentation::OperationName(span.operation);
+      event["cat"] = "H5Support";
+      event["ph"] = "X";
+      event["ts"] = static_cast<double>(span.startNanoseconds) / 1000.0;
+      event["dur"] = static_cast<double>(span.durationNanoseconds) / 1000.0;
+      event["pid"] = pid;
+      event["tid"] = buffer->getThreadId();
+      event["args"] = {{"file", fileName}, {"path", objectPath}, {"bytes", span.bytes}};
+      events.push_back(std::move(event));
+    });
+  }
+
+  nlohmann::json trace;
+  trace["traceEvents"] = std::move(events);
+  trace["displayTimeUnit"] = "ms";
+  return trace.dump();
+}
+
+Result<> Write(const std::filesystem::path& filepath)
+{
+  std::ofstream traceFile(filepath, std::ios::trunc);
+  traceFile << ToJson();
+  if(!traceFile)
+  {
+    return MakeErrorResult(-340, fmt::format("Error writing trace file '{}'.", filepath.string()));
+  }
+  return {};
+}
+
+void RecordSpan(Instrumentation::Operation operation, const std::string& fileName, const std::string& objectPath, uint64_t bytes, std::chrono::steady_clock::time_point start,
+                std::chrono::steady_clock::time_point end)
+{
+  Span span;
+  span.operation = operation;
+  span.bytes = bytes;
+  span.startNanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(start.time_since_epoch()).count();
+  span.durationNanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+  threadBuffer().append(std::move(span), fileName, objectPath, s_Tracing);
+}
+} // namespace NX::H5Support::Tracing
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "NX/H5Support/Instrumentation.hpp"
+#include "NX/H5Support/NXH5SUPPORT_EXPORT.hpp"
+
+#include "NX/Common/Result.hpp"
+
+#include <chrono>
+#include <filesystem>
+#include <string>
+
+/**
+ * Timeline tracing of the operations hooked by H5SUPPORT_INSTRUMENT. Each
+ * call becomes a Chrome trace-event span tagged with the calling thread, the
+ * file, the object path and the bytes moved, which can be loaded into
+ * chrome://tracing or Perfetto. Timestamps are steady_clock microseconds, the
+ * monotonic clock used by most tracers, so traces line up with application
+ * traces taken on the same machine. Tracing requires
+ * NXH5SUPPORT_ENABLE_INSTRUMENTATION, otherwise no spans are recorded.
+ *
+ * Spans are appended to a buffer owned by the calling thread without taking
+ * a lock. Only starting a trace, collecting it, a thread's first span and
+ * the first span naming a new file or object path synchronize with other
+ * threads. The buffers of threads that exited are released by Start().
+ */
+namespace NX::H5Support::Tracing
+{
+/**
+ * @brief Discards previously recorded spans and starts recording. Waits for
+ * spans that are being appended to finish.
+ */
+void NXH5SUPPORT_EXPORT Start();
+
+/**
+ * @brief Stops recording. Recorded spans are kept until the next Start().
+ */
+void NXH5SUPPORT_EXPORT Stop();
+
+/**
+ * @brief Returns true while spans are being recorded.
+ * @return bool
+ */
+bool NXH5SUPPORT_EXPORT IsActive();
+
+/**
+ * @brief Returns the recorded spans as a Chrome trace-event JSON document.
+ * Can be called while recording, spans still being appended are omitted.
+ * @return std::string
+ */
+std::string NXH5SUPPORT_EXPORT ToJson();
+
+/**
+ * @brief Writes ToJson() to the given file.
+ * @param filepath
+ * @return Result<>
+ */
+Common::Result<> NXH5SUPPORT_EXPORT Write(const std::filesystem::path& filepath);
+
+/**
+ * @brief Appends a span to the calling thread's buffer. Called by
+ * Instrumentation::Scope.
+ * @param operation
+ * @param fileName
+ * @param objectPath
+ * @param bytes
+ * @param start
+ * @param end
+ */
+void NXH5SUPPORT_EXPORT RecordSpan(Instrumentation::Operation operation, const std::string& fileName, const std::string& objectPath, uint64_t bytes, std::chrono::steady_clock::time_point start,
+                                   std::chrono::steady_clock::time_point end);
+} // namespace NX::H5Support::Tracing
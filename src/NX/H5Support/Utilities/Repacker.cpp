@@ -0,0 +1,852 @@
+#include "Repacker.hpp"
+
+#include "NX/H5Support/H5Support.hpp"
+#include "NX/H5Support/IO/FileIO.hpp"
+
+#include <fmt/format.h>
+
+#include <zlib.h>
+
+#ifdef NXCOMMON_ENABLE_MULTICORE
+#include <tbb/parallel_for.h>
+#include <tbb/task_arena.h>
+#endif
+
+#include <algorithm>
+#include <array>
+#include <iostream>
+#include <numeric>
+#include <unordered_map>
+#include <unordered_set>
+
+using namespace NX::Common;
+
+namespace NX::H5Support
+{
+namespace
+{
+/**
+ * @brief A link found while visiting the source file.
+ */
+struct LinkRecord
+{
+  std::string path;
+  H5L_type_t linkType = H5L_TYPE_ERROR;
+  haddr_t address = HADDR_UNDEF;
+  H5O_type_t objectType = H5O_TYPE_UNKNOWN;
+  size_t valueSize = 0;
+};
+
+/**
+ * @brief H5Lvisit operator that records every link below the root.
+ */
+herr_t collectLink(hid_t rootId, const char* name, const H5L_info_t* info, void* operatorData)
+{
+  auto& links = *static_cast<std::vector<LinkRecord>*>(operatorData);
+  LinkRecord link;
+  link.path = name;
+  link.linkType = info->type;
+  if(info->type == H5L_TYPE_HARD)
+  {
+    link.address = info->u.address;
+    H5O_info_t objectInfo;
+    if(H5Oget_info_by_name2(rootId, name, &objectInfo, H5O_INFO_BASIC, H5P_DEFAULT) < 0)
+    {
+      return -1;
+    }
+    link.objectType = objectInfo.type;
+  }
+  else
+  {
+    link.valueSize = info->u.val_size;
+  }
+  links.push_back(std::move(link));
+  return 0;
+}
+
+bool hasVariableData(hid_t typeId)
+{
+  return H5Tdetect_class(typeId, H5T_VLEN) > 0 || H5Tis_variable_str(typeId) > 0;
+}
+
+/**
+ * @brief H5Aiterate operator that copies each attribute to the object whose
+ * ID is passed as the operator data. Reference attributes are skipped since
+ * they cannot point into the target file.
+ */
+herr_t copyAttribute(hid_t locationId, const char* name, const H5A_info_t* /*info*/, void* operatorData)
+{
+  const hid_t targetId = *static_cast<hid_t*>(operatorData);
+  hid_t attributeId = H5Aopen(locationId, name, H5P_DEFAULT);
+  if(attributeId < 0)
+  {
+    return -1;
+  }
+
+  // Copying the type detaches it from any committed datatype in the source.
+  hid_t typeId = H5Aget_type(attributeId);
+  hid_t memoryTypeId = H5Tcopy(typeId);
+  hid_t dataspaceId = H5Aget_space(attributeId);
+  herr_t error = 0;
+  if(H5Tdetect_class(memoryTypeId, H5T_REFERENCE) > 0)
+  {
+    std::cout << "Skipping Reference Attribute '" << name << "'" << std::endl;
+  }
+  else
+  {
+    const hssize_t numElements = std::max<hssize_t>(H5Sget_simple_extent_npoints(dataspaceId), 1);
+    std::vector<uint8_t> buffer(static_cast<size_t>(numElements) * H5Tget_size(memoryTypeId));
+    error = H5Aread(attributeId, memoryTypeId, buffer.data());
+    if(error >= 0)
+    {
+      hid_t targetAttributeId = H5Acreate2(targetId, name, memoryTypeId, dataspaceId, H5P_DEFAULT, H5P_DEFAULT);
+      error = targetAttributeId < 0 ? -1 : H5Awrite(targetAttributeId, memoryTypeId, buffer.data());
+      if(targetAttributeId >= 0)
+      {
+        H5Aclose(targetAttributeId);
+      }
+      if(hasVariableData(memoryTypeId))
+      {
+        H5Dvlen_reclaim(memoryTypeId, dataspaceId, H5P_DEFAULT, buffer.data());
+      }
+    }
+  }
+  H5Sclose(dataspaceId);
+  H5Tclose(memoryTypeId);
+  H5Tclose(typeId);
+  H5Aclose(attributeId);
+  return error < 0 ? -1 : 0;
+}
+
+herr_t copyAttributes(hid_t sourceId, hid_t targetId)
+{
+  return H5Aiterate2(sourceId, H5_INDEX_NAME, H5_ITER_INC, nullptr, copyAttribute, &targetId);
+}
+
+/**
+ * @brief The filters of a dataset creation property list, in pipeline order.
+ * The pipeline is supported if it only uses filters the repacker encodes and
+ * decodes itself.
+ */
+struct Pipeline
+{
+  struct Filter
+  {
+    H5Z_filter_t id = H5Z_FILTER_NONE;
+    int32_t level = 0;
+  };
+
+  std::vector<Filter> filters;
+  bool supported = true;
+};
+
+Pipeline readPipeline(hid_t plistId)
+{
+  Pipeline pipeline;
+  const int32_t numFilters = H5Pget_nfilters(plistId);
+  for(int32_t i = 0; i < numFilters; i++)
+  {
+    unsigned flags = 0;
+    size_t numValues = 8;
+    std::array<unsigned, 8> values{};
+    unsigned filterConfig = 0;
+    Pipeline::Filter filter;
+    filter.id = H5Pget_filter2(plistId, i, &flags, &numValues, values.data(), 0, nullptr, &filterConfig);
+    if(filter.id == H5Z_FILTER_DEFLATE)
+    {
+      filter.level = numValues > 0 ? static_cast<int32_t>(values[0]) : Z_DEFAULT_COMPRESSION;
+    }
+    else if(filter.id != H5Z_FILTER_SHUFFLE)
+    {
+      pipeline.supported = false;
+    }
+    pipeline.filters.push_back(filter);
+  }
+  return pipeline;
+}
+
+/**
+ * @brief Byte shuffle matching the HDF5 shuffle filter: byte j of element i
+ * moves to position j * numElements + i.
+ */
+void shuffleBytes(const std::vector<uint8_t>& source, std::vector<uint8_t>& target, size_t typeSize, bool unshuffle)
+{
+  target.resize(source.size());
+  const size_t numElements = source.size() / typeSize;
+  for(size_t i = 0; i < numElements; i++)
+  {
+    for(size_t j = 0; j < typeSize; j++)
+    {
+      const size_t shuffled = j * numElements + i;
+      const size_t element = i * typeSize + j;
+      target[unshuffle ? element : shuffled] = source[unshuffle ? shuffled : element];
+    }
+  }
+  const size_t tail = numElements * typeSize;
+  std::copy(source.begin() + tail, source.end(), target.begin() + tail);
+}
+
+/**
+ * @brief Reverses the pipeline on an encoded chunk, skipping the filters
+ * marked in filterMask. Returns false if the chunk cannot be decoded.
+ */
+bool decodeChunk(const Pipeline& pipeline, unsigned filterMask, size_t typeSize, size_t chunkBytes, std::vector<uint8_t>& buffer, std::vector<uint8_t>& scratch)
+{
+  for(size_t i = pipeline.filters.size(); i-- > 0;)
+  {
+    if((filterMask & (1u << i)) != 0)
+    {
+      continue;
+    }
+    if(pipeline.filters[i].id == H5Z_FILTER_DEFLATE)
+    {
+      scratch.resize(chunkBytes);
+      uLongf numBytes = static_cast<uLongf>(scratch.size());
+      if(uncompress(scratch.data(), &numBytes, buffer.data(), static_cast<uLong>(buffer.size())) != Z_OK)
+      {
+        return false;
+      }
+      scratch.resize(numBytes);
+    }
+    else
+    {
+      shuffleBytes(buffer, scratch, typeSize, true);
+    }
+    buffer.swap(scratch);
+  }
+  return buffer.size() == chunkBytes;
+}
+
+/**
+ * @brief Applies the pipeline to a decoded chunk. Returns false if the chunk
+ * cannot be encoded.
+ */
+bool encodeChunk(const Pipeline& pipeline, size_t typeSize, std::vector<uint8_t>& buffer, std::vector<uint8_t>& scratch)
+{
+  for(const auto& filter : pipeline.filters)
+  {
+    if(filter.id == H5Z_FILTER_DEFLATE)
+    {
+      scratch.resize(compressBound(static_cast<uLong>(buffer.size())));
+      uLongf numBytes = static_cast<uLongf>(scratch.size());
+      if(compress2(scratch.data(), &numBytes, buffer.data(), static_cast<uLong>(buffer.size()), filter.level) != Z_OK)
+      {
+        return false;
+      }
+      scratch.resize(numBytes);
+    }
+    else
+    {
+      shuffleBytes(buffer, scratch, typeSize, false);
+    }
+    buffer.swap(scratch);
+  }
+  return true;
+}
+
+/**
+ * @brief A chunk moving through a batch. Offsets are element coordinates of
+ * the chunk's first element.
+ */
+struct ChunkJob
+{
+  std::vector<hsize_t> offset;
+  std::vector<uint8_t> buffer;
+  std::vector<uint8_t> scratch;
+  unsigned filterMask = 0;
+  bool skip = false;
+  bool failed = false;
+};
+
+/**
+ * @brief Shared state of a single repack call.
+ */
+class RepackContext
+{
+public:
+  RepackContext(const Repacker::Options& options, hid_t sourceId, hid_t targetId)
+  : m_Options(options)
+  , m_SourceId(sourceId)
+  , m_TargetId(targetId)
+#ifdef NXCOMMON_ENABLE_MULTICORE
+  , m_Arena(options.numThreads == 0 ? static_cast<int>(tbb::task_arena::automatic) : static_cast<int>(options.numThreads))
+#endif
+  {
+  }
+
+  /**
+   * @brief Runs func(i) for every i in [0, count) on the repack's threads.
+   */
+  template <typename FuncT>
+  void parallelFor(size_t count, const FuncT& func)
+  {
+#ifdef NXCOMMON_ENABLE_MULTICORE
+    m_Arena.execute([&]() { tbb::parallel_for(static_cast<size_t>(0), count, func); });
+#else
+    for(size_t i = 0; i < count; i++)
+    {
+      func(i);
+    }
+#endif
+  }
+
+  const Repacker::DatasetSettings& getSettings(const std::string& path) const
+  {
+    auto iter = m_Options.datasetSettings.find(path);
+    return iter != m_Options.datasetSettings.end() ? iter->second : m_Options.defaultSettings;
+  }
+
+  /**
+   * @brief Reports progress. Returns false if the repack was cancelled.
+   */
+  bool report(const std::string& path, uint64_t bytesProcessed, uint64_t bytesTotal)
+  {
+    if(!m_Options.progress)
+    {
+      return true;
+    }
+    Repacker::Progress progress;
+    progress.path = path;
+    progress.datasetIndex = m_DatasetIndex;
+    progress.numDatasets = m_NumDatasets;
+    progress.bytesProcessed = std::min(bytesProcessed, bytesTotal);
+    progress.bytesTotal = bytesTotal;
+    m_Cancelled = !m_Options.progress(progress);
+    return !m_Cancelled;
+  }
+
+  const Repacker::Options& m_Options;
+  hid_t m_SourceId = -1;
+  hid_t m_TargetId = -1;
+  size_t m_DatasetIndex = 0;
+  size_t m_NumDatasets = 0;
+  bool m_Cancelled = false;
+
+private:
+#ifdef NXCOMMON_ENABLE_MULTICORE
+  tbb::task_arena m_Arena;
+#endif
+};
+
+/**
+ * @brief Describes how a dataset's raw data is moved to the target.
+ */
+struct DatasetPlan
+{
+  std::string path;
+  hid_t sourceDatasetId = -1;
+  hid_t targetDatasetId = -1;
+  hid_t memoryTypeId = -1;
+  size_t typeSize = 0;
+  std::vector<hsize_t> dims;
+  std::vector<hsize_t> chunkDims; // Empty for contiguous targets
+  bool sourceChunksMatch = false; // Source chunks have the target chunk shape
+  Pipeline sourcePipeline;
+  Pipeline targetPipeline;
+  bool skipZeroChunks = false;
+};
+
+uint64_t countBytes(const std::vector<hsize_t>& dims, size_t typeSize)
+{
+  return std::accumulate(dims.cbegin(), dims.cend(), static_cast<uint64_t>(typeSize), std::multiplies<>());
+}
+
+/**
+ * @brief Moves the raw data chunk by chunk. Chunks are read serially through
+ * HDF5, either as raw chunks or as decoded hyperslabs, then decoded and
+ * encoded in parallel and stored with H5Dwrite_chunk.
+ */
+bool moveChunks(RepackContext& context, const DatasetPlan& plan)
+{
+  const size_t rank = plan.dims.size();
+  const size_t chunkBytes = countBytes(plan.chunkDims, plan.typeSize);
+  const uint64_t totalBytes = countBytes(plan.dims, plan.typeSize);
+  const bool rawSource = plan.sourceChunksMatch && plan.sourcePipeline.supported;
+
+  std::vector<hsize_t> numChunks(rank);
+  hsize_t totalChunks = 1;
+  for(size_t i = 0; i < rank; i++)
+  {
+    numChunks[i] = (plan.dims[i] + plan.chunkDims[i] - 1) / plan.chunkDims[i];
+    totalChunks *= numChunks[i];
+  }
+
+  hid_t fileSpaceId = H5Dget_space(plan.sourceDatasetId);
+  hid_t memorySpaceId = H5Screate_simple(static_cast<int>(rank), plan.chunkDims.data(), nullptr);
+  const std::vector<hsize_t> zeroOffset(rank, 0);
+  std::vector<hsize_t> count(rank);
+
+  const size_t batchSize = static_cast<size_t>(std::max<uint64_t>(context.m_Options.batchBytes / std::max<size_t>(chunkBytes, 1), 1));
+  std::vector<ChunkJob> jobs(static_cast<size_t>(std::min<hsize_t>(batchSize, totalChunks)));
+  bool success = true;
+  for(hsize_t first = 0; success && first < totalChunks; first += jobs.size())
+  {
+    const size_t numJobs = static_cast<size_t>(std::min<hsize_t>(jobs.size(), totalChunks - first));
+
+    // Read the batch serially
+    for(size_t j = 0; success && j < numJobs; j++)
+    {
+      ChunkJob& job = jobs[j];
+      job.offset.resize(rank);
+      job.skip = false;
+      job.failed = false;
+      job.filterMask = 0;
+      hsize_t remainder = first + j;
+      for(size_t i = rank; i-- > 0;)
+      {
+        job.offset[i] = (remainder % numChunks[i]) * plan.chunkDims[i];
+        count[i] = std::min(plan.chunkDims[i], plan.dims[i] - job.offset[i]);
+        remainder /= numChunks[i];
+      }
+
+      if(rawSource)
+      {
+        haddr_t address = HADDR_UNDEF;
+        hsize_t numBytes = 0;
+        success = H5Dget_chunk_info_by_coord(plan.sourceDatasetId, job.offset.data(), &job.filterMask, &address, &numBytes) >= 0;
+        job.skip = address == HADDR_UNDEF || numBytes == 0;
+        if(success && !job.skip)
+        {
+          job.buffer.resize(numBytes);
+          success = H5Dread_chunk(plan.sourceDatasetId, H5P_DEFAULT, job.offset.data(), &job.filterMask, job.buffer.data()) >= 0;
+        }
+      }
+      else
+      {
+        job.buffer.assign(chunkBytes, 0);
+        success = H5Sselect_hyperslab(fileSpaceId, H5S_SELECT_SET, job.offset.data(), nullptr, count.data(), nullptr) >= 0 &&
+                  H5Sselect_hyperslab(memorySpaceId, H5S_SELECT_SET, zeroOffset.data(), nullptr, count.data(), nullptr) >= 0 &&
+                  H5Dread(plan.sourceDatasetId, plan.memoryTypeId, memorySpaceId, fileSpaceId, H5P_DEFAULT, job.buffer.data()) >= 0;
+      }
+    }
+    if(!success)
+    {
+      break;
+    }
+
+    // Decode and encode in parallel. No HDF5 calls are made here.
+    context.parallelFor(numJobs, [&](size_t j) {
+      ChunkJob& job = jobs[j];
+      if(job.skip)
+      {
+        return;
+      }
+      if(rawSource && !decodeChunk(plan.sourcePipeline, job.filterMask, plan.typeSize, chunkBytes, job.buffer, job.scratch))
+      {
+        job.failed = true;
+        return;
+      }
+      if(plan.skipZeroChunks && std::all_of(job.buffer.cbegin(), job.buffer.cend(), [](uint8_t value) { return value == 0; }))
+      {
+        job.skip = true;
+        return;
+      }
+      job.failed = !encodeChunk(plan.targetPipeline, plan.typeSize, job.buffer, job.scratch);
+    });
+
+    // Write the batch serially
+    for(size_t j = 0; success && j < numJobs; j++)
+    {
+      ChunkJob& job = jobs[j];
+      success = !job.failed;
+      if(success && !job.skip)
+      {
+        success = H5Dwrite_chunk(plan.targetDatasetId, H5P_DEFAULT, 0, job.offset.data(), job.buffer.size(), job.buffer.data()) >= 0;
+      }
+    }
+    success = success && context.report(plan.path, (first + numJobs) * chunkBytes, totalBytes);
+  }
+
+  H5Sclose(memorySpaceId);
+  H5Sclose(fileSpaceId);
+  return success;
+}
+
+/**
+ * @brief Moves the raw data through H5Dread and H5Dwrite in slabs of whole
+ * rows along the first dimension. Used for targets the repacker cannot encode
+ * itself.
+ */
+bool moveSlabs(RepackContext& context, const DatasetPlan& plan)
+{
+  const size_t rank = plan.dims.size();
+  const uint64_t rowBytes = countBytes({plan.dims.cbegin() + 1, plan.dims.cend()}, plan.typeSize);
+  const uint64_t totalBytes = rowBytes * plan.dims[0];
+  const hsize_t rowsPerSlab = std::max<uint64_t>(context.m_Options.batchBytes / std::max<uint64_t>(rowBytes, 1), 1);
+
+  hid_t sourceSpaceId = H5Dget_space(plan.sourceDatasetId);
+  hid_t targetSpaceId = H5Dget_space(plan.targetDatasetId);
+  std::vector<hsize_t> offset(rank, 0);
+  std::vector<hsize_t> count = plan.dims;
+  std::vector<uint8_t> buffer;
+  bool success = true;
+  for(hsize_t row = 0; success && row < plan.dims[0]; row += rowsPerSlab)
+  {
+    offset[0] = row;
+    count[0] = std::min(rowsPerSlab, plan.dims[0] - row);
+    buffer.resize(count[0] * rowBytes);
+    hid_t memorySpaceId = H5Screate_simple(static_cast<int>(rank), count.data(), nullptr);
+    success = H5Sselect_hyperslab(sourceSpaceId, H5S_SELECT_SET, offset.data(), nullptr, count.data(), nullptr) >= 0 &&
+              H5Sselect_hyperslab(targetSpaceId, H5S_SELECT_SET, offset.data(), nullptr, count.data(), nullptr) >= 0 &&
+              H5Dread(plan.sourceDatasetId, plan.memoryTypeId, memorySpaceId, sourceSpaceId, H5P_DEFAULT, buffer.data()) >= 0 &&
+              H5Dwrite(plan.targetDatasetId, plan.memoryTypeId, memorySpaceId, targetSpaceId, H5P_DEFAULT, buffer.data()) >= 0;
+    H5Sclose(memorySpaceId);
+    success = success && context.report(plan.path, (row + count[0]) * rowBytes, totalBytes);
+  }
+  H5Sclose(targetSpaceId);
+  H5Sclose(sourceSpaceId);
+  return success;
+}
+
+/**
+ * @brief Creates the target dataset creation property list from the source's.
+ * Returns a negative value if the settings cannot be applied.
+ */
+hid_t createTargetProperties(hid_t sourcePlistId, const Repacker::DatasetSettings& settings, const std::vector<hsize_t>& chunkDims)
+{
+  hid_t plistId = H5Pcopy(sourcePlistId);
+  if(plistId < 0)
+  {
+    return plistId;
+  }
+
+  bool success = true;
+  if(chunkDims.empty() || settings.compression != Repacker::Compression::Keep)
+  {
+    success = H5Premove_filter(plistId, H5Z_FILTER_ALL) >= 0;
+  }
+  if(chunkDims.empty())
+  {
+    success = success && H5Pset_layout(plistId, H5D_CONTIGUOUS) >= 0;
+  }
+  else
+  {
+    success = success && H5Pset_chunk(plistId, static_cast<int>(chunkDims.size()), chunkDims.data()) >= 0;
+    if(settings.compression == Repacker::Compression::Deflate)
+    {
+      success = success && (!settings.shuffle || H5Pset_shuffle(plistId) >= 0);
+      success = success && H5Pset_deflate(plistId, std::clamp(settings.deflateLevel, 1u, 9u)) >= 0;
+    }
+  }
+  if(!success)
+  {
+    H5Pclose(plistId);
+    return -1;
+  }
+  return plistId;
+}
+
+/**
+ * @brief Repacks the dataset at the path. Returns an empty string on success
+ * and the reason otherwise. repacked is set if the dataset was re-laid out or
+ * recompressed rather than copied with H5Ocopy.
+ */
+std::string repackDataset(RepackContext& context, const std::string& path, bool& repacked)
+{
+  repacked = false;
+  const Repacker::DatasetSettings& settings = context.getSettings(path);
+
+  // Size the source chunk cache to a batch so decoded hyperslab reads do not
+  // decode the same source chunk repeatedly.
+  hid_t accessPlistId = H5Pcreate(H5P_DATASET_ACCESS);
+  H5Pset_chunk_cache(accessPlistId, H5D_CHUNK_CACHE_NSLOTS_DEFAULT, context.m_Options.batchBytes, 1.0);
+  DatasetPlan plan;
+  plan.path = path;
+  plan.sourceDatasetId = H5Dopen2(context.m_SourceId, path.c_str(), accessPlistId);
+  H5Pclose(accessPlistId);
+  if(plan.sourceDatasetId < 0)
+  {
+    return "the dataset could not be opened";
+  }
+
+  hid_t typeId = H5Dget_type(plan.sourceDatasetId);
+  hid_t spaceId = H5Dget_space(plan.sourceDatasetId);
+  hid_t sourcePlistId = H5Dget_create_plist(plan.sourceDatasetId);
+  const int32_t rank = H5Sget_simple_extent_ndims(spaceId);
+  plan.dims.resize(std::max(rank, 0));
+  std::vector<hsize_t> maxDims(plan.dims.size());
+  H5Sget_simple_extent_dims(spaceId, plan.dims.data(), maxDims.data());
+  plan.typeSize = H5Tget_size(typeId);
+  const H5D_layout_t sourceLayout = H5Pget_layout(sourcePlistId);
+  std::vector<hsize_t> sourceChunkDims;
+  if(sourceLayout == H5D_CHUNKED)
+  {
+    sourceChunkDims.resize(plan.dims.size());
+    H5Pget_chunk(sourcePlistId, rank, sourceChunkDims.data());
+  }
+
+  const bool keep = settings.layout == Repacker::Layout::Keep && settings.compression == Repacker::Compression::Keep;
+  const bool copyOnly = keep || rank <= 0 || (sourceLayout != H5D_CONTIGUOUS && sourceLayout != H5D_CHUNKED) || hasVariableData(typeId) || H5Tdetect_class(typeId, H5T_REFERENCE) > 0 ||
+                        std::any_of(plan.dims.cbegin(), plan.dims.cend(), [](hsize_t dim) { return dim == 0; });
+
+  std::string failure;
+  if(copyOnly)
+  {
+    if(H5Ocopy(context.m_SourceId, path.c_str(), context.m_TargetId, path.c_str(), H5P_DEFAULT, H5P_DEFAULT) < 0)
+    {
+      failure = "the dataset could not be copied";
+    }
+  }
+  else
+  {
+    const bool chunked = settings.layout == Repacker::Layout::Chunked || (settings.layout == Repacker::Layout::Keep && (sourceLayout == H5D_CHUNKED || settings.compression == Repacker::Compression::Deflate));
+    if(chunked)
+    {
+      if(settings.layout == Repacker::Layout::Keep && sourceLayout == H5D_CHUNKED)
+      {
+        plan.chunkDims = sourceChunkDims;
+      }
+      else if(settings.chunkDims.size() == plan.dims.size())
+      {
+        plan.chunkDims = settings.chunkDims;
+      }
+      else if(sourceLayout == H5D_CHUNKED)
+      {
+        // A chunk shape of another rank keeps the source chunks
+        plan.chunkDims = sourceChunkDims;
+      }
+      else
+      {
+        plan.chunkDims = Repacker::ChooseChunkDims(plan.dims, plan.typeSize, context.m_Options.targetChunkBytes);
+      }
+      for(size_t i = 0; i < plan.chunkDims.size(); i++)
+      {
+        plan.chunkDims[i] = std::max<hsize_t>(plan.chunkDims[i], 1);
+        if(maxDims[i] != H5S_UNLIMITED)
+        {
+          plan.chunkDims[i] = std::min(plan.chunkDims[i], maxDims[i]);
+        }
+      }
+    }
+    else
+    {
+      // Contiguous datasets cannot be resized
+      maxDims = plan.dims;
+    }
+
+    hid_t targetPlistId = failure.empty() ? createTargetProperties(sourcePlistId, settings, plan.chunkDims) : -1;
+    if(failure.empty() && targetPlistId < 0)
+    {
+      failure = "the target layout or filters could not be applied";
+    }
+    if(failure.empty())
+    {
+      plan.memoryTypeId = H5Tcopy(typeId);
+      hid_t targetSpaceId = H5Screate_simple(rank, plan.dims.data(), maxDims.data());
+      plan.targetDatasetId = H5Dcreate2(context.m_TargetId, path.c_str(), plan.memoryTypeId, targetSpaceId, H5P_DEFAULT, targetPlistId, H5P_DEFAULT);
+      H5Sclose(targetSpaceId);
+
+      plan.sourceChunksMatch = sourceLayout == H5D_CHUNKED && sourceChunkDims == plan.chunkDims;
+      plan.sourcePipeline = readPipeline(sourcePlistId);
+      plan.targetPipeline = readPipeline(targetPlistId);
+      H5D_fill_value_t fillValueStatus = H5D_FILL_VALUE_ERROR;
+      plan.skipZeroChunks = H5Pfill_value_defined(targetPlistId, &fillValueStatus) >= 0 && fillValueStatus == H5D_FILL_VALUE_DEFAULT;
+      H5Pclose(targetPlistId);
+
+      if(plan.targetDatasetId < 0)
+      {
+        failure = "the target dataset could not be created";
+      }
+      else if(copyAttributes(plan.sourceDatasetId, plan.targetDatasetId) < 0)
+      {
+        failure = "the attributes could not be copied";
+      }
+      else
+      {
+        const bool moved = !plan.chunkDims.empty() && plan.targetPipeline.supported ? moveChunks(context, plan) : moveSlabs(context, plan);
+        if(!moved && !context.m_Cancelled)
+        {
+          failure = "the raw data could not be moved";
+        }
+        repacked = moved;
+      }
+      H5Tclose(plan.memoryTypeId);
+      if(plan.targetDatasetId >= 0)
+      {
+        H5Dclose(plan.targetDatasetId);
+      }
+    }
+  }
+
+  H5Pclose(sourcePlistId);
+  H5Sclose(spaceId);
+  H5Tclose(typeId);
+  H5Dclose(plan.sourceDatasetId);
+  return failure;
+}
+
+/**
+ * @brief Reproduces a soft or external link.
+ */
+herr_t copyLinkValue(hid_t sourceId, hid_t targetId, const LinkRecord& link)
+{
+  std::vector<char> value(link.valueSize);
+  if(H5Lget_val(sourceId, link.path.c_str(), value.data(), value.size(), H5P_DEFAULT) < 0)
+  {
+    return -1;
+  }
+  if(link.linkType == H5L_TYPE_SOFT)
+  {
+    return H5Lcreate_soft(value.data(), targetId, link.path.c_str(), H5P_DEFAULT, H5P_DEFAULT);
+  }
+
+  unsigned flags = 0;
+  const char* filename = nullptr;
+  const char* objectPath = nullptr;
+  if(H5Lunpack_elink_val(value.data(), value.size(), &flags, &filename, &objectPath) < 0)
+  {
+    return -1;
+  }
+  return H5Lcreate_external(filename, objectPath, targetId, link.path.c_str(), H5P_DEFAULT, H5P_DEFAULT);
+}
+} // namespace
+
+Repacker::Repacker()
+: Repacker(Options{})
+{
+}
+
+Repacker::Repacker(Options options)
+: m_Options(std::move(options))
+{
+}
+
+const Repacker::Options& Repacker::getOptions() const
+{
+  return m_Options;
+}
+
+Result<Repacker::Summary> Repacker::repack(const std::filesystem::path& sourcePath, const std::filesystem::path& targetPath) const
+{
+  H5SUPPORT_MUTEX_LOCK()
+
+  Summary summary;
+  {
+    auto sourceResult = FileIO::Open(sourcePath, FileIO::Mode::ReadOnly);
+    if(!sourceResult.valid())
+    {
+      return MakeErrorResult<Summary>(-330, fmt::format("Error repacking HDF5 file '{}'. The file could not be opened.", sourcePath.string()));
+    }
+    auto targetResult = FileIO::Open(targetPath, FileIO::Mode::Truncate, m_Options.fileOptions);
+    if(!targetResult.valid())
+    {
+      return MakeErrorResult<Summary>(-331, fmt::format("Error repacking HDF5 file '{}'. The target file '{}' could not be created.", sourcePath.string(), targetPath.string()));
+    }
+    const FileIO& sourceFile = sourceResult.value();
+    const FileIO& targetFile = targetResult.value();
+
+    std::vector<LinkRecord> links;
+    if(H5Lvisit(sourceFile.getId(), H5_INDEX_NAME, H5_ITER_INC, collectLink, &links) < 0)
+    {
+      return MakeErrorResult<Summary>(-332, fmt::format("Error repacking HDF5 file '{}'. Visiting the links failed.", sourcePath.string()));
+    }
+
+    RepackContext context(m_Options, sourceFile.getId(), targetFile.getId());
+    std::unordered_map<haddr_t, std::string> copiedObjects;
+    copiedObjects.emplace(sourceFile.getObjectId(), "/");
+    // Datasets reached through several hard links are only repacked once
+    std::unordered_set<haddr_t> datasetAddresses;
+    for(const auto& link : links)
+    {
+      if(link.linkType == H5L_TYPE_HARD && link.objectType == H5O_TYPE_DATASET)
+      {
+        datasetAddresses.insert(link.address);
+      }
+    }
+    context.m_NumDatasets = datasetAddresses.size();
+
+    if(copyAttributes(sourceFile.getId(), targetFile.getId()) < 0)
+    {
+      return MakeErrorResult<Summary>(-333, fmt::format("Error repacking HDF5 file '{}'. The root attributes could not be copied.", sourcePath.string()));
+    }
+
+    for(const auto& link : links)
+    {
+      std::string failure;
+      if(link.linkType != H5L_TYPE_HARD)
+      {
+        failure = copyLinkValue(sourceFile.getId(), targetFile.getId(), link) < 0 ? "the link could not be copied" : "";
+      }
+      else if(auto iter = copiedObjects.find(link.address); iter != copiedObjects.end())
+      {
+        failure = H5Lcreate_hard(targetFile.getId(), iter->second.c_str(), targetFile.getId(), link.path.c_str(), H5P_DEFAULT, H5P_DEFAULT) < 0 ? "the hard link could not be created" : "";
+      }
+      else if(link.objectType == H5O_TYPE_GROUP)
+      {
+        hid_t sourceGroupId = H5Gopen2(sourceFile.getId(), link.path.c_str(), H5P_DEFAULT);
+        hid_t creationPlistId = sourceGroupId < 0 ? -1 : H5Gget_create_plist(sourceGroupId);
+        hid_t targetGroupId = creationPlistId < 0 ? -1 : H5Gcreate2(targetFile.getId(), link.path.c_str(), H5P_DEFAULT, creationPlistId, H5P_DEFAULT);
+        if(targetGroupId < 0 || copyAttributes(sourceGroupId, targetGroupId) < 0)
+        {
+          failure = "the group could not be copied";
+        }
+        for(hid_t id : {targetGroupId, sourceGroupId})
+        {
+          if(id >= 0)
+          {
+            H5Oclose(id);
+          }
+        }
+        if(creationPlistId >= 0)
+        {
+          H5Pclose(creationPlistId);
+        }
+        summary.numGroups++;
+      }
+      else if(link.objectType == H5O_TYPE_DATASET)
+      {
+        bool repacked = false;
+        failure = repackDataset(context, link.path, repacked);
+        if(context.m_Cancelled)
+        {
+          return MakeErrorResult<Summary>(-334, fmt::format("Repacking HDF5 file '{}' was cancelled.", sourcePath.string()));
+        }
+        summary.numDatasets++;
+        summary.numRepacked += repacked ? 1 : 0;
+        context.report(link.path, 1, 1);
+        context.m_DatasetIndex++;
+        if(context.m_Cancelled)
+        {
+          return MakeErrorResult<Summary>(-334, fmt::format("Repacking HDF5 file '{}' was cancelled.", sourcePath.string()));
+        }
+      }
+      else
+      {
+        failure = H5Ocopy(sourceFile.getId(), link.path.c_str(), targetFile.getId(), link.path.c_str(), H5P_DEFAULT, H5P_DEFAULT) < 0 ? "the object could not be copied" : "";
+      }
+
+      if(!failure.empty())
+      {
+        return MakeErrorResult<Summary>(-333, fmt::format("Error repacking '{}' in HDF5 file '{}': {}.", link.path, sourcePath.string(), failure));
+      }
+      if(link.linkType == H5L_TYPE_HARD)
+      {
+        copiedObjects.emplace(link.address, link.path);
+      }
+    }
+  }
+
+  std::error_code errorCode;
+  summary.sourceFileSize = std::filesystem::file_size(sourcePath, errorCode);
+  summary.targetFileSize = std::filesystem::file_size(targetPath, errorCode);
+  return {summary};
+}
+
+std::vector<hsize_t> Repacker::ChooseChunkDims(const std::vector<hsize_t>& dims, size_t typeSize, size_t targetBytes)
+{
+  std::vector<hsize_t> chunkDims(dims.size(), 1);
+  uint64_t chunkBytes = std::max<size_t>(typeSize, 1);
+  const uint64_t maxBytes = std::max<uint64_t>(targetBytes, chunkBytes);
+  for(size_t i = dims.size(); i-- > 0;)
+  {
+    const hsize_t dim = std::max<hsize_t>(dims[i], 1);
+    chunkDims[i] = std::min<hsize_t>(dim, std::max<uint64_t>(maxBytes / chunkBytes, 1));
+    chunkBytes *= chunkDims[i];
+    if(chunkDims[i] < dim)
+    {
+      break;
+    }
+  }
+  return chunkDims;
+}
+} // namespace NX::H5Support
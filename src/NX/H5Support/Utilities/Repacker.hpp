@@ -0,0 +1,197 @@
+#pragma once
+
+#include "NX/H5Support/H5.hpp"
+#include "NX/H5Support/IO/FileOptions.hpp"
+#include "NX/H5Support/NXH5SUPPORT_EXPORT.hpp"
+
+#include "NX/Common/Result.hpp"
+
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace NX::H5Support
+{
+/**
+ * @brief Repacker copies an HDF5 file into a new file, optionally changing
+ * the layout, chunk shape and compression of its datasets. The new file
+ * contains no free space left behind by earlier rewrites.
+ *
+ * Groups, attributes, named datatypes, hard links, soft links and external
+ * links are reproduced. Datasets whose settings keep both their layout and
+ * compression are copied with H5Ocopy without decoding. Chunked datasets
+ * whose source and target filters are limited to shuffle and deflate are
+ * decoded and encoded by the repacker itself, spread across cores when the
+ * library is built with NXCOMMON_ENABLE_MULTICORE, and written as raw chunks.
+ * Other datasets are read and written through HDF5. Datasets with variable
+ * length or reference types and compact or scalar datasets are always copied
+ * unchanged.
+ */
+class NXH5SUPPORT_EXPORT Repacker
+{
+public:
+  /**
+   * @brief Storage layout of a repacked dataset.
+   */
+  enum class Layout
+  {
+    Keep,       // Keeps the source layout and chunk shape
+    Contiguous, // Stores the raw data in a single unfiltered block
+    Chunked     // Stores the raw data in chunks of DatasetSettings::chunkDims
+  };
+
+  /**
+   * @brief Compression of a repacked dataset. Compression requires a chunked
+   * layout and is ignored for contiguous datasets.
+   */
+  enum class Compression
+  {
+    Keep,   // Keeps the source filters
+    None,   // Removes all filters
+    Deflate // Applies deflate at DatasetSettings::deflateLevel
+  };
+
+  /**
+   * @brief Target settings for a single dataset.
+   */
+  struct DatasetSettings
+  {
+    Layout layout = Layout::Keep;
+
+    /**
+     * @brief Chunk shape used with Layout::Chunked. Datasets of another rank
+     * keep their source chunks when chunked. Otherwise, as with an empty
+     * shape, a shape with about Options::targetChunkBytes bytes per chunk is
+     * picked.
+     */
+    std::vector<hsize_t> chunkDims;
+
+    Compression compression = Compression::Keep;
+
+    /**
+     * @brief Deflate level between 1 (fastest) and 9 (smallest).
+     */
+    uint32_t deflateLevel = 4;
+
+    /**
+     * @brief Applies the shuffle filter before deflate, which usually
+     * improves the compression of numeric data.
+     */
+    bool shuffle = true;
+  };
+
+  /**
+   * @brief Progress of the dataset being repacked. Reported after each batch
+   * of chunks and once every dataset is complete.
+   */
+  struct Progress
+  {
+    std::string path;
+    size_t datasetIndex = 0;
+    size_t numDatasets = 0;
+    uint64_t bytesProcessed = 0;
+    uint64_t bytesTotal = 0;
+  };
+
+  /**
+   * @brief Called from the thread running repack(). Returning false cancels
+   * the repack.
+   */
+  using ProgressCallback = std::function<bool(const Progress&)>;
+
+  struct Options
+  {
+    /**
+     * @brief Settings applied to datasets without an entry in
+     * datasetSettings. The defaults copy every dataset unchanged.
+     */
+    DatasetSettings defaultSettings;
+
+    /**
+     * @brief Settings for individual datasets keyed by their path from the
+     * root group without a leading '/'.
+     */
+    std::map<std::string, DatasetSettings> datasetSettings;
+
+    /**
+     * @brief Target chunk size used when a chunked layout has no chunk shape.
+     */
+    size_t targetChunkBytes = 1024 * 1024;
+
+    /**
+     * @brief Amount of decoded data held in memory per batch of chunks.
+     */
+    size_t batchBytes = 64 * 1024 * 1024;
+
+    /**
+     * @brief Number of threads used to encode and decode chunks. 0 uses every
+     * available core.
+     */
+    size_t numThreads = 0;
+
+    /**
+     * @brief Options used to create the target file.
+     */
+    FileOptions fileOptions;
+
+    ProgressCallback progress;
+  };
+
+  /**
+   * @brief Totals reported by a completed repack.
+   */
+  struct Summary
+  {
+    size_t numGroups = 0;
+    size_t numDatasets = 0;
+    size_t numRepacked = 0; // Datasets re-laid out or recompressed
+    uint64_t sourceFileSize = 0;
+    uint64_t targetFileSize = 0;
+  };
+
+  /**
+   * @brief Constructs a Repacker that copies every dataset unchanged.
+   */
+  Repacker();
+
+  /**
+   * @brief Constructs a Repacker using the target options.
+   * @param options
+   */
+  explicit Repacker(Options options);
+
+  /**
+   * @brief Returns the options used by the repacker.
+   * @return const Options&
+   */
+  const Options& getOptions() const;
+
+  /**
+   * @brief Repacks the source file into the target file. The target file is
+   * replaced if it exists. The target file is left incomplete if an error
+   * occurs or the progress callback cancels the repack.
+   * @param sourcePath
+   * @param targetPath
+   * @return A standard Result object that wraps the Summary on success.
+   */
+  Common::Result<Summary> repack(const std::filesystem::path& sourcePath, const std::filesystem::path& targetPath) const;
+
+  /**
+   * @brief Returns a chunk shape for a dataset with the target dimensions and
+   * element size holding at most targetBytes bytes where possible. Trailing
+   * dimensions are kept whole before leading dimensions are split so chunks
+   * cover contiguous rows.
+   * @param dims
+   * @param typeSize
+   * @param targetBytes
+   * @return std::vector<hsize_t>
+   */
+  static std::vector<hsize_t> ChooseChunkDims(const std::vector<hsize_t>& dims, size_t typeSize, size_t targetBytes);
+
+private:
+  Options m_Options;
+};
+} // namespace NX::H5Support
@@ -23,11 +23,12 @@ AttributeWriter::~AttributeWriter() = default;
 
 ErrorType AttributeWriter::findAndDeleteAttribute()
 {
-  hsize_t attributeNum = 0;
-  int32_t hasAttribute = H5Aiterate(getObjectId(), H5_INDEX_NAME, H5_ITER_INC, &attributeNum, Support::FindAttr, const_cast<char*>(getAttributeName().c_str()));
+  H5SUPPORT_MUTEX_LOCK()
+
+  htri_t hasAttribute = H5Aexists(getObjectId(), getAttributeName().c_str());
 
   /* The attribute already exists, delete it */
-  if(hasAttribute == 1)
+  if(hasAttribute > 0)
   {
     herr_t error = H5Adelete(getObjectId(), getAttributeName().c_str());
     if(error < 0)
@@ -78,6 +79,8 @@ std::string AttributeWriter::getAttributeName() const
 
 herr_t AttributeWriter::writeString(const std::string& text)
 {
+  H5SUPPORT_MUTEX_LOCK()
+
   if(!isValid())
   {
     return -1;
@@ -116,23 +119,22 @@ herr_t AttributeWriter::writeString(const std::string& text)
           hid_t attributeSpaceID = H5Screate(H5S_SCALAR);
           if(attributeSpaceID >= 0)
           {
-            /* Verify if the attribute already exists */
-            returnError = findAndDeleteAttribute();
-            if(error >= 0)
+            /* Open and write the attribute. An existing string of the same length is overwritten in place. */
+            hid_t attributeId = Support::OpenOrCreateAttribute(getObjectId(), getAttributeName(), attributeType, attributeSpaceID);
+            if(attributeId >= 0)
             {
-              /* Create and write the attribute */
-              hid_t attributeId = H5Acreate(getObjectId(), getAttributeName().c_str(), attributeType, attributeSpaceID, H5P_DEFAULT, H5P_DEFAULT);
-              if(attributeId >= 0)
+              error = H5Awrite(attributeId, attributeType, text.c_str());
+              if(error < 0)
               {
-                error = H5Awrite(attributeId, attributeType, text.c_str());
-                if(error < 0)
-                {
-                  std::cout << "Error Writing String attribute." << std::endl;
-                  returnError = error;
-                }
+                std::cout << "Error Writing String attribute." << std::endl;
+                returnError = error;
               }
               H5S_CLOSE_H5_ATTRIBUTE(attributeId, error, returnError)
             }
+            else
+            {
+              returnError = static_cast<herr_t>(attributeId);
+            }
             H5S_CLOSE_H5_DATASPACE(attributeSpaceID, error, returnError)
           }
         }
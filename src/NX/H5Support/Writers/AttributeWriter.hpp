@@ -79,6 +79,8 @@ public:
   template <typename T>
   ErrorType writeValue(T value)
   {
+    H5SUPPORT_MUTEX_LOCK()
+
     if(!isValid())
     {
       return -1;
@@ -88,10 +90,6 @@ public:
     herr_t returnError = 0;
 
     hid_t dataType = Support::HdfTypeForPrimitive<T>();
-    if(dataType == -1)
-    {
-      return -1;
-    }
 
     /* Create the data space for the attribute. */
     int32_t rank = 1;
@@ -99,21 +97,16 @@ public:
     hid_t dataspaceId = H5Screate_simple(rank, &dims, nullptr);
     if(dataspaceId >= 0)
     {
-      // Delete existing attribute
-      error = findAndDeleteAttribute();
-      if(error >= 0)
+      /* Open the attribute. An existing attribute of the same shape is overwritten in place. */
+      hid_t attributeId = Support::OpenOrCreateAttribute(getObjectId(), getAttributeName(), dataType, dataspaceId);
+      if(attributeId >= 0)
       {
-        /* Create the attribute. */
-        hid_t attributeId = H5Acreate(getObjectId(), getAttributeName().c_str(), dataType, dataspaceId, H5P_DEFAULT, H5P_DEFAULT);
-        if(attributeId >= 0)
+        /* Write the attribute data. */
+        error = H5Awrite(attributeId, dataType, &value);
+        if(error < 0)
         {
-          /* Write the attribute data. */
-          error = H5Awrite(attributeId, dataType, &value);
-          if(error < 0)
-          {
-            std::cout << "Error Writing Attribute" << std::endl;
-            returnError = error;
-          }
+          std::cout << "Error Writing Attribute" << std::endl;
+          returnError = error;
         }
         /* Close the attribute. */
         error = H5Aclose(attributeId);
@@ -123,6 +116,10 @@ public:
           returnError = error;
         }
       }
+      else
+      {
+        returnError = static_cast<herr_t>(attributeId);
+      }
       /* Close the dataspace. */
       error = H5Sclose(dataspaceId);
       if(error < 0)
@@ -148,6 +145,8 @@ public:
   template <typename T>
   ErrorType writeVector(const DimsVector& dims, const std::vector<T>& vector)
   {
+    H5SUPPORT_MUTEX_LOCK()
+
     if(!isValid())
     {
       return -1;
@@ -157,31 +156,22 @@ public:
     int32_t rank = static_cast<int32_t>(dims.size());
 
     hid_t dataType = Support::HdfTypeForPrimitive<T>();
-    if(dataType == -1)
-    {
-      std::cout << "dataType was unknown" << std::endl;
-      return -1;
-    }
 
     hid_t dataspaceId = H5Screate_simple(rank, dims.data(), nullptr);
     if(dataspaceId >= 0)
     {
-      // Delete any existing attribute
-      herr_t error = findAndDeleteAttribute();
+      herr_t error = 0;
 
-      if(error >= 0)
+      /* Open the attribute. An existing attribute of the same shape is overwritten in place. */
+      hid_t attributeId = Support::OpenOrCreateAttribute(getObjectId(), getAttributeName(), dataType, dataspaceId);
+      if(attributeId >= 0)
       {
-        /* Create the attribute. */
-        hid_t attributeId = H5Acreate(getObjectId(), getAttributeName().c_str(), dataType, dataspaceId, H5P_DEFAULT, H5P_DEFAULT);
-        if(attributeId >= 0)
+        /* Write the attribute data. */
+        error = H5Awrite(attributeId, dataType, static_cast<const void*>(vector.data()));
+        if(error < 0)
         {
-          /* Write the attribute data. */
-          error = H5Awrite(attributeId, dataType, static_cast<const void*>(vector.data()));
-          if(error < 0)
-          {
-            std::cout << "Error Writing Attribute" << std::endl;
-            returnError = error;
-          }
+          std::cout << "Error Writing Attribute" << std::endl;
+          returnError = error;
         }
         /* Close the attribute. */
         error = H5Aclose(attributeId);
@@ -191,6 +181,10 @@ public:
           returnError = error;
         }
       }
+      else
+      {
+        returnError = static_cast<herr_t>(attributeId);
+      }
       /* Close the dataspace. */
       error = H5Sclose(dataspaceId);
       if(error < 0)
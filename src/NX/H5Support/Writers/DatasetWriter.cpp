@@ -89,6 +89,8 @@ bool DatasetWriter::tryCreatingDataset(const std::string& datasetName, Type data
 
 void DatasetWriter::closeHdf5()
 {
+  H5SUPPORT_MUTEX_LOCK()
+
   if(getId() > 0)
   {
     H5Dclose(getId());
@@ -98,11 +100,12 @@ void DatasetWriter::closeHdf5()
 
 ErrorType DatasetWriter::findAndDeleteAttribute()
 {
-  hsize_t attributeNum = 0;
-  int32_t hasAttribute = H5Aiterate(getParentId(), H5_INDEX_NAME, H5_ITER_INC, &attributeNum, Support::FindAttr, const_cast<char*>(getName().c_str()));
+  H5SUPPORT_MUTEX_LOCK()
+
+  htri_t hasAttribute = H5Aexists(getParentId(), getName().c_str());
 
   /* The attribute already exists, delete it */
-  if(hasAttribute == 1)
+  if(hasAttribute > 0)
   {
     herr_t error = H5Adelete(getParentId(), getName().c_str());
     if(error < 0)
@@ -116,6 +119,8 @@ ErrorType DatasetWriter::findAndDeleteAttribute()
 
 void DatasetWriter::createOrOpenDataset(IdType typeId, IdType dataspaceId, IdType propertiesId)
 {
+  H5SUPPORT_MUTEX_LOCK()
+
   HDF_ERROR_HANDLER_OFF
   setId(H5Dopen(getParentId(), getName().c_str(), H5P_DEFAULT));
   HDF_ERROR_HANDLER_ON
@@ -127,6 +132,8 @@ void DatasetWriter::createOrOpenDataset(IdType typeId, IdType dataspaceId, IdTyp
 
 IdType DatasetWriter::CreateDatasetChunkProperties(nonstd::span<const hsize_t> dims)
 {
+  H5SUPPORT_MUTEX_LOCK()
+
   auto cparms = H5Pcreate(H5P_DATASET_CREATE);
   auto status = H5Pset_chunk(cparms, dims.size(), dims.data());
   if(status < 0)
@@ -138,6 +145,8 @@ IdType DatasetWriter::CreateDatasetChunkProperties(nonstd::span<const hsize_t> d
 
 IdType DatasetWriter::CreateTransferChunkProperties(const DimsType& chunkDims)
 {
+  H5SUPPORT_MUTEX_LOCK()
+
   auto cparms = H5Pcreate(H5P_DATASET_XFER);
   return cparms;
 }
@@ -150,6 +159,8 @@ void DatasetWriter::createOrOpenDatasetChunk(IdType typeId, IdType dataspaceId,
 
 IdType DatasetWriter::getPListId() const
 {
+  H5SUPPORT_MUTEX_LOCK()
+
   return H5Dget_create_plist(getId());
 }
 
@@ -170,6 +181,8 @@ std::string DatasetWriter::getName() const
 
 ErrorType DatasetWriter::writeString(const std::string& text)
 {
+  H5SUPPORT_MUTEX_LOCK()
+
   if(!isValid())
   {
     return -1;
@@ -223,6 +236,8 @@ ErrorType DatasetWriter::writeString(const std::string& text)
 
 ErrorType DatasetWriter::writeVectorOfStrings(std::vector<std::string>& text)
 {
+  H5SUPPORT_MUTEX_LOCK()
+
   if(!isValid())
   {
     return -1;
@@ -83,14 +83,11 @@ public:
   template <typename T>
   ErrorType writeSpan(const DimsType& dims, nonstd::span<const T> values)
   {
+    H5SUPPORT_MUTEX_LOCK()
+
     herr_t returnError = 0;
     int32_t rank = static_cast<int32_t>(dims.size());
     hid_t dataType = Support::HdfTypeForPrimitive<T>();
-    if(dataType == -1)
-    {
-      std::cout << "dataType was unknown" << std::endl;
-      return -1;
-    }
 
     hid_t dataspaceId = H5Screate_simple(rank, dims.data(), nullptr);
     if(dataspaceId >= 0)
@@ -140,14 +137,11 @@ public:
   template <typename T>
   ErrorType writeChunk(const DimsType& dims, nonstd::span<const T> values, const DimsType& chunkShape, nonstd::span<const hsize_t> offset)
   {
+    H5SUPPORT_MUTEX_LOCK()
+
     herr_t returnError = 0;
     int32_t rank = static_cast<int32_t>(dims.size());
     hid_t dataType = Support::HdfTypeForPrimitive<T>();
-    if(dataType == -1)
-    {
-      std::cout << "dataType was unknown" << std::endl;
-      return -1;
-    }
 
     hid_t dataspaceId = H5Screate_simple(rank, dims.data(), nullptr);
     if(dataspaceId >= 0)
@@ -8,7 +8,7 @@ using namespace NX::Common;
 
 namespace NX::H5Support
 {
-Result<FileWriter> FileWriter::CreateFile(const std::filesystem::path& filepath)
+Result<FileWriter> FileWriter::CreateFile(const std::filesystem::path& filepath, const FileOptions& options)
 {
   Result<FileWriter> result;
 
@@ -32,7 +32,7 @@ Result<FileWriter> FileWriter::CreateFile(const std::filesystem::path& filepath)
 
   try
   {
-    return {FileWriter(filepath)};
+    return {FileWriter(filepath, options)};
   } catch(const std::runtime_error& error)
   {
     return MakeErrorResult<FileWriter>(-301, fmt::format("Error creating Output HDF5 file at path '{}'. "
@@ -61,8 +61,8 @@ FileWriter::FileWriter(FileWriter&& rhs) noexcept
   rhs.setId(-1);
 }
 
-FileWriter::FileWriter(const std::filesystem::path& filepath)
-: GroupWriter(0, H5Fcreate(filepath.string().c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT))
+FileWriter::FileWriter(const std::filesystem::path& filepath, const FileOptions& options)
+: GroupWriter(0, CreateHdf5File(filepath, H5F_ACC_TRUNC, options))
 {
   if(getId() < 0)
   {
@@ -84,6 +84,8 @@ FileWriter::~FileWriter()
 
 void FileWriter::closeHdf5()
 {
+  H5SUPPORT_MUTEX_LOCK()
+
   if(isValid())
   {
     H5Fclose(getId());
@@ -93,6 +95,8 @@ void FileWriter::closeHdf5()
 
 std::string FileWriter::getName() const
 {
+  H5SUPPORT_MUTEX_LOCK()
+
   if(!isValid())
   {
     return "";
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "NX/H5Support/IO/FileOptions.hpp"
 #include "NX/H5Support/Writers/GroupWriter.hpp"
 
 #include "NX/Common/Result.hpp"
@@ -16,10 +17,11 @@ public:
    * @brief This static method will ensure that the complete path to the file
    * exists and the file is created.
    * @param filepath The file path to the HDF5 file that should be created
+   * @param options The driver and property options used to access the file
    * @return A standard Result object that wraps a std::unique_ptr<FileWriter>
    * object on success.
    */
-  static Common::Result<FileWriter> CreateFile(const std::filesystem::path& filepath);
+  static Common::Result<FileWriter> CreateFile(const std::filesystem::path& filepath, const FileOptions& options = {});
 
   /**
    * @brief This static method will wrap an existing HDF5 fileId value as long
@@ -60,8 +62,9 @@ protected:
    * specified path. If the file exists, the file is truncated to delete all
    * existing data. If the file cannot be created, the writer is invalid.
    * @param filepath
+   * @param options
    */
-  FileWriter(const std::filesystem::path& filepath);
+  FileWriter(const std::filesystem::path& filepath, const FileOptions& options = {});
 
   /**
    * @brief Constructs a FileWriter and wraps an already open HDF5 file. The
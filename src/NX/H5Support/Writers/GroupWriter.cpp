@@ -19,19 +19,9 @@ GroupWriter::GroupWriter(IdType parentId, IdType objectId)
 GroupWriter::GroupWriter(IdType parentId, const std::string& groupName)
 : ObjectWriter(parentId)
 {
-  // Check if group exists
-  HDF_ERROR_HANDLER_OFF
-  auto status = H5Gget_objinfo(parentId, groupName.c_str(), 0, NULL);
-  HDF_ERROR_HANDLER_ON
+  H5SUPPORT_MUTEX_LOCK()
 
-  if(status == 0) // if group exists...
-  {
-    setId(H5Gopen(parentId, groupName.c_str(), H5P_DEFAULT));
-  }
-  else // if group does not exist...
-  {
-    setId(H5Gcreate(parentId, groupName.c_str(), H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT));
-  }
+  setId(Support::OpenOrCreateGroup(parentId, groupName));
 }
 
 GroupWriter::~GroupWriter()
@@ -41,6 +31,8 @@ GroupWriter::~GroupWriter()
 
 void GroupWriter::closeHdf5()
 {
+  H5SUPPORT_MUTEX_LOCK()
+
   if(isValid())
   {
     H5Oclose(getId());
@@ -75,6 +67,8 @@ DatasetWriter GroupWriter::createDatasetWriter(const std::string& childName)
 
 ErrorType GroupWriter::createLink(const std::string& objectPath)
 {
+  H5SUPPORT_MUTEX_LOCK()
+
   if(objectPath.empty())
   {
     return -1;
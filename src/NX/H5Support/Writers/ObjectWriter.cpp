@@ -21,6 +21,8 @@ ObjectWriter::~ObjectWriter() = default;
 
 IdType ObjectWriter::getFileId() const
 {
+  H5SUPPORT_MUTEX_LOCK()
+
   if(!isValid())
   {
     return 0;
@@ -1,10 +1,19 @@
 #include <catch2/catch.hpp>
 
 #include "NX/H5Support/IO/DatasetIO.hpp"
+#include "NX/H5Support/IO/FileCatalog.hpp"
 #include "NX/H5Support/IO/FileIO.hpp"
+#include "NX/H5Support/IO/TypedDataset.hpp"
 #include "NX/H5Support/TestGenConstants.hpp"
+#include "NX/H5Support/Writers/FileWriter.hpp"
+
+#include <fmt/format.h>
 
 #include "nonstd/span.hpp"
+#include <array>
+#include <fstream>
+#include <numeric>
+#include <thread>
 #include <vector>
 
 namespace
@@ -144,3 +153,478 @@ TEST_CASE("File IO", "H5Support")
     // checkDataset<bool>(groupReader, k_DatasetBoolName);
   }
 }
+
+TEST_CASE("Typed Dataset", "H5Support")
+{
+  using namespace NX::H5Support;
+  using Grid = TypedDataset<int32_t, 2>;
+
+  auto fileResult = FileIO::CreateInMemory();
+  REQUIRE(fileResult.valid());
+  FileIO& file = fileResult.value();
+
+  constexpr Grid::DimsType k_Dims{4, 6};
+  std::vector<int32_t> values(Grid::NumElements(k_Dims));
+  std::iota(values.begin(), values.end(), 0);
+  {
+    Grid grid(file.createDataset("Grid"));
+    REQUIRE(grid.createOrOpen(k_Dims, {2, 3}));
+    REQUIRE(grid.getChunkDimensions() == Grid::DimsType{2, 3});
+    REQUIRE(grid.writeSpan(k_Dims, values) >= 0);
+    // The dimensions of an existing dataset cannot change
+    REQUIRE(grid.writeSpan({6, 4}, values) < 0);
+  }
+
+  Grid grid(file.openDataset("Grid"));
+  REQUIRE(grid.open());
+  REQUIRE(grid.getDimensions() == k_Dims);
+  REQUIRE(grid.getNumElements() == values.size());
+  std::vector<int32_t> readValues(values.size());
+  REQUIRE(grid.readIntoSpan(readValues));
+  REQUIRE(readValues == values);
+  REQUIRE(!grid.readIntoSpan(nonstd::span<int32_t>(readValues.data(), 4)));
+
+  // Rows 1-2, columns 2-4
+  std::array<int32_t, 6> block{};
+  REQUIRE(grid.readHyperslab({1, 2}, {2, 3}, block));
+  REQUIRE(block == std::array<int32_t, 6>{8, 9, 10, 14, 15, 16});
+  REQUIRE(!grid.readHyperslab({3, 2}, {2, 3}, block));
+  const std::array<int32_t, 6> zeros{};
+  REQUIRE(grid.writeHyperslab({1, 2}, {2, 3}, zeros) >= 0);
+  REQUIRE(grid.readHyperslab({1, 2}, {2, 3}, block));
+  REQUIRE(block == zeros);
+
+  // Values are converted to the memory type
+  TypedDataset<double, 2> doubles(file.openDataset("Grid"));
+  REQUIRE(doubles.open());
+  std::vector<double> doubleValues(values.size());
+  REQUIRE(doubles.readIntoSpan(doubleValues));
+  REQUIRE(doubleValues[5] == 5.0);
+
+  // The rank must match
+  TypedDataset<int32_t, 1> vector(file.openDataset("Grid"));
+  REQUIRE(!vector.open());
+  REQUIRE(vector.getDimensions() == TypedDataset<int32_t, 1>::DimsType{0});
+
+  TypedDataset<float, 1> extendible(file.createDataset("Extendible"));
+  REQUIRE(extendible.createOrOpenExtendible({4}, {4}));
+  TypedDataset<float, 1> stale(file.openDataset("Extendible"));
+  REQUIRE(stale.open());
+  REQUIRE(stale.getDimensions()[0] == 4);
+  REQUIRE(extendible.setExtent({8}) >= 0);
+  REQUIRE(extendible.getDimensions()[0] == 8);
+
+  // A handle with stale dimensions fails instead of overflowing the span
+  std::array<float, 4> staleValues{};
+  REQUIRE(!stale.readIntoSpan(staleValues));
+  REQUIRE(stale.writeSpan({4}, staleValues) < 0);
+  const std::array<float, 4> tail{1.0f, 2.0f, 3.0f, 4.0f};
+  REQUIRE(extendible.writeHyperslab({4}, {4}, tail) >= 0);
+  std::array<float, 8> extendedValues{};
+  REQUIRE(extendible.readIntoSpan(extendedValues));
+  REQUIRE(extendedValues[7] == 4.0f);
+}
+
+TEST_CASE("Object IO Read All Attributes", "H5Support")
+{
+  const std::filesystem::path filePath = NX::H5Support::constants::TestDataDir / "test_IO_Attributes.h5";
+
+  {
+    auto fileWriterResult = NX::H5Support::FileWriter::CreateFile(filePath);
+    REQUIRE(fileWriterResult.valid());
+    auto groupWriter = fileWriterResult.value().createGroupWriter(k_GroupName);
+    REQUIRE(groupWriter.isValid());
+
+    REQUIRE(groupWriter.createAttribute("Int32").writeValue<int32_t>(-7) == 0);
+    REQUIRE(groupWriter.createAttribute("UInt64").writeValue<uint64_t>(1ull << 40) == 0);
+    REQUIRE(groupWriter.createAttribute("Float64").writeVector<double>({3}, {0.5, 1.5, 2.5}) == 0);
+    REQUIRE(groupWriter.createAttribute("Name").writeString("Detector") == 0);
+
+    // String arrays, stored with variable and fixed length strings
+    const hsize_t numLabels = 3;
+    hid_t dataspaceId = H5Screate_simple(1, &numLabels, nullptr);
+    hid_t variableTypeId = H5Tcopy(H5T_C_S1);
+    H5Tset_size(variableTypeId, H5T_VARIABLE);
+    const char* labels[] = {"X", "Y", "Z axis"};
+    hid_t attributeId = H5Acreate2(groupWriter.getId(), "Labels", variableTypeId, dataspaceId, H5P_DEFAULT, H5P_DEFAULT);
+    REQUIRE(H5Awrite(attributeId, variableTypeId, labels) >= 0);
+    H5Aclose(attributeId);
+    hid_t fixedTypeId = H5Tcopy(H5T_C_S1);
+    H5Tset_size(fixedTypeId, 4);
+    const char units[] = "mm\0\0deg\0um\0\0";
+    attributeId = H5Acreate2(groupWriter.getId(), "Units", fixedTypeId, dataspaceId, H5P_DEFAULT, H5P_DEFAULT);
+    REQUIRE(H5Awrite(attributeId, fixedTypeId, units) >= 0);
+    H5Aclose(attributeId);
+    H5Tclose(fixedTypeId);
+    H5Tclose(variableTypeId);
+    H5Sclose(dataspaceId);
+  }
+
+  NX::H5Support::FileIO fileReader(filePath);
+  REQUIRE(fileReader.isValid());
+  auto groupReader = fileReader.openGroup(k_GroupName);
+  REQUIRE(groupReader.isValid());
+
+  const auto attributes = groupReader.readAllAttributes();
+  REQUIRE(attributes.size() == 6);
+  REQUIRE(std::get<std::vector<int32_t>>(attributes.at("Int32")) == std::vector<int32_t>{-7});
+  REQUIRE(std::get<std::vector<uint64_t>>(attributes.at("UInt64")) == std::vector<uint64_t>{1ull << 40});
+  REQUIRE(std::get<std::vector<double>>(attributes.at("Float64")) == std::vector<double>{0.5, 1.5, 2.5});
+  REQUIRE(std::get<std::string>(attributes.at("Name")) == "Detector");
+  REQUIRE(std::get<std::vector<std::string>>(attributes.at("Labels")) == std::vector<std::string>{"X", "Y", "Z axis"});
+  REQUIRE(std::get<std::vector<std::string>>(attributes.at("Units")) == std::vector<std::string>{"mm", "deg", "um"});
+}
+
+TEST_CASE("Attribute IO Overwrite", "H5Support")
+{
+  const std::filesystem::path filePath = NX::H5Support::constants::TestDataDir / "test_IO_AttributeOverwrite.h5";
+  constexpr int32_t k_NumAttributes = 1000;
+  std::filesystem::remove(filePath);
+
+  {
+    NX::H5Support::FileOptions options;
+    options.objectFormatV18 = true;
+    auto fileWriterResult = NX::H5Support::FileIO::CreateFile(filePath, options);
+    REQUIRE(fileWriterResult.valid());
+    auto groupWriter = fileWriterResult.value().createGroup(k_GroupName, NX::H5Support::GroupOptions::ManyAttributes());
+    REQUIRE(groupWriter.isValid());
+
+    hid_t creationPropertiesId = H5Gget_create_plist(groupWriter.getId());
+    unsigned maxCompact = 0;
+    unsigned minDense = 0;
+    REQUIRE(H5Pget_attr_phase_change(creationPropertiesId, &maxCompact, &minDense) >= 0);
+    H5Pclose(creationPropertiesId);
+    REQUIRE(maxCompact == 0);
+    REQUIRE(minDense == 0);
+
+    for(int32_t i = 0; i < k_NumAttributes; i++)
+    {
+      REQUIRE(groupWriter.createAttribute(std::to_string(i)).writeValue<int32_t>(i) == 0);
+    }
+
+    // Same type and extent: overwritten in place
+    for(int32_t i = 0; i < k_NumAttributes; i++)
+    {
+      REQUIRE(groupWriter.createAttribute(std::to_string(i)).writeValue<int32_t>(-i) == 0);
+    }
+
+    // Different type or extent: replaced
+    REQUIRE(groupWriter.createAttribute("0").writeVector<double>({2}, {0.5, 1.5}) == 0);
+    REQUIRE(groupWriter.createAttribute("Name").writeString("Short") == 0);
+    REQUIRE(groupWriter.createAttribute("Name").writeString("Longer Name") == 0);
+
+    auto attribute = groupWriter.createAttribute("1");
+    REQUIRE(attribute.isValid());
+    REQUIRE(attribute.writeValue<int32_t>(11) == 0);
+    REQUIRE(attribute.readAsValue<int32_t>() == 11);
+
+    auto newAttribute = groupWriter.createAttribute("New");
+    REQUIRE_FALSE(newAttribute.isValid());
+    REQUIRE(newAttribute.getName() == "New");
+    REQUIRE(newAttribute.writeValue<uint8_t>(3) == 0);
+    REQUIRE(newAttribute.isValid());
+
+    // Datasets take the same attribute storage options on top of their layout
+    auto datasetWriter = groupWriter.createDataset("Data", NX::H5Support::DatasetOptions::ManyAttributes());
+    datasetWriter.createOrOpenChunkedDataset<int32_t>({k_DatasetSize}, {k_DatasetSize});
+    REQUIRE(datasetWriter.getId() > 0);
+    REQUIRE(datasetWriter.getChunkDimensions() == std::vector<hsize_t>{k_DatasetSize});
+    creationPropertiesId = H5Dget_create_plist(datasetWriter.getId());
+    REQUIRE(H5Pget_attr_phase_change(creationPropertiesId, &maxCompact, &minDense) >= 0);
+    H5Pclose(creationPropertiesId);
+    REQUIRE(maxCompact == 0);
+    REQUIRE(minDense == 0);
+    REQUIRE(datasetWriter.createAttribute("Units").writeString("mm") == 0);
+  }
+
+  NX::H5Support::FileIO fileReader(filePath);
+  REQUIRE(fileReader.isValid());
+  auto groupReader = fileReader.openGroup(k_GroupName);
+  REQUIRE(groupReader.isValid());
+
+  const auto attributes = groupReader.readAllAttributes();
+  REQUIRE(attributes.size() == k_NumAttributes + 2);
+  REQUIRE(std::get<std::vector<double>>(attributes.at("0")) == std::vector<double>{0.5, 1.5});
+  REQUIRE(std::get<std::vector<int32_t>>(attributes.at("1")) == std::vector<int32_t>{11});
+  for(int32_t i = 2; i < k_NumAttributes; i++)
+  {
+    REQUIRE(std::get<std::vector<int32_t>>(attributes.at(std::to_string(i))) == std::vector<int32_t>{-i});
+  }
+  REQUIRE(std::get<std::string>(attributes.at("Name")) == "Longer Name");
+  REQUIRE(std::get<std::vector<uint8_t>>(attributes.at("New")) == std::vector<uint8_t>{3});
+}
+
+TEST_CASE("Group IO List Children", "H5Support")
+{
+  const std::filesystem::path filePath = NX::H5Support::constants::TestDataDir / "test_IO_Children.h5";
+  constexpr size_t k_NumGroups = 500;
+  std::filesystem::remove(filePath);
+
+  auto fileWriterResult = NX::H5Support::FileIO::CreateFile(filePath);
+  REQUIRE(fileWriterResult.valid());
+  auto group = fileWriterResult.value().createGroup(k_GroupName);
+  REQUIRE(group.isValid());
+  for(size_t i = 0; i < k_NumGroups; i++)
+  {
+    REQUIRE(group.createGroup(fmt::format("Group_{:04}", i)).isValid());
+  }
+  createDataset<int32_t>(group, k_DatasetInt32Name);
+  createDataset<double>(group, k_DatasetFloat64Name);
+
+  REQUIRE(group.getNumChildren() == k_NumGroups + 2);
+  const auto childNames = group.getChildNames();
+  REQUIRE(childNames.size() == k_NumGroups + 2);
+  REQUIRE(childNames.front() == k_DatasetFloat64Name);
+  REQUIRE(childNames.back() == k_DatasetInt32Name);
+
+  const auto children = group.listChildren(true);
+  REQUIRE(children.size() == k_NumGroups + 2);
+  for(size_t i = 0; i < children.size(); i++)
+  {
+    REQUIRE(children[i].name == childNames[i]);
+    REQUIRE(children[i].address != HADDR_UNDEF);
+  }
+  REQUIRE(children[0].objectType == NX::H5Support::ObjectType::dataset);
+  REQUIRE(children[0].type == NX::H5Support::Type::float64);
+  REQUIRE(children[0].dims == NX::H5Support::DatasetIO::DimsType{k_DatasetSize});
+  REQUIRE(children[1].objectType == NX::H5Support::ObjectType::group);
+  REQUIRE(children[1].dims.empty());
+
+  std::vector<std::string> pagedNames;
+  NX::H5Support::SizeType position = 0;
+  while(position < group.getNumChildren())
+  {
+    const auto page = group.listChildren(position, 64);
+    REQUIRE_FALSE(page.empty());
+    for(const auto& child : page)
+    {
+      pagedNames.push_back(child.name);
+    }
+  }
+  REQUIRE(pagedNames == childNames);
+  REQUIRE(group.listChildren(position, 64).empty());
+
+  size_t numGroups = 0;
+  size_t numVisited = 0;
+  REQUIRE(group.forEachChild([&](const NX::H5Support::GroupIO::ChildInfo& child) {
+    numVisited++;
+    if(child.objectType == NX::H5Support::ObjectType::group)
+    {
+      numGroups++;
+    }
+    return true;
+  }) == 0);
+  REQUIRE(numVisited == k_NumGroups + 2);
+  REQUIRE(numGroups == k_NumGroups);
+
+  numVisited = 0;
+  REQUIRE(group.forEachChild([&](const NX::H5Support::GroupIO::ChildInfo&) { return ++numVisited < 10; }) == 0);
+  REQUIRE(numVisited == 10);
+}
+
+TEST_CASE("File Catalog", "H5Support")
+{
+  const std::filesystem::path filePath = NX::H5Support::constants::TestDataDir / "test_IO_Catalog.h5";
+  std::filesystem::remove(filePath);
+
+  auto fileResult = NX::H5Support::FileIO::CreateFile(filePath);
+  REQUIRE(fileResult.valid());
+  NX::H5Support::FileIO& file = fileResult.value();
+  {
+    auto group = file.createGroup(k_GroupName);
+    REQUIRE(group.isValid());
+    createDataset<int32_t>(group, k_DatasetInt32Name);
+    createDataset<float>(group, k_DatasetFloat32Name);
+    REQUIRE(group.createAttribute("Version").writeValue<int32_t>(2) == 0);
+
+    auto nestedGroup = group.createGroup("Nested");
+    REQUIRE(nestedGroup.isValid());
+    createDataset<uint8_t>(nestedGroup, k_DatasetUInt8Name);
+    REQUIRE(file.createGroup("Group2").isValid());
+    // Sorts between "Group" and the paths below it
+    REQUIRE(file.createGroup("Group-1").isValid());
+  }
+
+  auto catalogResult = NX::H5Support::FileCatalog::Build(file);
+  REQUIRE(catalogResult.valid());
+  const NX::H5Support::FileCatalog& catalog = catalogResult.value();
+  REQUIRE(catalog.size() == 7);
+
+  const auto* groupEntry = catalog.find("/Group");
+  REQUIRE(groupEntry != nullptr);
+  REQUIRE(groupEntry->objectType == NX::H5Support::ObjectType::group);
+  REQUIRE(groupEntry->numAttributes == 1);
+
+  const auto* datasetEntry = catalog.find("Group/Nested/UInt8");
+  REQUIRE(datasetEntry != nullptr);
+  REQUIRE(datasetEntry->objectType == NX::H5Support::ObjectType::dataset);
+  REQUIRE(datasetEntry->type == NX::H5Support::Type::uint8);
+  REQUIRE(datasetEntry->dims == NX::H5Support::DatasetIO::DimsType{k_DatasetSize});
+  REQUIRE(datasetEntry->layout == NX::H5Support::FileCatalog::Layout::Contiguous);
+  REQUIRE(catalog.find("Group/Missing") == nullptr);
+
+  REQUIRE(catalog.getPathsWithPrefix("Group/") == std::vector<std::string>{"Group/Float32", "Group/Int32", "Group/Nested", "Group/Nested/UInt8"});
+  REQUIRE(catalog.getPathsWithPrefix("/Group").size() == 7);
+  REQUIRE(catalog.getChildPaths("Group") == std::vector<std::string>{"Group/Float32", "Group/Int32", "Group/Nested"});
+  REQUIRE(catalog.getChildPaths("/") == std::vector<std::string>{"Group", "Group-1", "Group2"});
+
+  auto object = catalog.openObject("Group/Int32");
+  REQUIRE(object.isValid());
+  REQUIRE(object.getObjectId() == catalog.find("Group/Int32")->address);
+  REQUIRE_FALSE(catalog.openObject("Group/Missing").isValid());
+}
+
+TEST_CASE("File Catalog Index", "H5Support")
+{
+  const std::filesystem::path filePath = NX::H5Support::constants::TestDataDir / "test_IO_CatalogIndex.h5";
+  const std::filesystem::path indexPath = NX::H5Support::FileCatalog::IndexPath(filePath);
+  std::filesystem::remove(filePath);
+  std::filesystem::remove(indexPath);
+
+  {
+    auto fileResult = NX::H5Support::FileIO::CreateFile(filePath);
+    REQUIRE(fileResult.valid());
+    auto group = fileResult.value().createGroup(k_GroupName);
+    REQUIRE(group.isValid());
+    createDataset<double>(group, k_DatasetFloat64Name);
+    REQUIRE(group.createAttribute("Units").writeString("mm") == 0);
+  }
+
+  REQUIRE(NX::H5Support::FileCatalog::ReadIndex(indexPath, filePath).invalid());
+
+  auto builtResult = NX::H5Support::FileCatalog::LoadOrBuild(filePath);
+  REQUIRE(builtResult.valid());
+  REQUIRE(builtResult.value().size() == 2);
+  REQUIRE(std::filesystem::exists(indexPath));
+
+  auto indexResult = NX::H5Support::FileCatalog::ReadIndex(indexPath, filePath);
+  REQUIRE(indexResult.valid());
+  const NX::H5Support::FileCatalog& catalog = indexResult.value();
+  REQUIRE(catalog.hasDetails());
+  REQUIRE(catalog.size() == 2);
+  const auto* groupEntry = catalog.find(k_GroupName);
+  REQUIRE(groupEntry != nullptr);
+  REQUIRE(groupEntry->attributeNames == std::vector<std::string>{"Units"});
+  const auto* datasetEntry = catalog.find("Group/Float64");
+  REQUIRE(datasetEntry != nullptr);
+  REQUIRE(datasetEntry->type == NX::H5Support::Type::float64);
+  REQUIRE(datasetEntry->dims == NX::H5Support::DatasetIO::DimsType{k_DatasetSize});
+  REQUIRE(datasetEntry->layout == builtResult.value().find("Group/Float64")->layout);
+  REQUIRE(datasetEntry->address == builtResult.value().find("Group/Float64")->address);
+
+  // Modifying the file makes the index stale
+  {
+    auto fileResult = NX::H5Support::FileIO::Open(filePath, NX::H5Support::FileIO::Mode::ReadWrite);
+    REQUIRE(fileResult.valid());
+    auto group = fileResult.value().openGroup(k_GroupName);
+    createDataset<int8_t>(group, k_DatasetInt8Name);
+  }
+  REQUIRE(NX::H5Support::FileCatalog::ReadIndex(indexPath, filePath).invalid());
+
+  auto rebuiltResult = NX::H5Support::FileCatalog::LoadOrBuild(filePath);
+  REQUIRE(rebuiltResult.valid());
+  REQUIRE(rebuiltResult.value().size() == 3);
+  REQUIRE(NX::H5Support::FileCatalog::ReadIndex(indexPath, filePath).valid());
+
+  // An index with mistyped keys is rejected and rebuilt rather than throwing
+  for(const char* malformedIndex : {R"({"version":"x","file":{}})", R"({"version":1,"file":[]})", R"({"version":1})"})
+  {
+    {
+      std::ofstream indexFile(indexPath, std::ios::trunc);
+      indexFile << malformedIndex;
+    }
+    REQUIRE(NX::H5Support::FileCatalog::ReadIndex(indexPath, filePath).invalid());
+    auto recoveredResult = NX::H5Support::FileCatalog::LoadOrBuild(filePath);
+    REQUIRE(recoveredResult.valid());
+    REQUIRE(recoveredResult.value().size() == 3);
+  }
+  REQUIRE(NX::H5Support::FileCatalog::ReadIndex(indexPath, filePath).valid());
+}
+
+TEST_CASE("Group IO Open Or Create Path", "H5Support")
+{
+  const std::filesystem::path filePath = NX::H5Support::constants::TestDataDir / "test_IO_Paths.h5";
+  std::filesystem::remove(filePath);
+
+  auto fileResult = NX::H5Support::FileIO::CreateFile(filePath);
+  REQUIRE(fileResult.valid());
+  NX::H5Support::FileIO& file = fileResult.value();
+
+  REQUIRE_FALSE(NX::H5Support::Support::PathExists(file.getId(), "a/b/c/d"));
+  auto deepGroup = file.openOrCreatePath("a/b/c/d");
+  REQUIRE(deepGroup.isValid());
+  REQUIRE(NX::H5Support::Support::PathExists(file.getId(), "a/b/c/d"));
+  REQUIRE(NX::H5Support::Support::PathExists(file.getId(), "/a/b/"));
+  REQUIRE_FALSE(NX::H5Support::Support::PathExists(file.getId(), "a/x/c"));
+
+  auto reopenedGroup = file.openOrCreatePath("/a/b/c/d");
+  REQUIRE(reopenedGroup.isValid());
+  REQUIRE(reopenedGroup.getObjectId() == deepGroup.getObjectId());
+
+  auto intermediateGroup = file.openGroup("a").openOrCreatePath("b/c");
+  REQUIRE(intermediateGroup.isValid());
+  REQUIRE(intermediateGroup.getNumChildren() == 1);
+
+#ifndef H5Support_USE_MUTEX
+  // Without the library lock only a threadsafe HDF5 build may be called
+  // from several threads
+  if(!NX::H5Support::Support::IsLibraryThreadSafe())
+  {
+    WARN("Skipped: requires NXH5SUPPORT_ENABLE_MUTEX or a threadsafe HDF5 build");
+    return;
+  }
+#endif
+  constexpr size_t k_NumThreads = 8;
+  std::vector<std::thread> threads;
+  std::vector<int32_t> valid(k_NumThreads, 0);
+  for(size_t i = 0; i < k_NumThreads; i++)
+  {
+    threads.emplace_back([&, i]() {
+      auto sharedGroup = file.openOrCreatePath("shared/level/group");
+      auto ownGroup = file.openOrCreatePath(fmt::format("shared/level/group/thread_{}", i));
+      valid[i] = sharedGroup.isValid() && ownGroup.isValid();
+    });
+  }
+  for(auto& thread : threads)
+  {
+    thread.join();
+  }
+  REQUIRE(std::count(valid.begin(), valid.end(), 1) == k_NumThreads);
+  REQUIRE(file.openOrCreatePath("shared/level/group").getNumChildren() == k_NumThreads);
+}
+
+TEST_CASE("Group IO Link Storage", "H5Support")
+{
+  auto fileResult = NX::H5Support::FileIO::CreateInMemory();
+  REQUIRE(fileResult.valid());
+  NX::H5Support::FileIO& file = fileResult.value();
+
+  constexpr size_t k_NumChildren = 20;
+  auto largeGroup = file.createGroupForEntries("Large", 500000);
+  auto smallGroup = file.createGroupForEntries("Small", 10);
+  NX::H5Support::GroupOptions orderedOptions;
+  orderedOptions.indexLinkCreationOrder = true;
+  auto orderedGroup = file.createGroup("Ordered", orderedOptions);
+  REQUIRE(largeGroup.isValid());
+  REQUIRE(smallGroup.isValid());
+  REQUIRE(orderedGroup.isValid());
+  for(size_t i = 0; i < k_NumChildren; i++)
+  {
+    const std::string childName = fmt::format("Child_{}", k_NumChildren - i);
+    REQUIRE(largeGroup.createGroup(childName).isValid());
+    REQUIRE(smallGroup.createGroup(childName).isValid());
+    REQUIRE(orderedGroup.createGroup(childName).isValid());
+  }
+
+  H5G_info_t info;
+  REQUIRE(H5Gget_info(largeGroup.getId(), &info) >= 0);
+  REQUIRE(info.storage_type == H5G_STORAGE_TYPE_DENSE);
+  REQUIRE(info.nlinks == k_NumChildren);
+  REQUIRE(H5Gget_info(smallGroup.getId(), &info) >= 0);
+  REQUIRE(info.storage_type == H5G_STORAGE_TYPE_SYMBOL_TABLE);
+  REQUIRE(largeGroup.openGroup("Child_7").isValid());
+
+  char name[32];
+  REQUIRE(H5Lget_name_by_idx(orderedGroup.getId(), ".", H5_INDEX_CRT_ORDER, H5_ITER_INC, 0, name, sizeof(name), H5P_DEFAULT) > 0);
+  REQUIRE(std::string(name) == fmt::format("Child_{}", k_NumChildren));
+}
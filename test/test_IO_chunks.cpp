@@ -138,3 +138,108 @@ TEST_CASE("File IO Chunk", "H5Support")
     checkDatasetChunk<bool>(groupReader, k_DatasetBoolName);
   }
 }
+
+TEST_CASE("File IO Copy", "H5Support")
+{
+  auto sourceResult = NX::H5Support::FileIO::CreateInMemory();
+  REQUIRE(sourceResult.valid());
+  NX::H5Support::FileIO& sourceFile = sourceResult.value();
+  auto sourceGroup = sourceFile.createGroup(k_GroupName);
+  createDatasetChunk<int32_t>(sourceGroup, k_DatasetInt32Name);
+  createDatasetChunk<int64_t>(sourceGroup, k_DatasetInt64Name);
+  REQUIRE(sourceGroup.createAttribute("Version").writeValue<int32_t>(3) == 0);
+
+  auto destResult = NX::H5Support::FileIO::CreateInMemory();
+  REQUIRE(destResult.valid());
+  NX::H5Support::FileIO& destFile = destResult.value();
+
+  SECTION("Object Copy")
+  {
+    REQUIRE(destFile.copyFrom(sourceGroup, "Copies/Group") == 0);
+    auto copiedGroup = destFile.openGroup("Copies").openGroup(k_GroupName);
+    REQUIRE(copiedGroup.isValid());
+    REQUIRE(copiedGroup.getNumChildren() == 2);
+    REQUIRE(copiedGroup.getAttribute("Version").readAsValue<int32_t>() == 3);
+    checkDatasetChunk<int32_t>(copiedGroup, k_DatasetInt32Name);
+    checkDatasetChunk<int64_t>(copiedGroup, k_DatasetInt64Name);
+
+    NX::H5Support::CopyOptions options;
+    options.copyAttributes = false;
+    options.createIntermediateGroups = false;
+    REQUIRE(destFile.copyFrom(sourceGroup, "NoAttributes", options) == 0);
+    REQUIRE(destFile.openGroup("NoAttributes").getNumAttributes() == 0);
+    REQUIRE(destFile.copyFrom(sourceGroup, "Missing/Group", options) < 0);
+  }
+
+  SECTION("Raw Chunk Copy")
+  {
+    auto sourceDataset = sourceGroup.openDataset(k_DatasetInt32Name);
+    REQUIRE(sourceDataset.open());
+
+    auto merged = destFile.createDataset("Merged");
+    merged.createOrOpenExtendibleDataset<int32_t>({k_ChunkSize}, {k_ChunkSize});
+    REQUIRE(merged.getId() > 0);
+    const std::vector<hsize_t> secondOffset{2 * k_ChunkSize};
+    REQUIRE(merged.copyChunksFrom(sourceDataset) == 0);
+    REQUIRE(merged.copyChunksFrom(sourceDataset, secondOffset) == 0);
+    REQUIRE(merged.getDimensions() == std::vector<hsize_t>{4 * k_ChunkSize});
+
+    auto values = merged.readAsVector<int32_t>();
+    REQUIRE(values.size() == 4 * k_ChunkSize);
+    for(size_t i = 0; i < k_ChunkSize; i++)
+    {
+      REQUIRE(values[i] == static_cast<int32_t>(i));
+      REQUIRE(values[k_ChunkSize + i] == static_cast<int32_t>(i * 2));
+      REQUIRE(values[2 * k_ChunkSize + i] == static_cast<int32_t>(i));
+      REQUIRE(values[3 * k_ChunkSize + i] == static_cast<int32_t>(i * 2));
+    }
+
+    const std::vector<hsize_t> unalignedOffset{1};
+    REQUIRE(merged.copyChunksFrom(sourceDataset, unalignedOffset) < 0);
+    auto otherType = sourceGroup.openDataset(k_DatasetInt64Name);
+    REQUIRE(otherType.open());
+    REQUIRE(merged.copyChunksFrom(otherType) < 0);
+
+    // The partial edge chunk must not overwrite merged values past the
+    // source's edge with its padding
+    constexpr size_t partialSize = k_ChunkSize + 2;
+    std::vector<int32_t> partialValues(partialSize);
+    for(size_t i = 0; i < partialSize; i++)
+    {
+      partialValues[i] = static_cast<int32_t>(100 + i);
+    }
+    auto partial = sourceGroup.createDataset("Partial");
+    partial.createOrOpenExtendibleDataset<int32_t>({partialSize}, {k_ChunkSize});
+    REQUIRE(partial.writeSpan<int32_t>({partialSize}, partialValues) == 0);
+    REQUIRE(merged.copyChunksFrom(partial) == 0);
+    const std::vector<hsize_t> endOffset{4 * k_ChunkSize};
+    REQUIRE(merged.copyChunksFrom(partial, endOffset) == 0);
+    REQUIRE(merged.getDimensions() == std::vector<hsize_t>{4 * k_ChunkSize + partialSize});
+
+    values = merged.readAsVector<int32_t>();
+    REQUIRE(values.size() == 4 * k_ChunkSize + partialSize);
+    for(size_t i = 0; i < partialSize; i++)
+    {
+      REQUIRE(values[i] == partialValues[i]);
+      REQUIRE(values[4 * k_ChunkSize + i] == partialValues[i]);
+    }
+    for(size_t i = partialSize; i < 2 * k_ChunkSize; i++)
+    {
+      REQUIRE(values[i] == static_cast<int32_t>((i - k_ChunkSize) * 2));
+    }
+
+    // Filters with the same id but other settings cannot share raw chunks
+    hid_t propertiesId = H5Pcreate(H5P_DATASET_CREATE);
+    const hsize_t chunkDims[] = {k_ChunkSize};
+    H5Pset_chunk(propertiesId, 1, chunkDims);
+    H5Pset_deflate(propertiesId, 1);
+    auto deflate1 = sourceGroup.createDataset("Deflate1");
+    deflate1.createOrOpenDataset<int32_t>({k_DatasetSize}, propertiesId);
+    const unsigned deflateLevel = 9;
+    H5Pmodify_filter(propertiesId, H5Z_FILTER_DEFLATE, H5Z_FLAG_OPTIONAL, 1, &deflateLevel);
+    auto deflate9 = destFile.createDataset("Deflate9");
+    deflate9.createOrOpenDataset<int32_t>({k_DatasetSize}, propertiesId);
+    H5Pclose(propertiesId);
+    REQUIRE(deflate9.copyChunksFrom(deflate1) < 0);
+  }
+}
@@ -0,0 +1,969 @@
+#include <catch2/catch.hpp>
+
+#include "NX/H5Support/H5Support.hpp"
+#include "NX/H5Support/IO/DatasetIO.hpp"
+#include "NX/H5Support/IO/FileIO.hpp"
+#include "NX/H5Support/Instrumentation.hpp"
+#include "NX/H5Support/TestGenConstants.hpp"
+#include "NX/H5Support/Tracing.hpp"
+
+#include <fmt/format.h>
+
+#include "nonstd/span.hpp"
+#include <atomic>
+#include <fstream>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+using namespace NX::H5Support;
+
+namespace
+{
+inline const std::string k_SwmrFileName = "test_IO_SWMR.h5";
+inline const std::string k_DatasetName = "Frames";
+inline const std::string k_DriverDatasetName = "Data";
+
+constexpr size_t k_DatasetSize = 10;
+constexpr size_t k_ChunkSize = 5;
+
+void writeDriverFile(const std::filesystem::path& filePath, const FileOptions& options)
+{
+  auto fileResult = FileIO::CreateFile(filePath, options);
+  REQUIRE(fileResult.valid());
+
+  std::vector<int32_t> values(k_DatasetSize);
+  for(size_t i = 0; i < k_DatasetSize; i++)
+  {
+    values[i] = static_cast<int32_t>(i);
+  }
+  auto datasetWriter = fileResult.value().createDataset(k_DriverDatasetName);
+  REQUIRE(datasetWriter.writeSpan<int32_t>({k_DatasetSize}, values) == 0);
+}
+
+void checkDriverFile(const std::filesystem::path& filePath, const FileOptions& options)
+{
+  FileIO fileReader(filePath, options);
+  REQUIRE(fileReader.isValid());
+
+  auto datasetReader = fileReader.openDataset(k_DriverDatasetName);
+  REQUIRE(datasetReader.open());
+  auto values = datasetReader.readAsVector<int32_t>();
+  REQUIRE(values.size() == k_DatasetSize);
+  for(size_t i = 0; i < k_DatasetSize; i++)
+  {
+    REQUIRE(values[i] == static_cast<int32_t>(i));
+  }
+}
+
+} // namespace
+
+TEST_CASE("File IO Drivers", "H5Support")
+{
+  SECTION("Core with backing store")
+  {
+    const std::filesystem::path filePath = constants::TestDataDir / "test_IO_Core.h5";
+    std::filesystem::remove(filePath);
+
+    FileOptions options;
+    options.driver = FileOptions::Driver::Core;
+    options.coreBackingStore = true;
+    writeDriverFile(filePath, options);
+    REQUIRE(std::filesystem::exists(filePath));
+    checkDriverFile(filePath, {});
+  }
+
+  SECTION("Family")
+  {
+    const std::filesystem::path filePath = constants::TestDataDir / "test_IO_Family_%d.h5";
+    FileOptions options;
+    options.driver = FileOptions::Driver::Family;
+    options.familyMemberSize = 1024;
+    std::filesystem::remove(constants::TestDataDir / "test_IO_Family_0.h5");
+    REQUIRE(!options.fileExists(filePath));
+
+    writeDriverFile(filePath, options);
+    REQUIRE(options.fileExists(filePath));
+    REQUIRE(std::filesystem::exists(constants::TestDataDir / "test_IO_Family_1.h5"));
+    checkDriverFile(filePath, options);
+  }
+
+  SECTION("Split")
+  {
+    const std::filesystem::path filePath = constants::TestDataDir / "test_IO_Split";
+    FileOptions options;
+    options.driver = FileOptions::Driver::Split;
+    std::filesystem::remove(filePath.string() + options.splitMetadataExtension);
+    std::filesystem::remove(filePath.string() + options.splitRawDataExtension);
+
+    writeDriverFile(filePath, options);
+    REQUIRE(std::filesystem::exists(filePath.string() + options.splitRawDataExtension));
+    checkDriverFile(filePath, options);
+  }
+
+  SECTION("Stdio")
+  {
+    const std::filesystem::path filePath = constants::TestDataDir / "test_IO_Stdio.h5";
+    std::filesystem::remove(filePath);
+
+    FileOptions options;
+    options.driver = FileOptions::Driver::Stdio;
+    writeDriverFile(filePath, options);
+    checkDriverFile(filePath, options);
+  }
+
+  SECTION("IoUring")
+  {
+    const std::filesystem::path filePath = constants::TestDataDir / "test_IO_IoUring.h5";
+    constexpr size_t k_LargeDatasetSize = 1024 * 1024;
+
+    for(bool useIoUring : {true, false})
+    {
+      std::filesystem::remove(filePath);
+
+      FileOptions options;
+      options.driver = FileOptions::Driver::IoUring;
+      options.ioUring.useIoUring = useIoUring;
+      options.ioUring.queueDepth = 8;
+      options.ioUring.segmentSize = 64 * 1024;
+      options.ioUring.readaheadSize = 256 * 1024;
+      writeDriverFile(filePath, options);
+      checkDriverFile(filePath, options);
+      checkDriverFile(filePath, {});
+
+      std::vector<int32_t> expected(k_LargeDatasetSize);
+      for(size_t i = 0; i < k_LargeDatasetSize; i++)
+      {
+        expected[i] = static_cast<int32_t>(i * 3);
+      }
+      {
+        auto fileResult = FileIO::Open(filePath, FileIO::Mode::ReadWrite, options);
+        REQUIRE(fileResult.valid());
+        auto datasetWriter = fileResult.value().createDataset(k_DatasetName);
+        REQUIRE(datasetWriter.writeSpan<int32_t>({k_LargeDatasetSize}, expected) == 0);
+      }
+
+      FileIO fileReader(filePath, options);
+      REQUIRE(fileReader.isValid());
+      auto datasetReader = fileReader.openDataset(k_DatasetName);
+      REQUIRE(datasetReader.open());
+      REQUIRE(datasetReader.readAsVector<int32_t>() == expected);
+    }
+  }
+}
+
+TEST_CASE("File IO Paged Aggregation", "H5Support")
+{
+  const std::filesystem::path pagedFilePath = constants::TestDataDir / "test_IO_Paged.h5";
+  const std::filesystem::path plainFilePath = constants::TestDataDir / "test_IO_NotPaged.h5";
+  std::filesystem::remove(pagedFilePath);
+  std::filesystem::remove(plainFilePath);
+
+  FileOptions options;
+  options.pagedAggregation = true;
+  options.pageSize = 8192;
+  options.pageBufferSize = 4 * 8192;
+  writeDriverFile(pagedFilePath, options);
+  writeDriverFile(plainFilePath, {});
+
+  {
+    FileIO fileReader(pagedFilePath, options);
+    REQUIRE(fileReader.isValid());
+    hid_t creationPropertiesId = H5Fget_create_plist(fileReader.getId());
+    H5F_fspace_strategy_t strategy;
+    hbool_t persist = false;
+    hsize_t threshold = 0;
+    hsize_t pageSize = 0;
+    REQUIRE(H5Pget_file_space_strategy(creationPropertiesId, &strategy, &persist, &threshold) >= 0);
+    REQUIRE(H5Pget_file_space_page_size(creationPropertiesId, &pageSize) >= 0);
+    H5Pclose(creationPropertiesId);
+    REQUIRE(strategy == H5F_FSPACE_STRATEGY_PAGE);
+    REQUIRE(pageSize == 8192);
+  }
+  checkDriverFile(pagedFilePath, options);
+
+  // The page buffer is skipped for files created without paged aggregation.
+  checkDriverFile(plainFilePath, options);
+
+  // Other page buffer errors are not hidden by dropping the page buffer
+  FileOptions smallBufferOptions = options;
+  smallBufferOptions.pageBufferSize = 4096;
+  REQUIRE_FALSE(FileIO(pagedFilePath, smallBufferOptions).isValid());
+}
+
+TEST_CASE("File IO Metadata Cache", "H5Support")
+{
+  const std::filesystem::path filePath = constants::TestDataDir / "test_IO_MetadataCache.h5";
+  std::filesystem::remove(filePath);
+  writeDriverFile(filePath, {});
+
+  // Conflicting sizes are rejected instead of being clamped
+  FileOptions invalidOptions;
+  invalidOptions.metadataCacheMinSize = 8 * 1024 * 1024;
+  invalidOptions.metadataCacheMaxSize = 1024 * 1024;
+  REQUIRE_FALSE(FileIO(filePath, invalidOptions).isValid());
+  invalidOptions.metadataCacheMinSize = 0;
+  invalidOptions.metadataCacheInitialSize = 2 * 1024 * 1024;
+  REQUIRE_FALSE(FileIO(filePath, invalidOptions).isValid());
+
+  // HDF5's default sizes are fitted into a small maximum
+  FileOptions smallOptions;
+  smallOptions.metadataCacheMaxSize = 512 * 1024;
+  REQUIRE(FileIO(filePath, smallOptions).isValid());
+
+  FileOptions options;
+  options.metadataCacheMinSize = 1024 * 1024;
+  options.metadataCacheMaxSize = 8 * 1024 * 1024;
+  options.evictOnClose = true;
+  options.metadataReadAttempts = 10;
+  options.chunkCacheSize = 4 * 1024 * 1024;
+
+  FileIO fileReader(filePath, options);
+  REQUIRE(fileReader.isValid());
+
+  hid_t accessPropertiesId = H5Fget_access_plist(fileReader.getId());
+  int32_t metadataElements = 0;
+  size_t chunkCacheSlots = 0;
+  size_t chunkCacheSize = 0;
+  double preemption = 0.0;
+  REQUIRE(H5Pget_cache(accessPropertiesId, &metadataElements, &chunkCacheSlots, &chunkCacheSize, &preemption) >= 0);
+  H5Pclose(accessPropertiesId);
+  REQUIRE(chunkCacheSize == options.chunkCacheSize);
+
+  H5AC_cache_config_t config{};
+  config.version = H5AC__CURR_CACHE_CONFIG_VERSION;
+  REQUIRE(H5Fget_mdc_config(fileReader.getId(), &config) >= 0);
+  REQUIRE(config.min_size == options.metadataCacheMinSize);
+  REQUIRE(config.max_size == options.metadataCacheMaxSize);
+
+  REQUIRE(fileReader.resizeMetadataCache(2 * 1024 * 1024, 512 * 1024) >= 0);
+  REQUIRE(H5Fget_mdc_config(fileReader.getId(), &config) >= 0);
+  REQUIRE(config.min_size == 512 * 1024);
+  REQUIRE(config.max_size == 2 * 1024 * 1024);
+  REQUIRE(fileReader.resizeMetadataCache(512 * 1024, 2 * 1024 * 1024) < 0);
+
+  checkDriverFile(filePath, options);
+}
+
+TEST_CASE("File IO In-Memory Image", "H5Support")
+{
+  std::vector<std::byte> image;
+  {
+    auto fileResult = FileIO::CreateInMemory();
+    REQUIRE(fileResult.valid());
+    FileIO& fileWriter = fileResult.value();
+
+    auto groupWriter = fileWriter.createGroup("Group");
+    REQUIRE(groupWriter.isValid());
+    std::vector<int32_t> values(k_DatasetSize);
+    for(size_t i = 0; i < k_DatasetSize; i++)
+    {
+      values[i] = static_cast<int32_t>(i);
+    }
+    auto datasetWriter = groupWriter.createDataset(k_DriverDatasetName);
+    REQUIRE(datasetWriter.writeSpan<int32_t>({k_DatasetSize}, values) == 0);
+
+    image = fileWriter.toImage();
+    REQUIRE(!image.empty());
+  }
+
+  auto fileResult = FileIO::OpenFromImage(image);
+  REQUIRE(fileResult.valid());
+  auto groupReader = fileResult.value().openGroup("Group");
+  REQUIRE(groupReader.isValid());
+  auto datasetReader = groupReader.openDataset(k_DriverDatasetName);
+  REQUIRE(datasetReader.open());
+  auto values = datasetReader.readAsVector<int32_t>();
+  REQUIRE(values.size() == k_DatasetSize);
+  for(size_t i = 0; i < k_DatasetSize; i++)
+  {
+    REQUIRE(values[i] == static_cast<int32_t>(i));
+  }
+}
+
+TEST_CASE("File IO Open Modes", "H5Support")
+{
+  const std::filesystem::path filePath = constants::TestDataDir / "test_IO_OpenModes.h5";
+  std::filesystem::remove(filePath);
+
+  REQUIRE(FileIO::Open(filePath, FileIO::Mode::ReadOnly).invalid());
+  REQUIRE(FileIO::Open(filePath, FileIO::Mode::ReadWrite).invalid());
+
+  {
+    auto fileResult = FileIO::Open(filePath, FileIO::Mode::Create, FileOptions::ManySmallObjects());
+    REQUIRE(fileResult.valid());
+    std::vector<int32_t> values(k_DatasetSize, 0);
+    auto datasetWriter = fileResult.value().createDataset(k_DriverDatasetName);
+    REQUIRE(datasetWriter.writeSpan<int32_t>({k_DatasetSize}, values) == 0);
+  }
+  REQUIRE(FileIO::Open(filePath, FileIO::Mode::Create).invalid());
+
+  {
+    auto fileResult = FileIO::Open(filePath, FileIO::Mode::ReadWrite, FileOptions::StreamingAppend());
+    REQUIRE(fileResult.valid());
+    std::vector<int32_t> values(k_DatasetSize);
+    for(size_t i = 0; i < k_DatasetSize; i++)
+    {
+      values[i] = static_cast<int32_t>(i);
+    }
+    auto datasetWriter = fileResult.value().openDataset(k_DriverDatasetName);
+    REQUIRE(datasetWriter.open());
+    REQUIRE(datasetWriter.writeSpan<int32_t>({k_DatasetSize}, values) == 0);
+  }
+
+  {
+    auto fileResult = FileIO::Open(filePath, FileIO::Mode::ReadOnly, FileOptions::ReadMostlyLargeChunks());
+    REQUIRE(fileResult.valid());
+  }
+  checkDriverFile(filePath, FileOptions::ReadMostlyLargeChunks());
+
+  {
+    auto fileResult = FileIO::Open(filePath, FileIO::Mode::Truncate);
+    REQUIRE(fileResult.valid());
+    REQUIRE(fileResult.value().getNumChildren() == 0);
+  }
+}
+
+TEST_CASE("File IO Direct Reads", "H5Support")
+{
+  const std::filesystem::path filePath = constants::TestDataDir / "test_IO_DirectReads.h5";
+  const DatasetIO::DimsType contiguousDims = {65536};
+  const DatasetIO::DimsType chunkedDims = {100, 150};
+  const DatasetIO::DimsType chunkDims = {32, 64};
+
+  {
+    auto fileResult = FileIO::Open(filePath, FileIO::Mode::Truncate, FileOptions::DirectIO());
+    REQUIRE(fileResult.valid());
+    auto& fileWriter = fileResult.value();
+
+    std::vector<int32_t> values(contiguousDims[0]);
+    for(size_t i = 0; i < values.size(); i++)
+    {
+      values[i] = static_cast<int32_t>(i);
+    }
+    auto contiguousWriter = fileWriter.createDataset("Contiguous");
+    REQUIRE(contiguousWriter.writeSpan<int32_t>(contiguousDims, values) == 0);
+
+    std::vector<float> chunkedValues(chunkedDims[0] * chunkedDims[1]);
+    for(size_t i = 0; i < chunkedValues.size(); i++)
+    {
+      chunkedValues[i] = static_cast<float>(i) * 0.5f;
+    }
+    auto chunkedWriter = fileWriter.createDataset("Chunked");
+    chunkedWriter.createOrOpenChunkedDataset<float>(chunkedDims, chunkDims);
+    REQUIRE(chunkedWriter.writeSpan<float>(chunkedDims, chunkedValues) == 0);
+  }
+
+  auto fileResult = FileIO::Open(filePath, FileIO::Mode::ReadOnly);
+  REQUIRE(fileResult.valid());
+  auto& fileReader = fileResult.value();
+
+  auto contiguousReader = fileReader.openDataset("Contiguous");
+  REQUIRE(contiguousReader.open());
+  REQUIRE(contiguousReader.isAligned(4096));
+  std::vector<int32_t> values(contiguousDims[0], -1);
+  nonstd::span<int32_t> valuesSpan(values);
+  REQUIRE(contiguousReader.readIntoSpanDirect<int32_t>(valuesSpan));
+  for(size_t i = 0; i < values.size(); i++)
+  {
+    REQUIRE(values[i] == static_cast<int32_t>(i));
+  }
+
+  auto chunkedReader = fileReader.openDataset("Chunked");
+  REQUIRE(chunkedReader.open());
+  REQUIRE(chunkedReader.isAligned(4096));
+  std::vector<float> chunkedValues(chunkedDims[0] * chunkedDims[1], -1.0f);
+  nonstd::span<float> chunkedSpan(chunkedValues);
+  REQUIRE(chunkedReader.readIntoSpanDirect<float>(chunkedSpan));
+  for(size_t i = 0; i < chunkedValues.size(); i++)
+  {
+    REQUIRE(chunkedValues[i] == static_cast<float>(i) * 0.5f);
+  }
+
+  // Type conversion falls back to a regular read
+  std::vector<double> converted(contiguousDims[0]);
+  nonstd::span<double> convertedSpan(converted);
+  REQUIRE(contiguousReader.readIntoSpanDirect<double>(convertedSpan));
+  REQUIRE(converted.back() == static_cast<double>(contiguousDims[0] - 1));
+
+  // Alignment counts the user block, which HDF5 addresses leave out. With a
+  // 2048 byte user block, exactly one of the relative and the absolute
+  // address is a multiple of 4096.
+  {
+    const std::filesystem::path userBlockPath = constants::TestDataDir / "test_IO_DirectReadsUserBlock.h5";
+    hid_t creationPropertiesId = H5Pcreate(H5P_FILE_CREATE);
+    H5Pset_userblock(creationPropertiesId, 2048);
+    hid_t accessPropertiesId = H5Pcreate(H5P_FILE_ACCESS);
+    H5Pset_alignment(accessPropertiesId, 2048, 2048);
+    hid_t fileId = H5Fcreate(userBlockPath.string().c_str(), H5F_ACC_TRUNC, creationPropertiesId, accessPropertiesId);
+    H5Pclose(accessPropertiesId);
+    H5Pclose(creationPropertiesId);
+    REQUIRE(fileId >= 0);
+    hid_t spaceId = H5Screate_simple(1, contiguousDims.data(), nullptr);
+    hid_t datasetId = H5Dcreate2(fileId, "Contiguous", H5T_NATIVE_INT32, spaceId, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+    REQUIRE(H5Dwrite(datasetId, H5T_NATIVE_INT32, H5S_ALL, H5S_ALL, H5P_DEFAULT, values.data()) >= 0);
+    H5Dclose(datasetId);
+    H5Sclose(spaceId);
+    H5Fclose(fileId);
+
+    auto userBlockResult = FileIO::Open(userBlockPath, FileIO::Mode::ReadOnly);
+    REQUIRE(userBlockResult.valid());
+    auto userBlockReader = userBlockResult.value().openDataset("Contiguous");
+    REQUIRE(userBlockReader.open());
+    const haddr_t address = H5Dget_offset(userBlockReader.getId());
+    REQUIRE(address % 2048 == 0);
+    REQUIRE(userBlockReader.isAligned(2048));
+    REQUIRE(userBlockReader.isAligned(4096) == ((address + 2048) % 4096 == 0));
+  }
+
+#ifdef __linux__
+  // Filesystems such as tmpfs reject O_DIRECT, in which case every direct
+  // read falls back to a regular one
+  const int probeDescriptor = ::open(filePath.string().c_str(), O_RDONLY | O_DIRECT);
+  if(probeDescriptor < 0)
+  {
+    WARN("Skipped: the test data directory does not support O_DIRECT");
+    return;
+  }
+  ::close(probeDescriptor);
+
+  // Patching the file behind HDF5's back shows the direct path is taken, as
+  // a regular read would still see the cached chunk. With a writable file,
+  // pending writes are flushed before the direct read.
+  {
+    const std::filesystem::path writablePath = constants::TestDataDir / "test_IO_DirectReadsWritable.h5";
+    std::filesystem::copy_file(filePath, writablePath, std::filesystem::copy_options::overwrite_existing);
+    auto writableResult = FileIO::Open(writablePath, FileIO::Mode::ReadWrite);
+    REQUIRE(writableResult.valid());
+    auto chunkedWriter = writableResult.value().openDataset("Chunked");
+    REQUIRE(chunkedWriter.open());
+    REQUIRE(chunkedWriter.readIntoSpan<float>(chunkedSpan));
+
+    const hsize_t firstChunk[] = {0, 0};
+    unsigned filterMask = 0;
+    haddr_t address = HADDR_UNDEF;
+    hsize_t chunkBytes = 0;
+    REQUIRE(H5Dget_chunk_info_by_coord(chunkedWriter.getId(), firstChunk, &filterMask, &address, &chunkBytes) >= 0);
+    const float patchedValue = -7.0f;
+    {
+      std::fstream file(writablePath, std::ios::in | std::ios::out | std::ios::binary);
+      file.seekp(static_cast<std::streamoff>(address));
+      file.write(reinterpret_cast<const char*>(&patchedValue), sizeof(patchedValue));
+    }
+    REQUIRE(chunkedWriter.readIntoSpanDirect<float>(chunkedSpan));
+    REQUIRE(chunkedValues[0] == patchedValue);
+    REQUIRE(chunkedValues[1] == 0.5f);
+
+    // A small write to the contiguous dataset stays in the sieve buffer
+    auto contiguousWriter = writableResult.value().openDataset("Contiguous");
+    REQUIRE(contiguousWriter.open());
+    REQUIRE(contiguousWriter.isAligned(4096));
+    const int32_t writtenValue = -3;
+    const hsize_t count[] = {1};
+    const hsize_t start[] = {0};
+    hid_t memorySpaceId = H5Screate_simple(1, count, nullptr);
+    hid_t fileSpaceId = H5Dget_space(contiguousWriter.getId());
+    H5Sselect_hyperslab(fileSpaceId, H5S_SELECT_SET, start, nullptr, count, nullptr);
+    REQUIRE(H5Dwrite(contiguousWriter.getId(), H5T_NATIVE_INT32, memorySpaceId, fileSpaceId, H5P_DEFAULT, &writtenValue) >= 0);
+    H5Sclose(fileSpaceId);
+    H5Sclose(memorySpaceId);
+    REQUIRE(contiguousWriter.readIntoSpanDirect<int32_t>(valuesSpan));
+    REQUIRE(values[0] == writtenValue);
+    REQUIRE(values[1] == 1);
+  }
+#endif
+}
+
+TEST_CASE("File IO Concurrent Reads", "H5Support")
+{
+#ifndef H5Support_USE_MUTEX
+  // Without the library lock only a threadsafe HDF5 build may be called
+  // from several threads
+  if(!Support::IsLibraryThreadSafe())
+  {
+    WARN("Skipped: requires NXH5SUPPORT_ENABLE_MUTEX or a threadsafe HDF5 build");
+    return;
+  }
+#endif
+
+  const std::filesystem::path filePath = constants::TestDataDir / "test_IO_ConcurrentReads.h5";
+  constexpr size_t k_NumDatasets = 8;
+  constexpr size_t k_NumValues = 4096;
+
+  {
+    auto fileResult = FileIO::Open(filePath, FileIO::Mode::Truncate);
+    REQUIRE(fileResult.valid());
+    for(size_t i = 0; i < k_NumDatasets; i++)
+    {
+      std::vector<int64_t> values(k_NumValues, static_cast<int64_t>(i));
+      auto datasetWriter = fileResult.value().createDataset(fmt::format("Data_{}", i));
+      REQUIRE(datasetWriter.writeSpan<int64_t>({k_NumValues}, values) == 0);
+    }
+  }
+
+  FileIO fileReader(filePath);
+  REQUIRE(fileReader.isValid());
+
+  std::atomic<size_t> numFailures = 0;
+  std::vector<std::thread> threads;
+  for(size_t i = 0; i < k_NumDatasets; i++)
+  {
+    threads.emplace_back([&fileReader, &numFailures, i]() {
+      for(size_t repeat = 0; repeat < 10; repeat++)
+      {
+        auto datasetReader = fileReader.openDataset(fmt::format("Data_{}", i));
+        if(!datasetReader.open() || datasetReader.readAsVector<int64_t>() != std::vector<int64_t>(k_NumValues, static_cast<int64_t>(i)))
+        {
+          numFailures++;
+        }
+      }
+    });
+  }
+  for(auto& thread : threads)
+  {
+    thread.join();
+  }
+  REQUIRE(numFailures == 0);
+}
+
+TEST_CASE("File IO SWMR", "H5Support")
+{
+  const std::filesystem::path filePath = constants::TestDataDir / k_SwmrFileName;
+  std::filesystem::remove(filePath);
+
+  auto writeFrame = [](DatasetIO& datasetWriter, size_t frame) {
+    std::vector<int32_t> values(k_ChunkSize);
+    for(size_t i = 0; i < k_ChunkSize; i++)
+    {
+      values[i] = static_cast<int32_t>(frame * k_ChunkSize + i);
+    }
+    const DatasetIO::DimsType dims{(frame + 1) * k_ChunkSize};
+    REQUIRE(datasetWriter.setExtent(dims) >= 0);
+    std::vector<hsize_t> offset{frame * k_ChunkSize};
+    REQUIRE(datasetWriter.writeChunk<int32_t>(dims, values, {k_ChunkSize}, offset) == 0);
+    REQUIRE(datasetWriter.flush() >= 0);
+  };
+
+#ifdef __linux__
+  // The reader runs in a child process forked before the writer opens the
+  // file, so that it does not share the writer's open file and only sees
+  // what the writer has flushed. Pipes order the two processes.
+  struct ReaderProcess
+  {
+    int readerReady[2] = {-1, -1};
+    int writerExtended[2] = {-1, -1};
+    pid_t pid = -1;
+
+    // Closing the pipes unblocks the reader should the writer fail early
+    ~ReaderProcess()
+    {
+      for(int fileDescriptor : {readerReady[0], readerReady[1], writerExtended[0], writerExtended[1]})
+      {
+        if(fileDescriptor >= 0)
+        {
+          ::close(fileDescriptor);
+        }
+      }
+      if(pid > 0)
+      {
+        ::waitpid(pid, nullptr, 0);
+      }
+    }
+  } reader;
+  int* readerReady = reader.readerReady;
+  int* writerExtended = reader.writerExtended;
+  REQUIRE(::pipe(readerReady) == 0);
+  REQUIRE(::pipe(writerExtended) == 0);
+  pid_t readerPid = ::fork();
+  REQUIRE(readerPid >= 0);
+  if(readerPid == 0)
+  {
+    ::close(readerReady[0]);
+    ::close(writerExtended[1]);
+    char signal = 0;
+    int status = 1;
+    if(::read(writerExtended[0], &signal, 1) == 1)
+    {
+      auto fileResult = FileIO::OpenSwmrReader(filePath);
+      if(fileResult.valid())
+      {
+        auto datasetReader = fileResult.value().openDataset(k_DatasetName);
+        const bool sawFirstFrame = datasetReader.open() && datasetReader.getNumElements() == k_ChunkSize;
+        if(::write(readerReady[1], &signal, 1) == 1 && ::read(writerExtended[0], &signal, 1) == 1 && sawFirstFrame && datasetReader.refresh() >= 0)
+        {
+          auto values = datasetReader.readAsVector<int32_t>();
+          status = values.size() == 2 * k_ChunkSize ? 0 : 2;
+          for(size_t i = 0; i < values.size() && status == 0; i++)
+          {
+            status = values[i] == static_cast<int32_t>(i) ? 0 : 3;
+          }
+        }
+      }
+    }
+    ::_exit(status);
+  }
+  reader.pid = readerPid;
+  ::close(readerReady[1]);
+  ::close(writerExtended[0]);
+  readerReady[1] = -1;
+  writerExtended[0] = -1;
+
+  {
+    auto fileResult = FileIO::CreateSwmrFile(filePath, FileOptions::StreamingAppend());
+    REQUIRE(fileResult.valid());
+    FileIO& fileWriter = fileResult.value();
+
+    auto datasetWriter = fileWriter.createDataset(k_DatasetName);
+    datasetWriter.createOrOpenExtendibleDataset<int32_t>({k_ChunkSize}, {k_ChunkSize});
+    REQUIRE(datasetWriter.getId() > 0);
+
+    REQUIRE(fileWriter.startSwmrWrite() >= 0);
+    REQUIRE(fileWriter.isSwmr());
+
+    // The reader opens the file while the writer still holds it and must
+    // refresh to see the second frame
+    writeFrame(datasetWriter, 0);
+    char signal = 1;
+    REQUIRE(::write(writerExtended[1], &signal, 1) == 1);
+    REQUIRE(::read(readerReady[0], &signal, 1) == 1);
+    writeFrame(datasetWriter, 1);
+    REQUIRE(::write(writerExtended[1], &signal, 1) == 1);
+
+    int status = -1;
+    REQUIRE(::waitpid(readerPid, &status, 0) == readerPid);
+    reader.pid = -1;
+    REQUIRE(WIFEXITED(status));
+    REQUIRE(WEXITSTATUS(status) == 0);
+  }
+#else
+  {
+    auto fileResult = FileIO::CreateSwmrFile(filePath, FileOptions::StreamingAppend());
+    REQUIRE(fileResult.valid());
+    FileIO& fileWriter = fileResult.value();
+
+    auto datasetWriter = fileWriter.createDataset(k_DatasetName);
+    datasetWriter.createOrOpenExtendibleDataset<int32_t>({k_ChunkSize}, {k_ChunkSize});
+    REQUIRE(datasetWriter.getId() > 0);
+
+    REQUIRE(fileWriter.startSwmrWrite() >= 0);
+    REQUIRE(fileWriter.isSwmr());
+    writeFrame(datasetWriter, 0);
+    writeFrame(datasetWriter, 1);
+  }
+#endif
+
+  {
+    auto fileResult = FileIO::OpenSwmrReader(filePath);
+    REQUIRE(fileResult.valid());
+    FileIO& fileReader = fileResult.value();
+    REQUIRE(fileReader.isSwmr());
+
+    auto datasetReader = fileReader.openDataset(k_DatasetName);
+    REQUIRE(datasetReader.open());
+    REQUIRE(datasetReader.refresh() >= 0);
+
+    auto values = datasetReader.readAsVector<int32_t>();
+    REQUIRE(values.size() == 2 * k_ChunkSize);
+    for(size_t i = 0; i < values.size(); i++)
+    {
+      REQUIRE(values[i] == static_cast<int32_t>(i));
+    }
+  }
+}
+
+TEST_CASE("File IO Dataset Cache", "H5Support")
+{
+  auto fileResult = FileIO::CreateInMemory();
+  REQUIRE(fileResult.valid());
+  FileIO& file = fileResult.value();
+
+  constexpr size_t k_NumDatasets = 4;
+  for(size_t i = 0; i < k_NumDatasets; i++)
+  {
+    std::vector<int32_t> values(k_DatasetSize, static_cast<int32_t>(i));
+    auto datasetWriter = file.createDataset(fmt::format("Data_{}", i));
+    REQUIRE(datasetWriter.writeSpan<int32_t>({k_DatasetSize}, values) == 0);
+  }
+
+  SECTION("Disabled")
+  {
+    REQUIRE(file.getDatasetCacheCapacity() == 0);
+    auto first = file.openCachedDataset("Data_0");
+    auto second = file.openCachedDataset("Data_0");
+    REQUIRE(first != nullptr);
+    REQUIRE(first != second);
+    REQUIRE(file.openCachedDataset("Missing") == nullptr);
+  }
+
+  SECTION("Eviction")
+  {
+    file.setDatasetCacheCapacity(2);
+    auto data0 = file.openCachedDataset("Data_0");
+    REQUIRE(data0 != nullptr);
+    REQUIRE(file.openCachedDataset("Data_0") == data0);
+    REQUIRE(data0->getDimensions() == std::vector<hsize_t>{k_DatasetSize});
+    REQUIRE(data0->getType() == Type::int32);
+
+    auto data1 = file.openCachedDataset("Data_1");
+    REQUIRE(file.openCachedDataset("Data_0") == data0);
+    auto data2 = file.openCachedDataset("Data_2");
+    REQUIRE(file.openCachedDataset("Data_0") == data0);
+    REQUIRE(file.openCachedDataset("Data_1") != data1);
+
+    auto values = file.openCachedDataset("Data_2")->readAsVector<int32_t>();
+    REQUIRE(values == std::vector<int32_t>(k_DatasetSize, 2));
+
+    file.clearDatasetCache();
+    REQUIRE(file.openCachedDataset("Data_0") != data0);
+    REQUIRE(data0->readAsVector<int32_t>() == std::vector<int32_t>(k_DatasetSize, 0));
+  }
+
+  SECTION("Metadata Invalidation")
+  {
+    file.setDatasetCacheCapacity(1);
+    auto datasetWriter = file.createDataset(k_DatasetName);
+    datasetWriter.createOrOpenExtendibleDataset<int32_t>({k_ChunkSize}, {k_ChunkSize});
+    REQUIRE(datasetWriter.getId() > 0);
+    REQUIRE(datasetWriter.getDimensions() == std::vector<hsize_t>{k_ChunkSize});
+
+    auto dataset = file.openCachedDataset(k_DatasetName);
+    REQUIRE(dataset != nullptr);
+    REQUIRE(dataset->getDimensions() == std::vector<hsize_t>{k_ChunkSize});
+    REQUIRE(dataset->getChunkDimensions() == std::vector<hsize_t>{k_ChunkSize});
+    REQUIRE(dataset->setExtent({2 * k_ChunkSize}) >= 0);
+    REQUIRE(dataset->getDimensions() == std::vector<hsize_t>{2 * k_ChunkSize});
+    REQUIRE(dataset->getNumElements() == 2 * k_ChunkSize);
+
+    // The writer's cached dimensions are stale, the read must fail instead
+    // of writing the larger extent past the end of the span
+    std::vector<int32_t> values(k_ChunkSize, -1);
+    nonstd::span<int32_t> valuesSpan(values);
+    REQUIRE(!datasetWriter.readIntoSpan<int32_t>(valuesSpan));
+    REQUIRE(datasetWriter.refresh() >= 0);
+    REQUIRE(datasetWriter.readAsVector<int32_t>().size() == 2 * k_ChunkSize);
+  }
+}
+
+TEST_CASE("File IO Instrumentation", "H5Support")
+{
+  Instrumentation::Reset();
+  Instrumentation::SetEnabled(true);
+  {
+    auto fileResult = FileIO::CreateInMemory();
+    REQUIRE(fileResult.valid());
+    FileIO& file = fileResult.value();
+
+    std::vector<int32_t> values(k_DatasetSize, 7);
+    auto dataset = file.createDataset(k_DatasetName);
+    REQUIRE(dataset.writeSpan<int32_t>({k_DatasetSize}, values) == 0);
+    REQUIRE(dataset.readAsVector<int32_t>() == values);
+    REQUIRE(dataset.readAsVector<double>() == std::vector<double>(k_DatasetSize, 7.0));
+    REQUIRE(dataset.createAttribute("Index").writeValue<int32_t>(3) == 0);
+    REQUIRE(dataset.getAttribute("Index").readAsValue<int32_t>() == 3);
+    REQUIRE(file.isDataset(k_DatasetName));
+  }
+  Instrumentation::SetEnabled(false);
+
+  const Instrumentation::Snapshot snapshot = Instrumentation::TakeSnapshot();
+  if(!Instrumentation::IsCompiledIn())
+  {
+    REQUIRE(snapshot.files.empty());
+    return;
+  }
+
+  using Instrumentation::Operation;
+  REQUIRE(snapshot.files.size() == 1);
+  const Instrumentation::FileCounters& fileCounters = snapshot.files.begin()->second;
+  REQUIRE(fileCounters.totals[Operation::Open].calls == 1);
+  REQUIRE(fileCounters.totals[Operation::Close].calls == 2);
+  REQUIRE(fileCounters.objects.count("/") == 1);
+  REQUIRE(fileCounters.objects.at("/")[Operation::Query].calls == 1);
+
+  const std::string datasetPath = "/" + k_DatasetName;
+  REQUIRE(fileCounters.objects.count(datasetPath) == 1);
+  const Instrumentation::Counters& counters = fileCounters.objects.at(datasetPath);
+  REQUIRE(counters[Operation::Write].calls == 1);
+  REQUIRE(counters[Operation::Write].bytes == k_DatasetSize * sizeof(int32_t));
+  REQUIRE(counters[Operation::Read].calls == 2);
+  REQUIRE(counters[Operation::Read].bytes == k_DatasetSize * (sizeof(int32_t) + sizeof(double)));
+  REQUIRE(counters[Operation::Read].convertingCalls == 1);
+  REQUIRE(counters[Operation::Read].convertingCallNanoseconds <= counters[Operation::Read].nanoseconds);
+  REQUIRE(counters[Operation::WriteAttribute].calls == 1);
+  REQUIRE(counters[Operation::ReadAttribute].bytes == sizeof(int32_t));
+  REQUIRE(counters[Operation::Close].calls == 1);
+  REQUIRE(snapshot.totals()[Operation::Read].bytes == counters[Operation::Read].bytes);
+
+  const std::string json = snapshot.toJson();
+  REQUIRE(json.find("\"" + datasetPath + "\"") != std::string::npos);
+  REQUIRE(json.find("\"convertingCalls\"") != std::string::npos);
+
+  // Nothing is recorded while disabled
+  {
+    auto fileResult = FileIO::CreateInMemory();
+    REQUIRE(fileResult.valid());
+  }
+  REQUIRE(Instrumentation::TakeSnapshot().files.size() == 1);
+  Instrumentation::Reset();
+  REQUIRE(Instrumentation::TakeSnapshot().files.empty());
+}
+
+TEST_CASE("File IO Cache Statistics", "H5Support")
+{
+  REQUIRE(!FileIO().cacheStats().valid());
+
+  const std::filesystem::path filePath = constants::TestDataDir / "test_IO_CacheStats.h5";
+  std::filesystem::remove(filePath);
+  writeDriverFile(filePath, {});
+  {
+    FileIO fileReader(filePath);
+    REQUIRE(fileReader.isValid());
+    auto statsResult = fileReader.cacheStats();
+    REQUIRE(statsResult.valid());
+    const Instrumentation::CacheStats& stats = statsResult.value();
+    REQUIRE(stats.metadataHitRate >= 0.0);
+    REQUIRE(stats.metadataHitRate <= 1.0);
+    REQUIRE(stats.metadataCurrentSize > 0);
+    REQUIRE(stats.metadataCurrentSize <= stats.metadataMaxSize);
+    REQUIRE(!stats.pageBufferEnabled);
+    REQUIRE(fileReader.resetCacheStats() >= 0);
+  }
+
+  const std::filesystem::path pagedFilePath = constants::TestDataDir / "test_IO_CacheStatsPaged.h5";
+  std::filesystem::remove(pagedFilePath);
+  FileOptions pagedOptions;
+  pagedOptions.pagedAggregation = true;
+  pagedOptions.pageSize = 8192;
+  pagedOptions.pageBufferSize = 4 * 8192;
+  writeDriverFile(pagedFilePath, pagedOptions);
+  {
+    FileIO fileReader(pagedFilePath, pagedOptions);
+    REQUIRE(fileReader.isValid());
+    auto datasetReader = fileReader.openDataset(k_DriverDatasetName);
+    REQUIRE(datasetReader.open());
+    REQUIRE(datasetReader.readAsVector<int32_t>().size() == k_DatasetSize);
+    auto statsResult = fileReader.cacheStats();
+    REQUIRE(statsResult.valid());
+    const Instrumentation::CacheStats& stats = statsResult.value();
+    REQUIRE(stats.pageBufferEnabled);
+    REQUIRE(stats.pageAccesses[0] + stats.pageAccesses[1] > 0);
+  }
+
+  // The page buffer is skipped for files created without paged aggregation
+  {
+    FileIO fileReader(filePath, pagedOptions);
+    REQUIRE(fileReader.isValid());
+    auto statsResult = fileReader.cacheStats();
+    REQUIRE(statsResult.valid());
+    REQUIRE(!statsResult.value().pageBufferEnabled);
+  }
+
+  // Chunks of 8 x 8 int32 values, of which the cache holds a single one
+  constexpr hsize_t k_Size = 16;
+  constexpr hsize_t k_ChunkEdge = 8;
+  const std::vector<hsize_t> dims{k_Size, k_Size};
+  const std::vector<int32_t> values(k_Size * k_Size, 5);
+  auto writeAndReadTwice = [&](const FileOptions& options) {
+    auto fileResult = FileIO::Open(constants::TestDataDir / "test_IO_ChunkCache.h5", FileIO::Mode::Truncate, options);
+    REQUIRE(fileResult.valid());
+    auto dataset = fileResult.value().createDataset(k_DatasetName);
+    dataset.createOrOpenChunkedDataset<int32_t>(dims, {k_ChunkEdge, k_ChunkEdge});
+    REQUIRE(dataset.writeSpan<int32_t>(dims, values) == 0);
+    REQUIRE(dataset.readAsVector<int32_t>() == values);
+    REQUIRE(dataset.readAsVector<int32_t>() == values);
+  };
+
+  Instrumentation::Reset();
+  Instrumentation::SetEnabled(true);
+  writeAndReadTwice({});
+  const Instrumentation::EstimatedChunkCacheCounters largeCache = Instrumentation::TakeSnapshot().totals().estimatedChunkCache;
+  Instrumentation::Reset();
+  FileOptions smallCacheOptions;
+  smallCacheOptions.chunkCacheSize = k_ChunkEdge * k_ChunkEdge * sizeof(int32_t);
+  writeAndReadTwice(smallCacheOptions);
+  const Instrumentation::Snapshot snapshot = Instrumentation::TakeSnapshot();
+  Instrumentation::SetEnabled(false);
+  Instrumentation::Reset();
+
+  if(!Instrumentation::IsCompiledIn())
+  {
+    REQUIRE(largeCache.misses == 0);
+    return;
+  }
+  // The four chunks miss when first written and hit on both reads
+  REQUIRE(largeCache.misses == 4);
+  REQUIRE(largeCache.hits == 8);
+  REQUIRE(largeCache.evictions == 0);
+  // Every chunk evicts the previous one
+  const Instrumentation::EstimatedChunkCacheCounters smallCache = snapshot.totals().estimatedChunkCache;
+  REQUIRE(smallCache.hits == 0);
+  REQUIRE(smallCache.misses == 12);
+  REQUIRE(smallCache.evictions == 11);
+  REQUIRE(snapshot.toJson().find("\"estimatedChunkCache\"") != std::string::npos);
+}
+
+TEST_CASE("File IO Tracing", "H5Support")
+{
+  auto traceOperations = []() {
+    auto fileResult = FileIO::CreateInMemory();
+    REQUIRE(fileResult.valid());
+    std::vector<int32_t> values(k_DatasetSize, 3);
+    auto dataset = fileResult.value().createDataset(k_DatasetName);
+    REQUIRE(dataset.writeSpan<int32_t>({k_DatasetSize}, values) == 0);
+    REQUIRE(dataset.readAsVector<int32_t>() == values);
+  };
+
+  Tracing::Start();
+  REQUIRE(Tracing::IsActive());
+  traceOperations();
+  Tracing::Stop();
+  REQUIRE_FALSE(Tracing::IsActive());
+
+  std::string trace = Tracing::ToJson();
+  REQUIRE(trace.find("\"traceEvents\"") != std::string::npos);
+  if(!Instrumentation::IsCompiledIn())
+  {
+    REQUIRE(trace.find("\"ph\":\"X\"") == std::string::npos);
+    return;
+  }
+
+  auto countSpans = [](const std::string& json, const std::string& name) {
+    size_t count = 0;
+    for(size_t position = json.find(name); position != std::string::npos; position = json.find(name, position + 1))
+    {
+      count++;
+    }
+    return count;
+  };
+  REQUIRE(countSpans(trace, "\"name\":\"read\"") == 1);
+  REQUIRE(countSpans(trace, "\"name\":\"write\"") == 1);
+  REQUIRE(countSpans(trace, "\"name\":\"open\"") == 1);
+  REQUIRE(trace.find("\"path\":\"/" + k_DatasetName + "\"") != std::string::npos);
+  REQUIRE(trace.find(fmt::format("\"bytes\":{}", k_DatasetSize * sizeof(int32_t))) != std::string::npos);
+
+  // Nothing is recorded while stopped
+  traceOperations();
+  REQUIRE(Tracing::ToJson() == trace);
+
+  // Spans from other threads are collected, and starting again discards earlier spans
+  Tracing::Start();
+  std::thread worker(traceOperations);
+  worker.join();
+  Tracing::Stop();
+  trace = Tracing::ToJson();
+  REQUIRE(countSpans(trace, "\"name\":\"read\"") == 1);
+
+  const std::filesystem::path tracePath = constants::TestDataDir / "test_IO_trace.json";
+  REQUIRE(Tracing::Write(tracePath).valid());
+  REQUIRE(std::filesystem::file_size(tracePath) == trace.size());
+  std::filesystem::remove(tracePath);
+
+  // The exited worker's buffer is released by the next start
+  Tracing::Start();
+  Tracing::Stop();
+  REQUIRE(countSpans(Tracing::ToJson(), "\"ph\":\"X\"") == 0);
+}
@@ -0,0 +1,238 @@
+#include <catch2/catch.hpp>
+
+#include "NX/H5Support/IO/DatasetIO.hpp"
+#include "NX/H5Support/IO/FileIO.hpp"
+#include "NX/H5Support/TestGenConstants.hpp"
+#include "NX/H5Support/Utilities/Repacker.hpp"
+
+#include "nonstd/span.hpp"
+#include <vector>
+
+using namespace NX::H5Support;
+
+namespace
+{
+inline const std::string k_SourceFileName = "test_Repacker_Source.h5";
+inline const std::string k_TargetFileName = "test_Repacker_Target.h5";
+inline const std::string k_CompressedName = "Group/Compressed";
+inline const std::string k_ContiguousName = "Group/Contiguous";
+
+constexpr hsize_t k_NumRows = 100;
+constexpr hsize_t k_NumColumns = 64;
+constexpr hsize_t k_ChunkRows = 10;
+constexpr size_t k_NumValues = 1000;
+
+void writeSourceFile(const std::filesystem::path& filePath)
+{
+  auto fileResult = FileIO::Open(filePath, FileIO::Mode::Truncate);
+  REQUIRE(fileResult.valid());
+  FileIO& file = fileResult.value();
+  REQUIRE(file.createAttribute("Title").writeString("Repack") == 0);
+  auto group = file.createGroup("Group");
+  REQUIRE(group.createAttribute("Version").writeValue<int32_t>(3) == 0);
+
+  std::vector<float> floats(k_NumRows * k_NumColumns);
+  for(size_t i = 0; i < floats.size(); i++)
+  {
+    floats[i] = static_cast<float>(i % 97) * 0.5f;
+  }
+  const DatasetIO::DimsType chunkDims{k_ChunkRows, k_NumColumns};
+  hid_t propertiesId = H5Pcreate(H5P_DATASET_CREATE);
+  H5Pset_chunk(propertiesId, 2, chunkDims.data());
+  H5Pset_deflate(propertiesId, 1);
+  auto compressed = group.createDataset("Compressed");
+  compressed.createOrOpenDataset<float>({k_NumRows, k_NumColumns}, propertiesId);
+  H5Pclose(propertiesId);
+  REQUIRE(compressed.writeSpan<float>({k_NumRows, k_NumColumns}, floats) == 0);
+  REQUIRE(compressed.createAttribute("Units").writeString("mm") == 0);
+
+  std::vector<int32_t> values(k_NumValues);
+  for(size_t i = 0; i < k_NumValues; i++)
+  {
+    values[i] = static_cast<int32_t>(i);
+  }
+  auto contiguous = group.createDataset("Contiguous");
+  REQUIRE(contiguous.writeSpan<int32_t>({k_NumValues}, values) == 0);
+
+  REQUIRE(H5Lcreate_hard(file.getId(), k_CompressedName.c_str(), file.getId(), "Group/Hard", H5P_DEFAULT, H5P_DEFAULT) >= 0);
+  REQUIRE(H5Lcreate_soft("/Group/Contiguous", file.getId(), "Group/Soft", H5P_DEFAULT, H5P_DEFAULT) >= 0);
+}
+
+void checkTargetFile(const std::filesystem::path& filePath)
+{
+  auto fileResult = FileIO::Open(filePath, FileIO::Mode::ReadOnly);
+  REQUIRE(fileResult.valid());
+  FileIO& file = fileResult.value();
+  REQUIRE(file.getAttribute("Title").readAsString() == "Repack");
+  auto group = file.openGroup("Group");
+  REQUIRE(group.getAttribute("Version").readAsValue<int32_t>() == 3);
+
+  auto compressed = group.openDataset("Compressed");
+  REQUIRE(compressed.open());
+  REQUIRE(compressed.getAttribute("Units").readAsString() == "mm");
+  auto floats = compressed.readAsVector<float>();
+  REQUIRE(floats.size() == k_NumRows * k_NumColumns);
+  for(size_t i = 0; i < floats.size(); i++)
+  {
+    REQUIRE(floats[i] == static_cast<float>(i % 97) * 0.5f);
+  }
+
+  auto contiguous = group.openDataset("Contiguous");
+  REQUIRE(contiguous.open());
+  auto values = contiguous.readAsVector<int32_t>();
+  REQUIRE(values.size() == k_NumValues);
+  for(size_t i = 0; i < k_NumValues; i++)
+  {
+    REQUIRE(values[i] == static_cast<int32_t>(i));
+  }
+
+  H5O_info_t compressedInfo;
+  H5O_info_t hardInfo;
+  REQUIRE(H5Oget_info_by_name2(file.getId(), k_CompressedName.c_str(), &compressedInfo, H5O_INFO_BASIC, H5P_DEFAULT) >= 0);
+  REQUIRE(H5Oget_info_by_name2(file.getId(), "Group/Hard", &hardInfo, H5O_INFO_BASIC, H5P_DEFAULT) >= 0);
+  REQUIRE(compressedInfo.addr == hardInfo.addr);
+
+  H5L_info_t linkInfo;
+  REQUIRE(H5Lget_info(file.getId(), "Group/Soft", &linkInfo, H5P_DEFAULT) >= 0);
+  REQUIRE(linkInfo.type == H5L_TYPE_SOFT);
+}
+
+int32_t countFilters(const std::filesystem::path& filePath, const std::string& datasetPath, std::vector<hsize_t>& chunkDims)
+{
+  auto fileResult = FileIO::Open(filePath, FileIO::Mode::ReadOnly);
+  REQUIRE(fileResult.valid());
+  hid_t datasetId = H5Dopen2(fileResult.value().getId(), datasetPath.c_str(), H5P_DEFAULT);
+  REQUIRE(datasetId >= 0);
+  hid_t propertiesId = H5Dget_create_plist(datasetId);
+  const int32_t numFilters = H5Pget_nfilters(propertiesId);
+  chunkDims.assign(2, 0);
+  if(H5Pget_layout(propertiesId) == H5D_CHUNKED)
+  {
+    chunkDims.resize(H5Pget_chunk(propertiesId, 2, chunkDims.data()));
+  }
+  else
+  {
+    chunkDims.clear();
+  }
+  H5Pclose(propertiesId);
+  H5Dclose(datasetId);
+  return numFilters;
+}
+} // namespace
+
+TEST_CASE("Repacker", "H5Support")
+{
+  const std::filesystem::path sourcePath = constants::TestDataDir / k_SourceFileName;
+  const std::filesystem::path targetPath = constants::TestDataDir / k_TargetFileName;
+  writeSourceFile(sourcePath);
+
+  std::vector<hsize_t> chunkDims;
+  Repacker::Options options;
+  options.numThreads = 2;
+  options.batchBytes = 8 * 1024;
+
+  SECTION("Copy")
+  {
+    auto result = Repacker(options).repack(sourcePath, targetPath);
+    REQUIRE(result.valid());
+    REQUIRE(result.value().numGroups == 1);
+    REQUIRE(result.value().numDatasets == 2);
+    REQUIRE(result.value().numRepacked == 0);
+    checkTargetFile(targetPath);
+    REQUIRE(countFilters(targetPath, k_CompressedName, chunkDims) == 1);
+  }
+
+  SECTION("Recompress")
+  {
+    options.defaultSettings.compression = Repacker::Compression::Deflate;
+    options.defaultSettings.deflateLevel = 9;
+    options.targetChunkBytes = 1024;
+    size_t numReports = 0;
+    options.progress = [&numReports](const Repacker::Progress& progress) {
+      REQUIRE(progress.numDatasets == 2);
+      REQUIRE(progress.bytesProcessed <= progress.bytesTotal);
+      numReports++;
+      return true;
+    };
+    auto result = Repacker(options).repack(sourcePath, targetPath);
+    REQUIRE(result.valid());
+    REQUIRE(result.value().numRepacked == 2);
+    REQUIRE(numReports > 2);
+    checkTargetFile(targetPath);
+
+    REQUIRE(countFilters(targetPath, k_CompressedName, chunkDims) == 2);
+    REQUIRE(chunkDims == std::vector<hsize_t>{k_ChunkRows, k_NumColumns});
+    REQUIRE(countFilters(targetPath, k_ContiguousName, chunkDims) == 2);
+    REQUIRE(chunkDims == std::vector<hsize_t>{256});
+  }
+
+  SECTION("Rechunk and Decompress")
+  {
+    Repacker::DatasetSettings rechunk;
+    rechunk.layout = Repacker::Layout::Chunked;
+    rechunk.chunkDims = {25, 32};
+    options.datasetSettings[k_CompressedName] = rechunk;
+    Repacker::DatasetSettings decompress;
+    decompress.compression = Repacker::Compression::None;
+    options.defaultSettings = decompress;
+    auto result = Repacker(options).repack(sourcePath, targetPath);
+    REQUIRE(result.valid());
+    REQUIRE(result.value().numRepacked == 2);
+    checkTargetFile(targetPath);
+
+    REQUIRE(countFilters(targetPath, k_CompressedName, chunkDims) == 1);
+    REQUIRE(chunkDims == std::vector<hsize_t>{25, 32});
+    REQUIRE(countFilters(targetPath, k_ContiguousName, chunkDims) == 0);
+    REQUIRE(chunkDims.empty());
+
+    options.datasetSettings.clear();
+    REQUIRE(Repacker(options).repack(sourcePath, targetPath).valid());
+    REQUIRE(countFilters(targetPath, k_CompressedName, chunkDims) == 0);
+    REQUIRE(chunkDims == std::vector<hsize_t>{k_ChunkRows, k_NumColumns});
+    checkTargetFile(targetPath);
+  }
+
+  SECTION("Contiguous")
+  {
+    options.defaultSettings.layout = Repacker::Layout::Contiguous;
+    auto result = Repacker(options).repack(sourcePath, targetPath);
+    REQUIRE(result.valid());
+    checkTargetFile(targetPath);
+    REQUIRE(countFilters(targetPath, k_CompressedName, chunkDims) == 0);
+    REQUIRE(chunkDims.empty());
+  }
+
+  SECTION("Chunk Rank Mismatch")
+  {
+    options.defaultSettings.layout = Repacker::Layout::Chunked;
+    options.defaultSettings.chunkDims = {50};
+    auto result = Repacker(options).repack(sourcePath, targetPath);
+    REQUIRE(result.valid());
+    REQUIRE(result.value().numRepacked == 2);
+    checkTargetFile(targetPath);
+
+    REQUIRE(countFilters(targetPath, k_CompressedName, chunkDims) == 1);
+    REQUIRE(chunkDims == std::vector<hsize_t>{k_ChunkRows, k_NumColumns});
+    REQUIRE(countFilters(targetPath, k_ContiguousName, chunkDims) == 0);
+    REQUIRE(chunkDims == std::vector<hsize_t>{50});
+  }
+
+  SECTION("Errors")
+  {
+    options.defaultSettings.layout = Repacker::Layout::Chunked;
+    options.progress = [](const Repacker::Progress&) { return false; };
+    REQUIRE_FALSE(Repacker(options).repack(sourcePath, targetPath).valid());
+
+    options.progress = nullptr;
+    REQUIRE_FALSE(Repacker(options).repack(constants::TestDataDir / "Missing.h5", targetPath).valid());
+  }
+}
+
+TEST_CASE("Repacker Chunk Dims", "H5Support")
+{
+  REQUIRE(Repacker::ChooseChunkDims({100, 64}, 4, 4096) == std::vector<hsize_t>{16, 64});
+  REQUIRE(Repacker::ChooseChunkDims({10, 10}, 8, 1024 * 1024) == std::vector<hsize_t>{10, 10});
+  REQUIRE(Repacker::ChooseChunkDims({1000}, 4, 400) == std::vector<hsize_t>{100});
+  REQUIRE(Repacker::ChooseChunkDims({4, 1000000}, 1, 1000) == std::vector<hsize_t>{1, 1000});
+  REQUIRE(Repacker::ChooseChunkDims({0, 3}, 2, 1) == std::vector<hsize_t>{1, 1});
+}
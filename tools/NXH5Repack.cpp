@@ -0,0 +1,165 @@
+#include "NX/H5Support/Utilities/Repacker.hpp"
+
+#include <fmt/format.h>
+
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+
+using namespace NX::H5Support;
+
+namespace
+{
+void printUsage()
+{
+  std::cout << "Usage: NXH5Repack [options] <source.h5> <target.h5>\n"
+               "Copies an HDF5 file into a compacted file, optionally rechunking and recompressing its datasets.\n"
+               "  --chunk=AxBxC        Chunk shape applied to every dataset of matching rank\n"
+               "  --chunk-bytes=N      Target chunk size when rechunking without --chunk (default 1048576)\n"
+               "  --contiguous         Stores datasets contiguously without compression\n"
+               "  --deflate=N          Compresses datasets with deflate level N (1-9)\n"
+               "  --no-shuffle         Disables the shuffle filter used with --deflate\n"
+               "  --no-compression     Removes the filters of every dataset\n"
+               "  --threads=N          Number of compression threads (default all cores)\n"
+               "  --quiet              Only prints the summary\n";
+}
+
+bool parseSize(const std::string& text, size_t& value)
+{
+  try
+  {
+    size_t numParsed = 0;
+    value = std::stoull(text, &numParsed);
+    return numParsed == text.size();
+  } catch(const std::exception&)
+  {
+    return false;
+  }
+}
+
+bool parseChunk(const std::string& text, std::vector<hsize_t>& chunkDims)
+{
+  size_t start = 0;
+  while(start <= text.size())
+  {
+    const size_t end = std::min(text.find('x', start), text.size());
+    size_t dim = 0;
+    if(!parseSize(text.substr(start, end - start), dim) || dim == 0)
+    {
+      return false;
+    }
+    chunkDims.push_back(dim);
+    start = end + 1;
+  }
+  return !chunkDims.empty();
+}
+} // namespace
+
+int main(int argc, char* argv[])
+{
+  Repacker::Options options;
+  Repacker::DatasetSettings& settings = options.defaultSettings;
+  std::vector<std::string> paths;
+  bool quiet = false;
+  for(int i = 1; i < argc; i++)
+  {
+    const std::string argument = argv[i];
+    const size_t separator = argument.find('=');
+    const std::string name = argument.substr(0, separator);
+    const std::string value = separator == std::string::npos ? "" : argument.substr(separator + 1);
+    size_t number = 0;
+    bool valid = true;
+    if(name == "--chunk")
+    {
+      settings.layout = Repacker::Layout::Chunked;
+      valid = parseChunk(value, settings.chunkDims);
+    }
+    else if(name == "--chunk-bytes")
+    {
+      settings.layout = Repacker::Layout::Chunked;
+      valid = parseSize(value, options.targetChunkBytes) && options.targetChunkBytes > 0;
+    }
+    else if(name == "--contiguous")
+    {
+      settings.layout = Repacker::Layout::Contiguous;
+      settings.compression = Repacker::Compression::None;
+    }
+    else if(name == "--deflate")
+    {
+      settings.compression = Repacker::Compression::Deflate;
+      valid = parseSize(value, number) && number >= 1 && number <= 9;
+      settings.deflateLevel = static_cast<uint32_t>(number);
+    }
+    else if(name == "--no-shuffle")
+    {
+      settings.shuffle = false;
+    }
+    else if(name == "--no-compression")
+    {
+      settings.compression = Repacker::Compression::None;
+    }
+    else if(name == "--threads")
+    {
+      valid = parseSize(value, options.numThreads);
+    }
+    else if(name == "--quiet")
+    {
+      quiet = true;
+    }
+    else if(name == "--help" || name == "-h")
+    {
+      printUsage();
+      return 0;
+    }
+    else if(argument.rfind("--", 0) == 0)
+    {
+      valid = false;
+    }
+    else
+    {
+      paths.push_back(argument);
+    }
+
+    if(!valid)
+    {
+      std::cout << fmt::format("Invalid argument '{}'", argument) << std::endl;
+      printUsage();
+      return 1;
+    }
+  }
+
+  if(paths.size() != 2)
+  {
+    printUsage();
+    return 1;
+  }
+
+  if(!quiet)
+  {
+    // Reports each dataset once, when its last batch completes
+    options.progress = [lastIndex = std::numeric_limits<size_t>::max()](const Repacker::Progress& progress) mutable {
+      if(progress.bytesProcessed == progress.bytesTotal && progress.datasetIndex != lastIndex)
+      {
+        lastIndex = progress.datasetIndex;
+        std::cout << fmt::format("[{}/{}] {}", progress.datasetIndex + 1, progress.numDatasets, progress.path) << std::endl;
+      }
+      return true;
+    };
+  }
+
+  auto result = Repacker(options).repack(paths[0], paths[1]);
+  if(!result.valid())
+  {
+    for(const auto& error : result.errors())
+    {
+      std::cout << error.message << std::endl;
+    }
+    return 1;
+  }
+
+  const Repacker::Summary& summary = result.value();
+  std::cout << fmt::format("{} groups, {} datasets ({} repacked)", summary.numGroups, summary.numDatasets, summary.numRepacked) << std::endl;
+  std::cout << fmt::format("{} bytes -> {} bytes", summary.sourceFileSize, summary.targetFileSize) << std::endl;
+  return 0;
+}